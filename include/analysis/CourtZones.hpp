@@ -0,0 +1,97 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bbst::analysis {
+
+// Shot zones; sides are as seen by a shooter facing the basket
+enum class CourtZone : uint8_t {
+    Unknown = 0,                // Not classified (no court calibration)
+    OutOfBounds,
+    RestrictedArea,
+    Paint,
+    MidRange,
+    LeftCornerThree,
+    RightCornerThree,
+    AboveBreakThree,
+    Count
+};
+
+const char* courtZoneName(CourtZone zone);
+
+// FIBA court template in meters: x along the sideline (0..28), y along the
+// baseline (0..15), z up. Points are classified relative to the nearer basket.
+struct CourtTemplate {
+    double length = 28.0;
+    double width = 15.0;
+    double basket_offset = 1.575;   // Basket center from the baseline
+    double restricted_radius = 1.25;
+    double lane_width = 4.9;
+    double lane_length = 5.8;
+    double three_radius = 6.75;
+    double corner_three = 6.6;      // Distance of the corner three line from the basket axis
+    
+    // Exact geometric classification (a handful of comparisons and a sqrt)
+    CourtZone classify(const cv::Point2f& court_m) const;
+};
+
+// Zone IDs rasterized once, so a lookup is one affine transform and one
+// byte read, and batches of points classify in a tight loop.
+//
+// A court map is indexed by court coordinates (meters). An image map is
+// indexed by pixel coordinates of a fixed camera: the court raster is warped
+// through the camera's image-to-court homography at build time, so lookups
+// never touch the homography.
+class CourtZoneMap {
+private:
+    cv::Mat zones_;                 // CV_8U CourtZone per cell
+    cv::Matx23f to_cell_;           // Input coordinates to cell centers
+    cv::Matx33d to_court_;          // Input coordinates to court meters
+    
+    CourtZoneMap(cv::Mat zones, const cv::Matx23f& to_cell, const cv::Matx33d& to_court);
+
+public:
+    // Court-space map, cell_m meters per cell
+    static CourtZoneMap court(const CourtTemplate& court = CourtTemplate(), double cell_m = 0.05);
+    
+    // Image-space map for a camera whose floor plane maps to the court by H
+    static CourtZoneMap image(const cv::Matx33d& image_to_court, cv::Size image_size,
+                              const CourtTemplate& court = CourtTemplate(), double cell_m = 0.05);
+    
+    CourtZone at(const cv::Point2f& point) const {
+        const cv::Matx23f& m = to_cell_;
+        int col = cvRound(m(0, 0) * point.x + m(0, 1) * point.y + m(0, 2));
+        int row = cvRound(m(1, 0) * point.x + m(1, 1) * point.y + m(1, 2));
+        if (static_cast<unsigned>(col) >= static_cast<unsigned>(zones_.cols) ||
+            static_cast<unsigned>(row) >= static_cast<unsigned>(zones_.rows)) {
+            return CourtZone::OutOfBounds;
+        }
+        return static_cast<CourtZone>(zones_.ptr<uint8_t>(row)[col]);
+    }
+    
+    void classify(const std::vector<cv::Point2f>& points, std::vector<CourtZone>& zones) const;
+    
+    // Court position (meters) of an input point
+    cv::Point2f toCourt(const cv::Point2f& point) const;
+    
+    const cv::Mat& raster() const { return zones_; }
+};
+
+// Shot attempts per zone
+struct ShotChart {
+    std::array<int, static_cast<size_t>(CourtZone::Count)> attempts{};
+    std::vector<cv::Point2f> court_points;  // Meters
+    
+    void add(CourtZone zone, const cv::Point2f& court_point);
+    
+    // "Paint 4, MidRange 2, AboveBreakThree 3"
+    std::string summary() const;
+    
+    // Top view of the court shaded by zone, one dot per attempt
+    cv::Mat render(const CourtTemplate& court = CourtTemplate(), int pixels_per_meter = 30) const;
+};
+
+} // namespace bbst::analysis
@@ -0,0 +1,60 @@
+#pragma once
+#include "core/IDetector.hpp"
+#include "detectors/ClassMask.hpp"
+#include "util/LatencyStats.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bbst::analysis {
+
+struct ComparisonConfig {
+    ClassMask reference_classes{0, 2};  // Ball classes of the reference (YOLO) model
+    ClassMask candidate_classes{0};     // Ball classes of the candidate model
+    float match_distance = 10.0f;       // Max centre distance (px) for the two to agree
+};
+
+// Side-by-side of two ball detectors run on the same frames. Per frame each
+// side's ball is its most confident detection of a ball class; the frame
+// counts as agreement when both found one within match_distance.
+class DetectorComparison {
+private:
+    ComparisonConfig config_;
+    util::LatencyStats reference_latency_;
+    util::LatencyStats candidate_latency_;
+    int frames_ = 0;
+    int agreed_ = 0;
+    int disagreed_ = 0;                 // Both found a ball, too far apart
+    int reference_only_ = 0;
+    int candidate_only_ = 0;
+    double error_sum_ = 0.0;            // Centre distance over agreed frames
+
+public:
+    explicit DetectorComparison(const ComparisonConfig& config = ComparisonConfig())
+        : config_(config) {}
+    
+    // Most confident detection of a class in the mask, nullptr when none
+    static const Detection<>* bestBall(const std::vector<Detection<>>& detections,
+                                       const ClassMask& classes);
+    
+    // One frame's detections from each side and their wall time
+    void add(const std::vector<Detection<>>& reference, int64_t reference_us,
+             const std::vector<Detection<>>& candidate, int64_t candidate_us);
+    
+    int frames() const { return frames_; }
+    int agreed() const { return agreed_; }
+    int disagreed() const { return disagreed_; }
+    int referenceOnly() const { return reference_only_; }
+    int candidateOnly() const { return candidate_only_; }
+    
+    // Mean centre distance over agreed frames (px)
+    double meanError() const { return agreed_ > 0 ? error_sum_ / agreed_ : 0.0; }
+    
+    const util::LatencyStats& referenceLatency() const { return reference_latency_; }
+    const util::LatencyStats& candidateLatency() const { return candidate_latency_; }
+    
+    // Multi-line report: agreement counts, centre error, both latency summaries
+    std::string summary() const;
+};
+
+} // namespace bbst::analysis
@@ -0,0 +1,52 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+namespace bbst::analysis {
+
+enum class ShotOutcome : uint8_t {
+    None = 0,       // No visit to the rim ended this frame
+    Make,
+    Miss
+};
+
+const char* shotOutcomeName(ShotOutcome outcome);
+
+struct MakeMissConfig {
+    float zone_scale = 3.0f;        // Rim box expansion for the judging zone
+    int min_observations = 3;       // Ball sightings in the zone needed to judge a visit
+    int max_missing = 4;            // Frames the ball may vanish (net, occlusion) mid-visit
+};
+
+// Judges each visit of the ball to the rim zone. A visit starts when the ball
+// is seen inside the zone and ends when it is seen outside it or stays lost;
+// it is a make if the ball came from above the rim and crossed the rim plane
+// downward between the rim's edges, a miss otherwise.
+class MakeMissJudge {
+private:
+    MakeMissConfig config_;
+    bool in_visit_;
+    bool came_from_above_;
+    bool dropped_through_;
+    int observations_;
+    int missing_;
+    cv::Point2f last_ball_;
+    bool have_last_;
+    
+    ShotOutcome endVisit();
+
+public:
+    explicit MakeMissJudge(const MakeMissConfig& config = MakeMissConfig());
+    
+    // Rim box grown by scale about its center
+    static cv::Rect2f zone(const cv::Rect& rim, float scale);
+    
+    // One frame: the rim box and the ball center, or nullptr when the ball was
+    // not detected. Returns the outcome of a visit that ended on this frame.
+    ShotOutcome update(const cv::Rect& rim, const cv::Point2f* ball);
+    
+    bool inVisit() const { return in_visit_; }
+    const MakeMissConfig& config() const { return config_; }
+};
+
+} // namespace bbst::analysis
@@ -0,0 +1,52 @@
+#pragma once
+#include "io/FrameSource.hpp"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+namespace bbst::analysis {
+
+// Thresholds for turning codec motion vectors into cues
+struct MotionCuesConfig {
+    float min_residual = 1.0f;          // Motion left after camera compensation (px/frame)
+    int cell_size = 16;                 // Proposal raster resolution (one macroblock)
+    int min_region_cells = 1;
+    float max_region_fraction = 0.25f;  // Bigger blobs are crowd or camera shake, not the ball
+    float static_fraction = 0.002f;     // Moving area below this marks a static frame
+};
+
+// What the motion vectors of one frame say about the scene
+struct MotionSummary {
+    bool valid = false;                 // Vectors were available (not an intra frame)
+    cv::Point2f camera_motion;          // Global translation (pan/tilt) in px/frame
+    float moving_fraction = 0.0f;       // Share of the frame with residual motion
+    bool static_scene = false;          // Nothing but the camera moved
+    std::vector<cv::Rect> regions;      // Moving blobs, in frame pixels
+};
+
+// Motion gating, camera-motion estimation and ROI proposals from the motion
+// vectors the decoder already computed - no optical flow, no frame differencing
+class MotionCues {
+private:
+    MotionCuesConfig config_;
+    
+    // Scratch buffers reused across frames
+    std::vector<float> dx_;
+    std::vector<float> dy_;
+    cv::Mat grid_;
+    cv::Mat labels_;
+    cv::Mat stats_;
+    cv::Mat centroids_;
+
+public:
+    explicit MotionCues(const MotionCuesConfig& config = MotionCuesConfig());
+    
+    MotionSummary analyze(const io::MotionField& field);
+    
+    // Component-wise median of all vectors; robust while the ball and players
+    // cover less than half of the frame
+    cv::Point2f estimateCameraMotion(const io::MotionField& field);
+    
+    const MotionCuesConfig& getConfig() const { return config_; }
+};
+
+} // namespace bbst::analysis
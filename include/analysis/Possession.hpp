@@ -0,0 +1,101 @@
+#pragma once
+#include "tracking/PlayerTracker.hpp"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace bbst::analysis {
+
+// Uniform grid over one frame's player boxes, bucketed by box center.
+// Rebuilt every frame with a counting sort into buffers that are reused, so
+// a nearest-player query touches only the cells around the ball.
+class PlayerGrid {
+private:
+    int cell_;
+    int cols_;
+    int rows_;
+    float max_half_extent_;             // Largest half box size this frame
+    std::vector<int> cell_start_;       // Prefix sums, cols * rows + 1
+    std::vector<int> items_;            // Player indices sorted by cell
+    std::vector<int> cell_of_;
+    const std::vector<tracking::PlayerTrack>* players_;
+    
+    int cellCol(float x) const;
+    int cellRow(float y) const;
+
+public:
+    explicit PlayerGrid(int cell_size = 128);
+    
+    // players must outlive the queries
+    void build(const std::vector<tracking::PlayerTrack>& players, cv::Size frame_size);
+    
+    // Index of the player whose box is nearest to point, within radius; -1 if none
+    int nearest(const cv::Point2f& point, float radius, float* distance = nullptr) const;
+    
+    // Distance from a point to a box (0 inside)
+    static float boxDistance(const cv::Rect2f& box, const cv::Point2f& point);
+};
+
+enum class PossessionEventType : uint8_t {
+    Gained,                             // player took the ball
+    Released,                           // player let go of it
+    Pass                                // from -> player, ball in flight between
+};
+
+const char* possessionEventName(PossessionEventType type);
+
+struct PossessionEvent {
+    PossessionEventType type = PossessionEventType::Gained;
+    int64_t frame = 0;
+    int player = -1;                    // Player track id
+    int from = -1;                      // Passer, for Pass
+};
+
+struct PossessionConfig {
+    float radius = 30.0f;               // Ball-to-box distance to count as in hand (px)
+    float release_radius = 60.0f;       // Distance at which the holder loses it (hysteresis)
+    int acquire_frames = 3;             // Consecutive frames nearest before possession changes
+    int release_frames = 3;
+    int min_flight_frames = 2;          // Loose frames between holders for a pass
+    int max_flight_frames = 45;
+    float min_pass_distance = 80.0f;    // Ball travel from release to catch (px)
+    int grid_cell = 128;
+};
+
+// Possession state machine for one stream. State is a fixed handful of
+// fields (holder, candidate, last release), so memory does not grow with
+// the length of the game.
+class PossessionTracker {
+private:
+    PossessionConfig config_;
+    PlayerGrid grid_;
+    
+    int holder_;                        // Player id, -1 while the ball is loose
+    int candidate_;
+    int candidate_frames_;
+    int64_t candidate_since_;
+    int away_frames_;                   // Consecutive frames the ball was out of reach
+    int64_t away_since_;
+    cv::Point2f away_point_;
+    
+    int last_holder_;
+    int64_t release_frame_;
+    cv::Point2f release_point_;
+
+public:
+    explicit PossessionTracker(const PossessionConfig& config = PossessionConfig());
+    
+    // One frame; ball is nullptr when it was not seen. Events of this frame
+    // are appended to events.
+    void update(int64_t frame, const cv::Point2f* ball,
+                const std::vector<tracking::PlayerTrack>& players, cv::Size frame_size,
+                std::vector<PossessionEvent>& events);
+    
+    int holder() const { return holder_; }
+    
+    // Who let go of the ball last, and when: the shooter once a shot is seen
+    int lastHolder() const { return last_holder_; }
+    int64_t releaseFrame() const { return release_frame_; }
+};
+
+} // namespace bbst::analysis
@@ -0,0 +1,60 @@
+#pragma once
+#include "analysis/CourtZones.hpp"
+#include "analysis/Possession.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include <vector>
+
+namespace bbst::analysis {
+
+// Thresholds for finding shot arcs in a ball track (image pixels, frames)
+struct ShotEventConfig {
+    float min_rise = 80.0f;     // Climb from launch to apex
+    float min_drop = 40.0f;     // Fall after the apex
+    int window_frames = 45;     // Launch and landing are searched this far from the apex
+    int apex_radius = 5;        // Apex is the highest tracked point within this many frames
+    int max_gap = 5;            // Untracked frames that still count as the same flight
+    int min_separation = 30;    // Apexes closer than this are the same shot
+};
+
+// One shot arc, by frame index
+struct ShotEvent {
+    int launch_frame = 0;       // Lowest point before the apex
+    int apex_frame = 0;
+    int land_frame = 0;         // Lowest point after the apex
+    float rise = 0.0f;          // Launch to apex, in pixels
+    cv::Point2f launch_point;   // Ball position at launch (image pixels)
+    cv::Point2f floor_point;    // Where the zone is read: the shooter's feet, else launch_point
+    CourtZone zone = CourtZone::Unknown;
+    int shooter = -1;           // Player track id, -1 when unknown
+};
+
+// Shot candidates in a per-frame track: the ball climbs at least min_rise to
+// a local apex and falls at least min_drop afterwards, without losing the
+// track on the way. Works on live results and on track files read back from
+// disk alike. Events are ordered by apex frame.
+std::vector<ShotEvent> findShotEvents(const std::vector<pipeline::FrameResult>& track,
+                                      const ShotEventConfig& config = ShotEventConfig());
+
+// Zone of each shot's floor point in an image-space zone map. The map is of
+// the floor plane, so the point must be on the floor: the shooter's feet
+// once locateShooters found them. The ball's launch point is the fallback
+// and reads too far from the camera, by the release height.
+void classifyShots(std::vector<ShotEvent>& events, const CourtZoneMap& image_map);
+
+// Gained and Released events from the per-frame holder of a track, for
+// tracks read back from disk where only the holder was stored
+std::vector<PossessionEvent> possessionFromTrack(const std::vector<pipeline::FrameResult>& track);
+
+// Shooter of each shot: the last player to release the ball no later than
+// tolerance_frames after the launch (the arc is found a little late).
+// possession must be in frame order.
+void attributeShooters(std::vector<ShotEvent>& events, const std::vector<PossessionEvent>& possession,
+                       int tolerance_frames = 10);
+
+// Floor point of each attributed shot: the bottom-centre of the shooter's
+// box on the last frame, no later than tolerance_frames after the launch,
+// where the shooter is tracked. Other shots keep the launch point.
+void locateShooters(std::vector<ShotEvent>& events, const std::vector<pipeline::FrameResult>& track,
+                    int tolerance_frames = 10);
+
+} // namespace bbst::analysis
@@ -0,0 +1,74 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace bbst {
+
+// Per-frame cache of derived images shared by every consumer in the pipeline.
+// Each product is computed lazily on first request and memoized behind a
+// std::once_flag, so concurrent consumers trigger at most one computation.
+//
+// The context shares pixel data with the source frame: request the products
+// you need before drawing overlays into that frame.
+class FrameContext {
+private:
+    cv::Mat frame_;
+    int64_t index_;
+    double timestamp_ms_;
+    int pyramid_levels_;
+
+    // Lazily computed products (Topic 19: mutable state behind const API)
+    mutable std::once_flag gray_once_;
+    mutable std::once_flag half_once_;
+    mutable std::once_flag quarter_once_;
+    mutable std::once_flag pyramid_once_;
+    mutable std::once_flag dhash_once_;
+
+    mutable cv::Mat gray_;
+    mutable cv::Mat half_;
+    mutable cv::Mat quarter_;
+    mutable std::vector<cv::Mat> pyramid_;
+    mutable uint64_t dhash_;
+
+public:
+    explicit FrameContext(const cv::Mat& frame,
+                          int64_t index = 0,
+                          double timestamp_ms = 0.0,
+                          int pyramid_levels = 4);
+    
+    // Sources that already hold a luma plane (raw YUV) seed gray() for free
+    FrameContext(const cv::Mat& frame,
+                 const cv::Mat& luma,
+                 int64_t index = 0,
+                 double timestamp_ms = 0.0,
+                 int pyramid_levels = 4);
+
+    // once_flag is neither copyable nor movable; pass contexts by reference
+    FrameContext(const FrameContext&) = delete;
+    FrameContext& operator=(const FrameContext&) = delete;
+
+    // Source frame and metadata
+    const cv::Mat& frame() const { return frame_; }
+    int64_t index() const { return index_; }
+    double timestampMs() const { return timestamp_ms_; }
+
+    // Single-channel 8-bit version of the frame at full resolution
+    const cv::Mat& gray() const;
+
+    // Grayscale at 1/2 and 1/4 scale (area interpolation, quarter built from half)
+    const cv::Mat& half() const;
+    const cv::Mat& quarter() const;
+
+    // Gaussian pyramid of the grayscale frame; level 0 is gray() itself
+    const std::vector<cv::Mat>& pyramid() const;
+
+    // 64-bit difference hash of a 9x8 grayscale thumbnail
+    uint64_t dHash() const;
+
+    // Number of differing bits between two hashes
+    static int hammingDistance(uint64_t a, uint64_t b);
+};
+
+} // namespace bbst
@@ -1,16 +1,22 @@
 #pragma once
 #include <deque>
 #include <iostream>
+#include <memory_resource>
 #include <opencv4/opencv2/opencv.hpp>
 
 namespace bbst {
 
 class Trajectory {
-    std::deque<cv::Point2f> points_;
+    std::pmr::deque<cv::Point2f> points_;  // Counted as tracking memory
     size_t max_length_;
     
 public:
-    explicit Trajectory(size_t max_len = 50) : max_length_(max_len) {}
+    // Counted against the tracking tag; defined out of line so this header
+    // doesn't pull in the memory statistics machinery
+    explicit Trajectory(size_t max_len = 50);
+    
+    Trajectory(size_t max_len, std::pmr::memory_resource* resource)
+        : points_(resource), max_length_(max_len) {}
     
     // Operator overloading (Topic 23)
     Trajectory& operator+=(const cv::Point2f& point) {
@@ -25,6 +31,13 @@ public:
         return points_[idx];
     }
     
+    // Move every point, e.g. into the frame after a camera pan
+    void translate(const cv::Point2f& shift) {
+        for (auto& point : points_) {
+            point += shift;
+        }
+    }
+    
     // Iterator support (Topic 7)
     auto begin() { return points_.begin(); }
     auto end() { return points_.end(); }
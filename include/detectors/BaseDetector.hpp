@@ -1,6 +1,11 @@
 #pragma once
 #include "core/IDetector.hpp"
 #include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace bbst {
 
@@ -9,6 +14,18 @@ class BaseDetector : public IDetector<Detection<>> {
 protected:
     float confidence_threshold_;
     cv::Size input_size_;
+    std::vector<std::string> class_names_;
+    
+    // Use GPU if available
+    static void configureBackend(cv::dnn::Net& net) {
+        if (cv::cuda::getCudaEnabledDeviceCount() > 0) {
+            net.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
+            net.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
+        } else {
+            net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+        }
+    }
     
     // Template method pattern (Topic 26)
     virtual cv::Mat preProcess(const cv::Mat& frame) = 0;  // Returns processed blob
@@ -26,6 +43,22 @@ public:
     void setConfidenceThreshold(float threshold) override {
         confidence_threshold_ = threshold;
     }
+    
+    // One class name per line, in class id order
+    void loadClassNames(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open class names file: " + path);
+        }
+        
+        class_names_.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            class_names_.push_back(line);
+        }
+    }
+    
+    const std::vector<std::string>& getClassNames() const { return class_names_; }
 };
 
 } // namespace bbst
\ No newline at end of file
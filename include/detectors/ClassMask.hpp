@@ -0,0 +1,56 @@
+#pragma once
+#include <initializer_list>
+#include <vector>
+
+namespace bbst {
+
+// Runtime subset of class ids the decoder should score.
+// Score rows of classes outside the mask are only read for the few anchors
+// that pass the threshold, to check they are not another class's.
+class ClassMask {
+private:
+    std::vector<int> ids_;  // Empty = every class
+    
+public:
+    ClassMask() = default;
+    ClassMask(std::initializer_list<int> ids) : ids_(ids) {}
+    explicit ClassMask(std::vector<int> ids) : ids_(std::move(ids)) {}
+    
+    static ClassMask all() { return ClassMask(); }
+    
+    bool isAll() const { return ids_.empty(); }
+    const std::vector<int>& ids() const { return ids_; }
+    
+    bool contains(int class_id) const {
+        if (isAll()) return true;
+        for (int id : ids_) {
+            if (id == class_id) return true;
+        }
+        return false;
+    }
+    
+    // This mask plus one class (all stays all)
+    ClassMask with(int class_id) const {
+        if (isAll() || contains(class_id)) return *this;
+        ClassMask mask = *this;
+        mask.ids_.push_back(class_id);
+        return mask;
+    }
+};
+
+// Compile-time class subset: the scoring loop is unrolled per class id
+// (Topic 36: variadic templates)
+template<int... Ids>
+struct StaticClassMask {
+    static_assert(sizeof...(Ids) > 0, "StaticClassMask needs at least one class");
+    
+    static ClassMask toRuntime() { return ClassMask{Ids...}; }
+    static constexpr bool contains(int class_id) { return ((class_id == Ids) || ...); }
+};
+
+// Common masks for the basketball model
+constexpr int RIM_CLASS = 1;
+using BallClasses = StaticClassMask<0, 2>;   // basketball, sports ball
+using RimClasses = StaticClassMask<RIM_CLASS>;
+
+} // namespace bbst
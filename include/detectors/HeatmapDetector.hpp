@@ -0,0 +1,102 @@
+#pragma once
+#include "BaseDetector.hpp"
+#include "ClassMask.hpp"
+#include <opencv2/dnn.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bbst {
+
+// Center-heatmap (CenterNet-style) model configuration
+struct HeatmapConfig {
+    float input_width = 512.0f;
+    float input_height = 512.0f;
+    float confidence_threshold = 0.3f;
+    int top_k = 16;                    // Peaks kept per frame, over all classes
+    
+    bool logits = false;               // Heatmap is pre-sigmoid
+    bool size_in_cells = true;         // Size output in heatmap cells (CenterNet), else input pixels
+    float default_size = 16.0f;        // Box side in input pixels without a size output
+    
+    // Output names; the size and offset outputs are optional
+    std::string heatmap_output = "hm";
+    std::string size_output = "wh";
+    std::string offset_output = "reg";
+};
+
+// Local maximum of one heatmap class plane
+struct HeatmapPeak {
+    int class_id = -1;
+    float score = 0.0f;
+    cv::Point cell;                    // Integer heatmap cell
+    cv::Point2f position;              // Sub-pixel, in heatmap cells (cell centre at +0.5)
+};
+
+// Sibling of YoloDetector for models that output a per-class centre heatmap
+// [1, C, H, W] at a fixed stride, plus optional box size and sub-cell
+// offset maps [1, 2, H, W]. Peaks replace anchors and NMS: a cell is a peak
+// when it equals the 3x3 max-pool of its plane (cv::dilate, vectorized by
+// OpenCV), and the top-K peaks over all classes become detections.
+class HeatmapDetector : public BaseDetector {
+private:
+    std::unique_ptr<cv::dnn::Net> net_;
+    HeatmapConfig config_;
+    
+    // Heatmap first, then size and offset when the model has them
+    std::vector<cv::String> output_names_;
+    bool has_sizes_;
+    bool has_offsets_;
+    
+    std::vector<cv::Mat> runInference(const cv::Mat& blob);
+    std::vector<Detection<>> decodeOutputs(const std::vector<cv::Mat>& outputs,
+                                           const cv::Size& original_size,
+                                           const ClassMask& mask) const;
+
+protected:
+    cv::Mat preProcess(const cv::Mat& frame) override;
+    std::vector<Detection<>> postProcess(const std::vector<cv::Mat>& outputs,
+                                         const cv::Mat& original_frame) override;
+
+public:
+    explicit HeatmapDetector(const std::string& model_path,
+                             const std::string& class_names_path = "",
+                             const HeatmapConfig& config = HeatmapConfig());
+    
+    ~HeatmapDetector() override = default;
+    
+    HeatmapDetector(const HeatmapDetector&) = delete;
+    HeatmapDetector& operator=(const HeatmapDetector&) = delete;
+    
+    std::vector<Detection<>> detect(const cv::Mat& frame) override;
+    
+    // Unselected class planes are never pooled or scanned
+    std::vector<Detection<>> detect(const cv::Mat& frame, const ClassMask& mask);
+    
+    cv::Size getInputSize() const {
+        return cv::Size(static_cast<int>(config_.input_width),
+                        static_cast<int>(config_.input_height));
+    }
+    bool hasSizeOutput() const { return has_sizes_; }
+    bool hasOffsetOutput() const { return has_offsets_; }
+    
+    // One forward at the input size, so the first timed frame doesn't pay
+    // for layer allocation
+    void warmUp();
+    
+    // Peaks of a [C, H, W] or [1, C, H, W] heatmap at or above threshold,
+    // strongest first, at most top_k. A connected plateau of any shape yields
+    // one peak, at its first cell in scan order. Positions are refined by a
+    // parabola through each peak's neighbours.
+    static std::vector<HeatmapPeak> findPeaks(const cv::Mat& heatmap, float threshold, int top_k,
+                                              const ClassMask& mask = ClassMask::all());
+    
+    // Detections in original image pixels; sizes and offsets may be empty.
+    // Offsets, when present, replace the parabola refinement.
+    static std::vector<Detection<>> decode(const cv::Mat& heatmap, const cv::Mat& sizes,
+                                           const cv::Mat& offsets, const HeatmapConfig& config,
+                                           const cv::Size& original_size,
+                                           const ClassMask& mask = ClassMask::all());
+};
+
+} // namespace bbst
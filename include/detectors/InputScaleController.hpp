@@ -0,0 +1,47 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+namespace bbst {
+
+// Configuration for scale-adaptive input resolution
+struct InputScaleConfig {
+    std::vector<int> sizes = {320, 480, 640, 960};  // Square network sizes, ascending
+    int default_size = 640;             // Used once the ball has been lost for a while
+    float target_ball_pixels = 16.0f;   // Ball size (network pixels) to keep above
+    float hysteresis = 0.3f;            // Extra margin required before stepping down
+    int frames_to_shrink = 15;          // Consecutive votes needed to step down
+    int frames_to_grow = 3;             // Consecutive votes needed to step up
+    int frames_to_fallback = 10;        // Consecutive lost frames before the default
+};
+
+// Picks the cheapest pre-warmed input size that keeps the tracked ball above
+// the model's minimum detectable size. Stepping up reacts quickly (a ball
+// that shrinks below the limit is about to be lost); stepping down needs a
+// margin and a longer streak so sizes don't flap. A lost ball keeps the
+// size for a few frames too, so a single missed detection doesn't switch.
+class InputScaleController {
+private:
+    InputScaleConfig config_;
+    int fallback_;
+    int current_;
+    int candidate_;
+    int streak_;
+    int lost_streak_;                   // Consecutive frames without a tracked ball
+    
+    int preferredSize(float ball_size, const cv::Size& frame_size) const;
+    
+public:
+    explicit InputScaleController(const InputScaleConfig& config = InputScaleConfig());
+    
+    // Feed the tracked ball size (frame pixels); returns the size to use next
+    int update(float ball_size, const cv::Size& frame_size, bool tracking);
+    
+    int current() const { return current_; }
+    const std::vector<int>& sizes() const { return config_.sizes; }
+    
+    // Ball size in network pixels when the frame is resized to input_size
+    static float ballPixels(float ball_size, const cv::Size& frame_size, int input_size);
+};
+
+} // namespace bbst
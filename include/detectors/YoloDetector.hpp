@@ -1,12 +1,32 @@
 #pragma once
 #include "BaseDetector.hpp"
+#include "ClassMask.hpp"
+#include "io/FrameSource.hpp"
 #include <opencv2/dnn.hpp>
+#include <cfloat>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace bbst {
 
+// Class-specific geometric prior, in original image pixels
+struct ClassPrior {
+    float min_size = 0.0f;             // (width + height) / 2
+    float max_size = FLT_MAX;
+    float min_aspect_ratio = 0.0f;     // width / height
+    float max_aspect_ratio = FLT_MAX;
+    
+    bool accepts(float width, float height) const {
+        if (height <= 0.0f) return false;
+        float size = (width + height) / 2.0f;
+        float aspect_ratio = width / height;
+        return size >= min_size && size <= max_size &&
+               aspect_ratio >= min_aspect_ratio && aspect_ratio <= max_aspect_ratio;
+    }
+};
+
 // YOLO-specific configuration
 struct YoloConfig {
     float input_width = 640.0f;
@@ -14,20 +34,77 @@ struct YoloConfig {
     float score_threshold = 0.25f;
     float nms_threshold = 0.45f;
     float confidence_threshold = 0.25f;
+    
+    bool verbose = true;    // Per-frame decode statistics on stdout
+    
+    // Priors checked in the decode loop, before NMS (classes without an entry pass)
+    std::map<int, ClassPrior> class_priors;
+};
+
+// Decode of one [4 + classes, anchors] output plane. Scoring takes the best
+// class per anchor over the selected class rows only; decodeScored then
+// builds boxes, checks priors and runs per-class NMS. Anchors whose best
+// class overall is outside the mask are dropped, not relabelled, so a masked
+// decode is the unmasked one filtered to the mask. Holds the per-anchor
+// scratch so it is reused across frames.
+class YoloDecoder {
+private:
+    std::vector<float> best_scores_;
+    std::vector<int> best_ids_;
+    std::vector<char> scored_;          // Per class: its row was scored
+    
+    void resetScores(const cv::Mat& output);
+    void scoreClassRow(const cv::Mat& output, int class_id);
+    
+    // An unscored class beats the anchor's best scored one
+    bool outscored(const cv::Mat& output, int anchor, int class_id, float score) const;
+    
+public:
+    void scoreClasses(const cv::Mat& output, const ClassMask& mask);
+    
+    // Compile-time specialization for fixed masks such as BallClasses
+    template<int... Ids>
+    void scoreClasses(const cv::Mat& output, StaticClassMask<Ids...> mask);
+    
+    // Detections of the last scored plane, boxes in original_size pixels
+    std::vector<Detection<>> decodeScored(const cv::Mat& output, const YoloConfig& config,
+                                          const cv::Size& original_size) const;
 };
 
 class YoloDetector : public BaseDetector {
 private:
     std::unique_ptr<cv::dnn::Net> net_;
     YoloConfig config_;
-    std::vector<std::string> class_names_;
+    
+    // Extra networks pre-warmed at other input sizes; -1 selects net_
+    std::string model_path_;
+    cv::Size base_size_;
+    std::vector<std::pair<cv::Size, std::unique_ptr<cv::dnn::Net>>> sized_nets_;
+    int active_net_;
+    
+    // Cleared once the model rejects a batch (static batch size in the export)
+    bool batch_inference_;
+    
+    YoloDecoder decoder_;
     
     // Helper methods
+    static void warmUp(cv::dnn::Net& net, const cv::Size& size);
+    cv::dnn::Net& activeNet();
     cv::Mat formatYoloInput(const cv::Mat& source);
+    cv::Mat formatYoloInput(const io::YuvFrame& source);
+    std::vector<cv::Mat> runInference(const cv::Mat& blob);
     std::vector<Detection<>> parseYoloOutput(const std::vector<cv::Mat>& outputs,
-                                              const cv::Mat& original_image);
-    std::vector<int> performNMS(const std::vector<cv::Rect>& boxes,
-                                const std::vector<float>& confidences);
+                                              const cv::Size& original_size);
+    
+    // Output plane [4 + classes, anchors] for decoder_
+    cv::Mat prepareOutput(const std::vector<cv::Mat>& outputs) const;
+    
+    static cv::Size frameSize(const cv::Mat& frame) { return frame.size(); }
+    static cv::Size frameSize(const io::YuvFrame& frame) {
+        return cv::Size(frame.width(), frame.height());
+    }
+    
+    static void offsetDetections(std::vector<Detection<>>& detections, const cv::Point& offset);
     
 protected:
     // Override virtual methods from BaseDetector
@@ -55,9 +132,55 @@ public:
     // Override detect from BaseDetector
     std::vector<Detection<>> detect(const cv::Mat& frame) override;
     
-    // Additional YOLO-specific methods
-    void loadClassNames(const std::string& path);
-    const std::vector<std::string>& getClassNames() const { return class_names_; }
+    // Detect straight from decoder YUV (fused conversion, no BGR intermediate)
+    std::vector<Detection<>> detect(const io::YuvFrame& frame,
+                                    const ClassMask& mask = ClassMask::all());
+    
+    // Only score the classes in the mask (e.g. ball classes while the rim is cached)
+    std::vector<Detection<>> detect(const cv::Mat& frame, const ClassMask& mask);
+    
+    // Detect inside a region of interest (e.g. the tracker's search region);
+    // boxes are returned in frame coordinates
+    std::vector<Detection<>> detect(const cv::Mat& frame, const cv::Rect& roi,
+                                    const ClassMask& mask);
+    
+    // Several regions of one frame in a single forward pass, one batch entry
+    // per region, each resized to the input size. Returns one list per region,
+    // boxes in frame coordinates. Models exported with a fixed batch size fall
+    // back to one pass per region.
+    std::vector<std::vector<Detection<>>> detectBatch(const cv::Mat& frame,
+                                                      const std::vector<cv::Rect>& regions,
+                                                      const ClassMask& mask);
+    
+    // Compile-time specialization for fixed masks such as BallClasses
+    template<typename Frame, int... Ids>
+    std::vector<Detection<>> detect(const Frame& frame, StaticClassMask<Ids...> mask);
+    
+    // Scale-adaptive input: load and warm one network per size up front so
+    // switching between them later costs nothing. Requires a model exported
+    // with dynamic input shapes.
+    void prepareInputSizes(const std::vector<cv::Size>& sizes);
+    bool setInputSize(const cv::Size& size);  // False if the size was not prepared
+    cv::Size getInputSize() const {
+        return cv::Size(static_cast<int>(config_.input_width),
+                        static_cast<int>(config_.input_height));
+    }
 };
 
+// Template implementation
+template<int... Ids>
+void YoloDecoder::scoreClasses(const cv::Mat& output, StaticClassMask<Ids...> /*mask*/) {
+    resetScores(output);
+    (scoreClassRow(output, Ids), ...);  // Fold expression, one pass per class
+}
+
+template<typename Frame, int... Ids>
+std::vector<Detection<>> YoloDetector::detect(const Frame& frame, StaticClassMask<Ids...> mask) {
+    cv::Mat output = prepareOutput(runInference(formatYoloInput(frame)));
+    if (output.empty()) return {};
+    
+    decoder_.scoreClasses(output, mask);
+    return decoder_.decodeScored(output, config_, frameSize(frame));
+}
+
 } // namespace bbst
\ No newline at end of file
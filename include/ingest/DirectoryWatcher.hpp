@@ -0,0 +1,44 @@
+#pragma once
+#include "ingest/JobQueue.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bbst::ingest {
+
+// A finished video file in one of the watched directories
+struct WatchEvent {
+    std::string path;
+    Priority priority;
+};
+
+// inotify watch on drop folders. Only completed files are reported:
+// IN_CLOSE_WRITE for files written in place, IN_MOVED_TO for files renamed
+// into the folder (the usual atomic "write elsewhere, then mv" pattern).
+class DirectoryWatcher {
+private:
+    int fd_;
+    std::map<int, std::pair<std::string, Priority>> watches_;  // wd -> (dir, priority)
+    std::vector<char> buffer_;
+
+public:
+    DirectoryWatcher();
+    ~DirectoryWatcher();
+    
+    // Non-copyable (owns the inotify descriptor)
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+    
+    // Throws if the directory cannot be watched
+    void add(const std::string& dir, Priority priority);
+    
+    // Files completed since the last call, waiting up to timeout_ms for one
+    std::vector<WatchEvent> poll(int timeout_ms);
+    
+    // Videos already in the watched folders (dropped while the daemon was down)
+    std::vector<WatchEvent> scanExisting() const;
+    
+    static bool isVideoFile(const std::string& path);
+};
+
+} // namespace bbst::ingest
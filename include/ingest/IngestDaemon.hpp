@@ -0,0 +1,77 @@
+#pragma once
+#include "detectors/YoloDetector.hpp"
+#include "ingest/DirectoryWatcher.hpp"
+#include "ingest/JobJournal.hpp"
+#include "ingest/JobQueue.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include "tracking/KalmanTracker.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bbst::ingest {
+
+struct IngestConfig {
+    std::string journal_path = "ingest.journal";
+    std::string output_dir = "tracks";
+    int workers = 2;                  // Also the number of loaded models
+    int max_attempts = 3;             // Crashing starts or failures before a clip is abandoned
+    int recent_window_hours = 24;     // Older files in a recent folder count as archive
+    int poll_interval_ms = 500;
+};
+
+// Long-running ingest service: watched drop folders feed a persistent
+// priority queue, drained by a fixed pool of workers. Models are loaded once
+// per worker and reused for every clip.
+class IngestDaemon {
+private:
+    std::string model_path_;
+    std::string names_path_;
+    YoloConfig yolo_config_;
+    tracking::TrackerConfig tracker_config_;
+    pipeline::PipelineOptions pipeline_options_;
+    IngestConfig config_;
+    
+    JobJournal journal_;
+    JobQueue queue_;
+    DirectoryWatcher watcher_;
+    std::vector<std::string> roots_;  // Watched folders, for output names
+    std::vector<std::unique_ptr<YoloDetector>> detectors_;
+    std::vector<std::thread> workers_;
+    std::atomic<int> completed_;
+    std::atomic<int> failed_;
+    
+    void submit(const WatchEvent& event, bool check_age);
+    void workerLoop(int worker_id);
+    void processJob(YoloDetector& detector, const Job& job);
+
+public:
+    IngestDaemon(const std::string& model_path,
+                 const std::string& names_path,
+                 const YoloConfig& yolo_config,
+                 const tracking::TrackerConfig& tracker_config,
+                 const pipeline::PipelineOptions& pipeline_options,
+                 const IngestConfig& config = IngestConfig());
+    ~IngestDaemon();
+    
+    // Non-copyable (owns threads)
+    IngestDaemon(const IngestDaemon&) = delete;
+    IngestDaemon& operator=(const IngestDaemon&) = delete;
+    
+    void watch(const std::string& dir, Priority priority);
+    
+    // Blocks until stop is set. Running clips finish; queued ones stay in
+    // the journal for the next start.
+    void run(const std::atomic<bool>& stop);
+    
+    // Output track file for a clip: its path relative to the watched folder,
+    // extension included, plus ".csv" (clip.mp4 and clip.mov stay apart)
+    std::string outputPath(const std::string& video_path) const;
+    
+    int completed() const { return completed_; }
+    int failed() const { return failed_; }
+};
+
+} // namespace bbst::ingest
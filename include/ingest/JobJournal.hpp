@@ -0,0 +1,70 @@
+#pragma once
+#include "ingest/JobQueue.hpp"
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bbst::ingest {
+
+// Append-only, line-based record of the queue so a restart neither loses nor
+// repeats work. Every state change is one flushed line:
+//   E <id> <priority> <attempts> <path>   enqueued
+//   S <id>                                started
+//   D <id>                                done
+//   F <id>                                failed (path forgotten, so retried)
+//   K <path>                              finished in an earlier session
+//   X <failures> <path>                   failed runs in earlier sessions
+// Fields are tab separated. Opening a journal replays it, then compacts it
+// to K lines for finished paths, X lines for paths that failed and E lines
+// for everything still pending.
+class JobJournal {
+private:
+    std::string path_;
+    std::ofstream out_;
+    mutable std::mutex mutex_;
+    uint64_t next_id_;
+    int max_attempts_;
+    
+    std::map<uint64_t, Job> pending_;       // Enqueued, not finished
+    std::set<std::string> known_paths_;     // Queued, finished or given up; failed paths are dropped
+    std::map<std::string, int> failures_;   // Failed runs per path, until it is done
+    std::vector<std::string> abandoned_;    // Gave up after max_attempts starts
+    
+    void applyRecord(const std::string& line);
+    void recordFailure(const std::string& path);
+    void replay();
+    void compact();
+    void append(const std::string& record);
+
+public:
+    // Jobs started max_attempts times without finishing (e.g. a file that
+    // crashes the decoder) are dropped on replay; paths that failed
+    // max_attempts times are not queued again
+    explicit JobJournal(const std::string& path, int max_attempts = 3);
+    
+    // Non-copyable (owns the stream)
+    JobJournal(const JobJournal&) = delete;
+    JobJournal& operator=(const JobJournal&) = delete;
+    
+    // Record a new job; empty for a path that is already queued or finished.
+    // A failed path can be queued again, e.g. when the file is dropped anew
+    // or found by the next start's catch-up scan, until it has failed
+    // max_attempts times.
+    std::optional<Job> enqueue(const std::string& path, Priority priority);
+    
+    void markStarted(const Job& job);
+    void markDone(const Job& job);
+    void markFailed(const Job& job);
+    
+    // Jobs left over from the previous session, to put back in the queue
+    std::vector<Job> pendingJobs() const;
+    const std::vector<std::string>& abandonedPaths() const { return abandoned_; }
+    
+    bool isKnown(const std::string& path) const;
+};
+
+} // namespace bbst::ingest
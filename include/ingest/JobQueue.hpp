@@ -0,0 +1,61 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace bbst::ingest {
+
+// Scheduling classes, most urgent first
+enum class Priority {
+    Live = 0,       // Clips from the live drop folder
+    Recent = 1,     // Today's clips
+    Archive = 2     // Backlog, processed when nothing else is waiting
+};
+
+const char* priorityName(Priority priority);
+
+// One video to process
+struct Job {
+    uint64_t id = 0;                // Journal id, increasing in submission order
+    std::string path;
+    Priority priority = Priority::Recent;
+    int attempts = 0;               // Previous starts that never finished
+};
+
+// Thread-safe priority queue: live > recent > archive, FIFO within a class
+class JobQueue {
+private:
+    struct Later {
+        bool operator()(const Job& a, const Job& b) const {
+            return a.priority != b.priority ? a.priority > b.priority : a.id > b.id;
+        }
+    };
+    
+    std::priority_queue<Job, std::vector<Job>, Later> jobs_;
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    bool closed_;
+
+public:
+    JobQueue();
+    
+    // Non-copyable (owns a mutex)
+    JobQueue(const JobQueue&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+    
+    void push(Job job);
+    
+    // Blocks until a job is available; empty once the queue is closed
+    std::optional<Job> pop();
+    
+    // Wake all waiting workers; jobs still queued are left to the journal
+    void close();
+    
+    size_t size() const;
+};
+
+} // namespace bbst::ingest
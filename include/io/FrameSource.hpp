@@ -0,0 +1,126 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bbst::io {
+
+// Chroma layout of a 4:2:0 frame
+enum class YuvLayout {
+    NV12,   // Y plane followed by interleaved UV plane
+    I420    // Y plane followed by separate U and V planes
+};
+
+// Raw 4:2:0 frame stored the way OpenCV expects it for cv::cvtColor:
+// a single continuous CV_8UC1 buffer of (height * 3 / 2) x width.
+struct YuvFrame {
+    YuvLayout layout = YuvLayout::NV12;
+    cv::Mat data;
+
+    int width() const { return data.cols; }
+    int height() const { return data.rows * 2 / 3; }
+    bool empty() const { return data.empty(); }
+
+    // Y plane as a view (no copy) - doubles as the grayscale frame
+    cv::Mat luma() const { return data.rowRange(0, height()); }
+
+    // BGR conversion, only needed when something has to render the frame
+    void toBgr(cv::Mat& bgr) const;
+};
+
+// Block motion vector exported by the codec, in frame pixels
+struct MotionVector {
+    cv::Point2f position;   // Block center in the current frame
+    cv::Point2f motion;     // Displacement of the block since the reference frame
+    cv::Size block;         // 4x4 .. 16x16 for H.264, up to 64x64 for HEVC
+};
+
+// All motion vectors of one decoded frame. Intra frames carry none.
+struct MotionField {
+    cv::Size frame_size;
+    std::vector<MotionVector> vectors;
+    bool intra = false;
+
+    bool empty() const { return vectors.empty(); }
+};
+
+// Frame source interface (Topic 17: virtual interface)
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual bool isOpened() const = 0;
+
+    // Read next frame as BGR
+    virtual bool read(cv::Mat& bgr) = 0;
+
+    // Read next frame as raw YUV; only valid when supportsYuv() is true
+    virtual bool readYuv(YuvFrame& yuv) { (void)yuv; return false; }
+    virtual bool supportsYuv() const { return false; }
+
+    // Stream properties
+    virtual cv::Size frameSize() const = 0;
+    virtual double fps() const = 0;
+    virtual int frameCount() const = 0;
+
+    // Presentation time of the last frame read
+    virtual double timestampMs() const = 0;
+
+    // Codec motion vectors of the last frame read; nullptr when the source
+    // cannot export them
+    virtual const MotionField* motionField() const { return nullptr; }
+};
+
+// cv::VideoCapture-backed source (decoder output is already converted to BGR)
+class VideoFileSource : public FrameSource {
+private:
+    cv::VideoCapture cap_;
+
+public:
+    explicit VideoFileSource(const std::string& path);
+
+    bool isOpened() const override { return cap_.isOpened(); }
+    bool read(cv::Mat& bgr) override;
+
+    cv::Size frameSize() const override;
+    double fps() const override;
+    int frameCount() const override;
+    double timestampMs() const override;
+
+    cv::VideoCapture& capture() { return cap_; }
+};
+
+// Raw 4:2:0 stream from a file or stdin ("-"), e.g. the output of
+//   ffmpeg -i game.mp4 -pix_fmt nv12 -f rawvideo -
+// Frames are handed out without any colour conversion.
+class RawYuvSource : public FrameSource {
+private:
+    std::ifstream file_;
+    std::istream* in_;
+    cv::Size size_;
+    double fps_;
+    YuvLayout layout_;
+    int frames_read_;
+
+public:
+    RawYuvSource(const std::string& path, cv::Size size, double fps,
+                 YuvLayout layout = YuvLayout::NV12);
+
+    // Non-copyable (owns the stream)
+    RawYuvSource(const RawYuvSource&) = delete;
+    RawYuvSource& operator=(const RawYuvSource&) = delete;
+
+    bool isOpened() const override { return in_ != nullptr && in_->good(); }
+    bool read(cv::Mat& bgr) override;
+    bool readYuv(YuvFrame& yuv) override;
+    bool supportsYuv() const override { return true; }
+
+    cv::Size frameSize() const override { return size_; }
+    double fps() const override { return fps_; }
+    int frameCount() const override { return -1; }  // Unknown for streams
+    double timestampMs() const override;
+};
+
+} // namespace bbst::io
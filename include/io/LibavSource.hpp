@@ -0,0 +1,65 @@
+#pragma once
+#include "io/FrameSource.hpp"
+#include <string>
+
+// Only available when the build found libavformat/libavcodec (BBST_HAVE_LIBAV)
+#ifdef BBST_HAVE_LIBAV
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVFrame;
+struct AVPacket;
+struct SwsContext;
+
+namespace bbst::io {
+
+// Frame source decoding directly with libavcodec. Besides the raw YUV planes
+// it exports the per-block motion vectors the decoder already computed
+// (flags2 +export_mvs), so motion analysis costs no extra decode work.
+class LibavSource : public FrameSource {
+private:
+    AVFormatContext* format_;
+    AVCodecContext* codec_;
+    AVFrame* frame_;
+    AVPacket* packet_;
+    SwsContext* sws_;              // Only for pixel formats other than 4:2:0
+    
+    int stream_index_;
+    double time_base_ms_;
+    int64_t start_pts_;
+    double fps_;
+    int frame_count_;
+    double timestamp_ms_;
+    bool eof_;
+    
+    MotionField motion_;
+    
+    bool decodeNext();
+    void extractMotionVectors();
+    void close();
+
+public:
+    // threads = 0 lets libavcodec pick
+    explicit LibavSource(const std::string& path, int threads = 0);
+    ~LibavSource() override;
+    
+    // Non-copyable (owns the decoder)
+    LibavSource(const LibavSource&) = delete;
+    LibavSource& operator=(const LibavSource&) = delete;
+    
+    bool isOpened() const override { return codec_ != nullptr; }
+    bool read(cv::Mat& bgr) override;
+    bool readYuv(YuvFrame& yuv) override;
+    bool supportsYuv() const override { return true; }
+    
+    cv::Size frameSize() const override;
+    double fps() const override { return fps_; }
+    int frameCount() const override { return frame_count_; }
+    double timestampMs() const override { return timestamp_ms_; }
+    
+    const MotionField* motionField() const override { return &motion_; }
+};
+
+} // namespace bbst::io
+
+#endif // BBST_HAVE_LIBAV
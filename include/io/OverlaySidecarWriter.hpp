@@ -0,0 +1,47 @@
+#pragma once
+#include "core/Trajectory.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include "ui/OverlayRenderer.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace bbst::io {
+
+// Overlay primitives as a timed JSON Lines stream, for players that draw
+// overlays themselves instead of receiving them burned into the pixels.
+//
+// The first line describes the stream (frame size, fps, class names and the
+// ColorScheme as "#rrggbb"); every following line is one frame:
+//   {"f":12,"t":400.0,"boxes":[[x,y,w,h,class,conf],...],"trail":[x0,y0,x1,y1,...]}
+// Labels are "<class name> <conf>" as drawn by OverlayRenderer, and the trail
+// is the ball trajectory polyline, oldest point first, present while the
+// track is stable. While tracking, frames carry the ball's kinematics as
+//   "kin":[speed_px_s,accel_px_s2,curvature,flight_s(,speed_mps)]
+// with the last entry only when a scale is known. With player tracking, frames also carry
+//   "players":[[id,x,y,w,h],...],"holder":id,
+//   "events":[{"type":"pass","frame":f,"player":to,"from":from},{"type":"make","shooter":id}]
+// where players, holder, events and an outcome's shooter are omitted when
+// empty or unknown.
+class OverlaySidecarWriter {
+private:
+    std::ofstream out_;
+
+public:
+    OverlaySidecarWriter(const std::string& path, cv::Size frame_size, double fps,
+                         const std::vector<std::string>& class_names,
+                         const ui::ColorScheme& colors = ui::ColorScheme());
+    
+    // Non-copyable (owns the stream)
+    OverlaySidecarWriter(const OverlaySidecarWriter&) = delete;
+    OverlaySidecarWriter& operator=(const OverlaySidecarWriter&) = delete;
+    
+    // trail is null when no trajectory should be drawn for this frame
+    void write(const pipeline::FrameResult& result, const Trajectory* trail = nullptr);
+    void flush() { out_.flush(); }
+    
+    // BGR scalar as "#rrggbb"
+    static std::string hexColor(const cv::Scalar& bgr);
+};
+
+} // namespace bbst::io
@@ -0,0 +1,102 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bbst::io {
+
+struct SegmentedWriterConfig {
+    int segment_frames = 60;        // Frames per segment; each segment starts on a keyframe
+    int threads = 0;                // Concurrent segment encoders (0 = cores, at most 4)
+    int max_pending = 1;            // Full segments waiting for a free encoder
+    int fourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+    bool playlist = false;          // Keep H.264 segments and write an HLS playlist instead
+    std::string ffmpeg = "ffmpeg";  // Used for lossless concatenation
+};
+
+// One finished segment file
+struct SegmentInfo {
+    int index = 0;
+    std::string path;
+    int frames = 0;
+    bool ok = false;
+};
+
+// Drop-in replacement for cv::VideoWriter that scales encoding across cores.
+//
+// The stream is cut into fixed-length segments. Every segment is encoded by
+// its own encoder on a worker thread, so segments are independent, closed
+// GOPs. On close() they are joined without re-encoding (ffmpeg concat
+// demuxer, stream copy) into the output file, or listed in an HLS playlist
+// when the output is the playlist itself.
+//
+// Frames are copied while their segment waits: memory is bounded by
+// (threads + max_pending + 1) segments of frames, and write() blocks while
+// the encoders are behind. At 1080p a 60-frame segment is ~370 MB, hence the
+// small default encoder count.
+//
+// HLS players only accept H.264 in MPEG-TS, so playlist output always uses
+// avc1 (ignoring fourcc) and the constructor throws when it is unavailable.
+class SegmentedVideoWriter {
+private:
+    struct Segment {
+        int index = 0;
+        std::vector<cv::Mat> frames;
+    };
+    
+    std::string output_path_;
+    cv::Size frame_size_;
+    double fps_;
+    SegmentedWriterConfig config_;
+    
+    Segment current_;
+    int next_index_;
+    bool closed_;
+    
+    std::deque<Segment> pending_;
+    std::vector<SegmentInfo> finished_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable space_ready_;
+    bool stopping_;
+    std::vector<std::thread> encoders_;
+    
+    void encoderLoop();
+    SegmentInfo encode(const Segment& segment) const;
+    void submit();
+    void finish();
+
+public:
+    SegmentedVideoWriter(const std::string& output_path, cv::Size frame_size, double fps,
+                         const SegmentedWriterConfig& config = SegmentedWriterConfig());
+    
+    // Closes if close() was not called; errors are only logged
+    ~SegmentedVideoWriter();
+    
+    // Non-copyable (owns threads)
+    SegmentedVideoWriter(const SegmentedVideoWriter&) = delete;
+    SegmentedVideoWriter& operator=(const SegmentedVideoWriter&) = delete;
+    
+    void write(const cv::Mat& frame);
+    
+    // Encodes the last partial segment, waits for all encoders and joins the
+    // segments. Throws if a segment or the concatenation failed; the segment
+    // files are then left in place.
+    void close();
+    
+    // Segments in stream order, complete after close()
+    const std::vector<SegmentInfo>& segments() const { return finished_; }
+    
+    // "<dir>/<stem>.seg00003<ext>"
+    static std::string segmentPath(const std::string& output_path, int index, bool playlist);
+    
+    // ffmpeg concat demuxer list and HLS (VOD) playlist for the segments
+    static std::string concatList(const std::vector<SegmentInfo>& segments);
+    static std::string hlsPlaylist(const std::vector<SegmentInfo>& segments, double fps);
+};
+
+} // namespace bbst::io
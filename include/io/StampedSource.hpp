@@ -0,0 +1,88 @@
+#pragma once
+#include "io/FrameSource.hpp"
+#include "util/LatencyStats.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace bbst::io {
+
+// Identity and capture time of a synthetic frame
+struct FrameStamp {
+    uint32_t frame_id = 0;
+    int64_t capture_us = 0;     // CLOCK_MONOTONIC (steady_clock) microseconds
+};
+
+// Writes a FrameStamp into the pixels as a black/white barcode along the
+// bottom edge, so it survives anything that carries the image along:
+// queues, copies, colour conversion, overlay rendering and lossy encoding.
+// 104 cells: 32-bit frame id, 64-bit timestamp, 8-bit checksum.
+class FrameStamper {
+public:
+    static constexpr int BITS = 104;
+    
+    // Band height in rows for a frame of this width
+    static int bandHeight(int width);
+    
+    static void stamp(cv::Mat& bgr, const FrameStamp& stamp);
+    
+    // Empty when the band is missing or damaged (checksum mismatch)
+    static std::optional<FrameStamp> read(const cv::Mat& bgr);
+    
+    static int64_t nowUs();
+};
+
+// Synthetic live camera: a ball on a parabolic arc over a flat background,
+// every frame stamped at its capture time.
+//
+// In realtime mode frames come on the fps clock like a real camera: read()
+// waits for the next exposure, and a consumer that falls behind gets frames
+// that were captured in the past (and queued), up to max_queued of them;
+// older ones are dropped, as a V4L2 buffer ring would.
+class StampedSource : public FrameSource {
+private:
+    cv::Size size_;
+    double fps_;
+    int frames_;
+    bool realtime_;
+    int max_queued_;
+    
+    std::chrono::steady_clock::time_point start_;
+    int next_frame_;
+    int last_frame_;
+    int dropped_;
+    
+    void render(cv::Mat& bgr, int frame) const;
+
+public:
+    StampedSource(cv::Size size, double fps, int frames = 600,
+                  bool realtime = true, int max_queued = 4);
+    
+    bool isOpened() const override { return next_frame_ < frames_; }
+    bool read(cv::Mat& bgr) override;
+    
+    cv::Size frameSize() const override { return size_; }
+    double fps() const override { return fps_; }
+    int frameCount() const override { return frames_; }
+    double timestampMs() const override;
+    
+    // Frames the consumer was too slow to take
+    int dropped() const { return dropped_; }
+};
+
+// Output-side sink: decodes stamps from finished frames and records the
+// capture-to-output latency
+class LatencyProbe {
+private:
+    util::LatencyStats stats_;
+    int unreadable_ = 0;
+
+public:
+    // Call with the frame as it leaves the pipeline; false if no stamp
+    bool observe(const cv::Mat& bgr);
+    
+    const util::LatencyStats& stats() const { return stats_; }
+    int unreadable() const { return unreadable_; }
+};
+
+} // namespace bbst::io
@@ -0,0 +1,34 @@
+#pragma once
+#include "pipeline/BallPipeline.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace bbst::io {
+
+// Per-frame tracking output as CSV, one row per processed frame
+class TrackCsvWriter {
+private:
+    std::ofstream out_;
+    
+public:
+    explicit TrackCsvWriter(const std::string& path);
+    
+    // Non-copyable (owns the stream)
+    TrackCsvWriter(const TrackCsvWriter&) = delete;
+    TrackCsvWriter& operator=(const TrackCsvWriter&) = delete;
+    
+    void write(const pipeline::FrameResult& result);
+    void flush() { out_.flush(); }
+    
+    static const char* header();
+};
+
+// Reads a file written by TrackCsvWriter back into frame results, in file
+// order. Only the detection count is stored, so detections come back empty;
+// of the player state only the holder and its foot point are kept, so
+// possession changes can be rebuilt with analysis::possessionFromTrack and
+// shooters placed with analysis::locateShooters.
+std::vector<pipeline::FrameResult> readTrackCsv(const std::string& path);
+
+} // namespace bbst::io
@@ -0,0 +1,83 @@
+#pragma once
+#include "pipeline/BallPipeline.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bbst::pipeline {
+
+// Two-pass archive processing configuration
+struct ArchiveConfig {
+    int scan_stride = 15;             // Sample one frame in N during the scan
+    int scan_input_size = 320;        // Scan detector input; fixed-shape models scan at their own size
+    float scan_confidence = 0.35f;    // Minimum ball confidence for a scan hit
+    int padding_frames = 60;          // Context added around each active run
+    int merge_gap_frames = 90;        // Runs closer than this are merged
+    int workers = 0;                  // Segment workers, 0 = hardware concurrency
+    int progress_frames = 30;         // Frames between progress callbacks, per worker
+};
+
+// Half-open frame range [start, end)
+struct Segment {
+    int start = 0;
+    int end = 0;
+    
+    int length() const { return end - start; }
+};
+
+struct ArchiveStats {
+    int total_frames = 0;
+    int scanned_frames = 0;
+    int processed_frames = 0;
+    size_t segments = 0;
+    double scan_ms = 0.0;
+    double dense_ms = 0.0;
+};
+
+// Full-game archives are mostly dead time. Pass 1 samples every Nth frame at
+// low resolution to find where the ball is in play; pass 2 runs the full
+// pipeline densely over those segments only, in parallel across segments.
+class ArchiveProcessor {
+private:
+    std::string model_path_;
+    std::string names_path_;
+    YoloConfig yolo_config_;
+    tracking::TrackerConfig tracker_config_;
+    PipelineOptions pipeline_options_;
+    ArchiveConfig config_;
+    ArchiveStats stats_;
+    std::function<void()> on_progress_;
+    
+public:
+    ArchiveProcessor(const std::string& model_path,
+                     const std::string& names_path,
+                     const YoloConfig& yolo_config,
+                     const tracking::TrackerConfig& tracker_config,
+                     const PipelineOptions& pipeline_options = PipelineOptions(),
+                     const ArchiveConfig& config = ArchiveConfig());
+    
+    // Pass 1: sparse low-resolution scan for segments with the ball in play
+    std::vector<Segment> scan(const std::string& video_path);
+    
+    // Pass 2: dense tracking of each segment, segments spread over workers.
+    // Results are ordered by frame index.
+    std::vector<FrameResult> processSegments(const std::string& video_path,
+                                             const std::vector<Segment>& segments);
+    
+    // Both passes
+    std::vector<FrameResult> run(const std::string& video_path);
+    
+    const ArchiveStats& stats() const { return stats_; }
+    
+    // Called every progress_frames frames during both passes (e.g. to fold in
+    // energy counters before they wrap). Calls from segment workers are
+    // serialized, so the callback needs no locking of its own.
+    void setProgressCallback(std::function<void()> callback) { on_progress_ = std::move(callback); }
+    
+    // Turn sampled hit frames into padded, merged segments clipped to the video
+    static std::vector<Segment> buildSegments(const std::vector<int>& hit_frames,
+                                              int total_frames,
+                                              const ArchiveConfig& config);
+};
+
+} // namespace bbst::pipeline
@@ -0,0 +1,134 @@
+#pragma once
+#include "analysis/MakeMiss.hpp"
+#include "analysis/MotionCues.hpp"
+#include "analysis/Possession.hpp"
+#include "core/FrameContext.hpp"
+#include "detectors/InputScaleController.hpp"
+#include "detectors/YoloDetector.hpp"
+#include "io/FrameSource.hpp"
+#include "tracking/KalmanTracker.hpp"
+#include "tracking/PlayerTracker.hpp"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace bbst::pipeline {
+
+// Per-frame detection strategy
+struct PipelineOptions {
+    bool use_roi = false;             // Crop to the tracker's search region when confident
+    bool adaptive_input = false;      // Scale-adaptive detector input size
+    int rim_refresh_interval = 60;    // Frames between full-class passes
+    int min_roi_size = 160;
+    
+    // Codec motion cues (only used when the source exports motion vectors)
+    bool motion_gating = true;        // Skip the detector on static frames while idle
+    int max_gated_frames = 10;        // Run the detector at least this often anyway
+    
+    // Rim burst: while the predicted ball is near the rim, a native-resolution
+    // crop around the rim is detected in the same batch as the normal pass,
+    // and rim visits are judged make or miss
+    bool rim_burst = false;
+    analysis::MakeMissConfig make_miss;   // zone_scale also sizes the burst trigger
+    
+    // Players: person boxes decoded from the same forward pass as the ball
+    int person_class = -1;            // Person class id of the model, -1 if it has none
+                                      // (must differ from the ball and rim ids 0-2)
+    tracking::PlayerTrackerConfig players;
+    analysis::PossessionConfig possession;
+};
+
+// Everything the pipeline learned about one frame
+struct FrameResult {
+    int64_t frame_index = 0;
+    double timestamp_ms = 0.0;
+    std::vector<Detection<>> detections;
+    bool ball_detected = false;       // A detection was associated with the track
+    bool gated = false;               // Detector skipped, frame had no motion
+    bool tracking = false;
+    cv::Point2f position;             // Filtered ball position
+    float ball_size = 0.0f;
+    tracking::Kinematics kinematics;  // Of the ball track, while tracking
+    bool rim_burst = false;           // Rim crop was detected at native resolution
+    analysis::ShotOutcome outcome = analysis::ShotOutcome::None;
+    std::vector<tracking::PlayerTrack> players;   // Confirmed player tracks
+    int holder = -1;                  // Player id in possession, -1 while loose
+    std::vector<analysis::PossessionEvent> possession;  // Changes on this frame
+    int shooter = -1;                 // With an outcome: the player who let go last
+};
+
+// Ball shape priors for the decoder, taken from the tracker limits
+void applyBallPriors(YoloConfig& yolo_config, const tracking::TrackerConfig& tracker_config);
+
+// Detect -> associate -> track for a single stream (Topics 12-14)
+class BallPipeline {
+private:
+    YoloDetector& detector_;
+    tracking::KalmanTracker tracker_;
+    InputScaleController scale_controller_;
+    PipelineOptions options_;
+    
+    // Rim cache: the rim is static, so between refreshes it is served from
+    // cache and the decoder only scores the ball classes
+    Detection<> cached_rim_;
+    bool have_rim_;
+    int frames_since_rim_refresh_;
+    int frames_gated_;
+    
+    analysis::MakeMissJudge make_miss_;
+    bool burst_active_;
+    
+    tracking::PlayerTracker players_;
+    bool full_view_;                  // Last pass covered the whole frame
+    analysis::PossessionTracker possession_;
+    
+    // Previous frame's clock, for the tracker's frame interval
+    int64_t last_frame_index_;
+    double last_timestamp_ms_;
+    
+    // Ball classes plus the person class when players are tracked
+    ClassMask passMask(const ClassMask& classes) const;
+    
+    void compensateCameraMotion(const cv::Point2f& shift);
+    bool gateFrame(const analysis::MotionSummary* motion);
+    cv::Rect proposeRegion(const FrameContext& ctx, const analysis::MotionSummary* motion) const;
+    std::vector<Detection<>> detectObjects(const FrameContext& ctx, const io::YuvFrame* yuv,
+                                           const analysis::MotionSummary* motion,
+                                           const cv::Point2f& predicted);
+    std::vector<Detection<>> detectWithBurst(const FrameContext& ctx, const cv::Rect& roi,
+                                             const cv::Rect& burst);
+    const Detection<>* selectBall(const std::vector<Detection<>>& detections,
+                                  const cv::Point2f& predicted) const;
+    
+public:
+    BallPipeline(YoloDetector& detector,
+                 const tracking::TrackerConfig& tracker_config,
+                 const PipelineOptions& options = PipelineOptions());
+    
+    // Non-copyable (holds a tracker)
+    BallPipeline(const BallPipeline&) = delete;
+    BallPipeline& operator=(const BallPipeline&) = delete;
+    
+    // Process one frame; yuv (optional) lets the detector skip the BGR path,
+    // motion (optional) enables camera compensation, gating and ROI proposals
+    FrameResult process(const FrameContext& ctx, const io::YuvFrame* yuv = nullptr,
+                        const analysis::MotionSummary* motion = nullptr);
+    
+    // Forget all per-stream state (tracks, rim cache, possession) before an
+    // unrelated stretch of video; the detector and its warmed sizes are kept
+    void reset();
+    
+    const tracking::KalmanTracker& tracker() const { return tracker_; }
+    bool hasRim() const { return have_rim_; }
+    const Detection<>& rim() const { return cached_rim_; }
+    
+    // Square crop around a search region, at least min_size wide, clipped to the frame
+    static cv::Rect squareRegion(const cv::Rect2f& region, int min_size, const cv::Size& frame_size);
+    
+    // Burst crop for a ball predicted inside the rim zone (empty otherwise):
+    // side x side around the rim, shifted to stay inside the frame
+    static cv::Rect rimBurstRegion(const cv::Rect& rim, float zone_scale, const cv::Point2f& predicted,
+                                   int side, const cv::Size& frame_size);
+};
+
+} // namespace bbst::pipeline
@@ -0,0 +1,63 @@
+#pragma once
+#include "analysis/ShotEvents.hpp"
+#include "core/Trajectory.hpp"
+#include "pipeline/ArchiveProcessor.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+namespace bbst::pipeline {
+
+struct HighlightConfig {
+    int pre_frames = 45;              // Context before the launch
+    int post_frames = 45;             // Context after the landing
+    int workers = 0;                  // Clip workers, 0 = hardware concurrency
+    int trail_length = 50;            // Trajectory points drawn, as in live output
+    int fourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+    std::string extension = ".mp4";
+};
+
+// One output clip; shots whose clips would overlap share a clip
+struct HighlightClip {
+    int index = 0;
+    Segment range;                    // Frames [start, end) of the source video
+    std::vector<int> apex_frames;
+    std::string path;
+};
+
+// Renders short annotated clips around shots from an existing track, without
+// running detection again. Each worker owns a capture and seeks straight to
+// its clip, so only the frames inside clips are decoded.
+class HighlightRenderer {
+private:
+    std::string video_path_;
+    std::vector<FrameResult> track_;  // Sorted by frame index
+    HighlightConfig config_;
+    
+    // Index of the track row for a frame, or -1
+    int rowAt(int frame) const;
+    
+    // Trail ending at a row, as the live tracker would have held it
+    Trajectory trailAt(int row) const;
+    
+    void renderClip(cv::VideoCapture& cap, const HighlightClip& clip, double fps) const;
+
+public:
+    HighlightRenderer(const std::string& video_path, std::vector<FrameResult> track,
+                      const HighlightConfig& config = HighlightConfig());
+    
+    // Clip ranges around the events, clipped to the video, overlaps merged;
+    // files are "<output_dir>/<video stem>_shot<NN><extension>"
+    static std::vector<HighlightClip> planClips(const std::vector<analysis::ShotEvent>& events,
+                                                int total_frames,
+                                                const std::string& video_path,
+                                                const std::string& output_dir,
+                                                const HighlightConfig& config);
+    
+    // Renders every clip, clips spread over workers. Returns the clips written.
+    std::vector<HighlightClip> render(const std::vector<analysis::ShotEvent>& events,
+                                      const std::string& output_dir);
+};
+
+} // namespace bbst::pipeline
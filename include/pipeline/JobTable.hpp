@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bbst::pipeline {
+
+enum class JobState : uint32_t {
+    Pending = 0,
+    Claimed = 1,
+    Done = 2,
+    Failed = 3
+};
+
+// A contiguous frame range of one video
+struct JobSpec {
+    uint32_t video = 0;
+    int32_t start = 0;
+    int32_t end = 0;
+};
+
+// Proof of ownership handed out by claim(); every later state change is a
+// compare-and-swap against it, so a worker that lost its lease cannot
+// complete a job someone else has taken over
+struct JobClaim {
+    uint32_t index = 0;
+    JobSpec spec;
+    uint64_t token = 0;
+    bool stolen = false;        // Taken from another worker's shard
+    bool reclaimed = false;     // Taken over from a worker whose lease expired
+};
+
+struct JobCounts {
+    uint32_t pending = 0;
+    uint32_t claimed = 0;
+    uint32_t done = 0;
+    uint32_t failed = 0;
+};
+
+// Split videos into chunk_frames-long jobs, in video order
+std::vector<JobSpec> planChunks(const std::vector<int>& frame_counts, int chunk_frames);
+
+// Job table shared by many processes through a MAP_SHARED file mapping.
+// No coordinator process and no external service: every worker maps the same
+// file and moves jobs Pending -> Claimed -> Done/Failed with lock-free atomics.
+//
+// Jobs are split into contiguous shards, one per expected worker. A worker
+// takes jobs from the front of its home shard and, once that is empty,
+// steals from the back of the others. A claimed job carries a lease the
+// owner keeps renewing; when a process dies its lease runs out and the job
+// is reclaimed by whoever scans past it next. The lease deadline is part of
+// the claim word, so claiming and renewing are a single compare-and-swap;
+// it is kept in 32-bit milliseconds, which bounds a table's life to ~49 days.
+class JobTable {
+private:
+    struct Header;
+    struct Slot;
+    
+    int fd_;
+    void* base_;
+    size_t size_;
+    Header* header_;
+    Slot* slots_;
+    char* paths_;
+    uint32_t rank_;
+    
+    uint32_t shardBegin(uint32_t shard) const;
+    int64_t tableMs(int64_t now_ms) const;          // Milliseconds since the table was created
+    uint32_t leaseDeadline(int64_t now_ms) const;   // Lease end stored in the claim word
+    std::optional<JobClaim> tryClaim(uint32_t index, bool stolen, int64_t now_ms);
+
+public:
+    static constexpr size_t MAX_PATH_LENGTH = 512;
+    
+    // Create (or overwrite) the table file
+    static void create(const std::string& table_path,
+                       const std::vector<std::string>& videos,
+                       const std::vector<JobSpec>& jobs,
+                       uint32_t shards,
+                       int64_t lease_ms = 60000,
+                       uint32_t max_attempts = 3);
+    
+    // Map an existing table; each instance registers as a new worker rank
+    explicit JobTable(const std::string& table_path);
+    ~JobTable();
+    
+    // Non-copyable (owns the mapping)
+    JobTable(const JobTable&) = delete;
+    JobTable& operator=(const JobTable&) = delete;
+    
+    // Home shard first, then stealing; expired leases are reclaimed along
+    // the way. Empty when nothing is claimable right now.
+    std::optional<JobClaim> claim();
+    
+    // Extend the lease; false if the job was reclaimed by another worker
+    bool renew(JobClaim& claim);
+    
+    // False if the job was reclaimed in the meantime (discard the work)
+    bool complete(const JobClaim& claim);
+    bool fail(const JobClaim& claim);
+    
+    uint32_t rank() const { return rank_; }
+    uint32_t jobCount() const;
+    uint32_t videoCount() const;
+    uint32_t shardCount() const;
+    int64_t leaseMs() const;
+    std::string videoPath(uint32_t video) const;
+    JobSpec job(uint32_t index) const;
+    JobState state(uint32_t index) const;
+    JobCounts counts() const;
+    bool finished() const;  // Every job done or failed
+    
+    // Monotonic clock shared by all processes on the host
+    static int64_t nowMs();
+};
+
+} // namespace bbst::pipeline
@@ -0,0 +1,62 @@
+#pragma once
+#include "detectors/YoloDetector.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include "pipeline/JobTable.hpp"
+#include "tracking/KalmanTracker.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bbst::pipeline {
+
+// Multi-process archive reprocessing configuration
+struct ShardConfig {
+    int chunk_frames = 3000;            // Frames per job
+    int warmup_frames = 30;             // Tracked before a chunk starts, not emitted
+    int renew_interval_frames = 100;    // Lease heartbeat while processing
+    int64_t lease_ms = 60000;           // Silence after which a job is reclaimed
+    uint32_t max_attempts = 3;
+    uint32_t shards = 0;                // Expected worker processes (0 = core count)
+};
+
+// Scale-out over processes on one host, coordinated only through a shared
+// JobTable file:
+//   plan    - chunk the videos into jobs and write the table
+//   work    - run in any number of processes; claim, track and complete jobs
+//   reduce  - merge the per-job track files into one CSV per video,
+//             named <video index>-<stem>.csv
+// Workers stay alive until every job is done or failed, so jobs of a crashed
+// worker are picked up once their lease expires.
+class ShardProcessor {
+private:
+    std::string model_path_;
+    std::string names_path_;
+    YoloConfig yolo_config_;
+    tracking::TrackerConfig tracker_config_;
+    PipelineOptions pipeline_options_;
+    ShardConfig config_;
+    
+    bool processJob(JobTable& table, JobClaim& claim, YoloDetector& detector,
+                    cv::VideoCapture& cap, const std::string& table_path);
+
+public:
+    ShardProcessor(const std::string& model_path,
+                   const std::string& names_path,
+                   const YoloConfig& yolo_config,
+                   const tracking::TrackerConfig& tracker_config,
+                   const PipelineOptions& pipeline_options = PipelineOptions(),
+                   const ShardConfig& config = ShardConfig());
+    
+    // Returns the number of jobs created
+    size_t plan(const std::string& table_path, const std::vector<std::string>& videos) const;
+    
+    // Returns the number of jobs this process completed
+    int work(const std::string& table_path);
+    
+    // Returns the number of jobs without output (failed or unfinished)
+    static int reduce(const std::string& table_path, const std::string& output_dir);
+    
+    static std::string jobOutputPath(const std::string& table_path, uint32_t index);
+};
+
+} // namespace bbst::pipeline
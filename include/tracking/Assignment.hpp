@@ -0,0 +1,27 @@
+#pragma once
+#include <vector>
+
+namespace bbst::tracking {
+
+// Minimum-cost assignment of rows to columns (Hungarian algorithm with
+// potentials, O(n^2 m)). cost is rows x cols, row-major. Pairs costing
+// max_cost or more are never assigned. Returns the column of each row, -1
+// for rows left unassigned, valid until the next call. The result and the
+// scratch buffers live in the solver, so per-frame calls do not allocate
+// once warm.
+class AssignmentSolver {
+private:
+    std::vector<double> a_;             // Padded square problem, 1-based
+    std::vector<double> u_;
+    std::vector<double> v_;
+    std::vector<double> min_slack_;
+    std::vector<int> match_;
+    std::vector<int> way_;
+    std::vector<char> used_;
+    std::vector<int> result_;
+
+public:
+    const std::vector<int>& solve(const std::vector<float>& cost, int rows, int cols, float max_cost);
+};
+
+} // namespace bbst::tracking
@@ -9,13 +9,37 @@ namespace bbst::tracking {
 
 // Configuration for tracker (Topic 12, 35)
 struct TrackerConfig {
-    float max_velocity = 70.0f;
+    float max_velocity = 70.0f;         // Also the initial velocity uncertainty (px/frame)
     float min_ball_size = 5.0f;
     float max_ball_size = 120.0f;
     float min_aspect_ratio = 0.3f;
     float max_aspect_ratio = 3.0f;
     int max_frames_without_detection = 40;
     size_t max_trajectory_length = 50;
+    
+    // Noise model in pixel units, used for covariance gating
+    float measurement_noise = 3.0f;     // Detection center std-dev (px)
+    float process_noise = 10.0f;        // Acceleration std-dev (px/frame^2)
+    float gate_chi2 = 9.21f;            // Mahalanobis gate (99% for 2 dof)
+    
+    // Real-unit kinematics: a fixed image scale, or the real ball diameter to
+    // take the scale from the ball's apparent size (0 = uncalibrated)
+    float meters_per_pixel = 0.0f;
+    float ball_diameter_m = 0.0f;
+};
+
+// Derived motion of a track, maintained per frame from the filter state
+struct Kinematics {
+    float speed = 0.0f;                 // px/s
+    float acceleration = 0.0f;          // px/s^2, smoothed over a few frames
+    float curvature = 0.0f;             // 1/px, signed: > 0 turns clockwise on screen
+    float flight_time = 0.0f;           // s since the track started
+    float path_length = 0.0f;           // px travelled along the trajectory
+    float meters_per_pixel = 0.0f;      // 0 when uncalibrated
+    
+    bool calibrated() const { return meters_per_pixel > 0.0f; }
+    float speedMps() const { return speed * meters_per_pixel; }
+    float accelerationMps2() const { return acceleration * meters_per_pixel; }
 };
 
 // Full Kalman-based ball tracker (Topics 12-14, 21)
@@ -31,6 +55,15 @@ private:
     float last_size_;
     int consecutive_good_detections_;
     int total_detections_;
+    bool predicted_;                    // predict() ran since the last update
+    cv::Point2f predicted_position_;
+    
+    // Kinematics state: O(1) per frame, no trajectory rescans
+    Kinematics kinematics_;
+    float frame_interval_s_;
+    int track_frames_;
+    cv::Point2f last_velocity_;         // px/frame
+    cv::Point2f acceleration_;          // px/frame^2, smoothed
     
     // Configuration
     TrackerConfig config_;
@@ -39,8 +72,10 @@ private:
     void initKalmanFilter();
     bool validateSize(float size) const;
     bool validateAspectRatio(float width, float height) const;
-    bool validateVelocity(const cv::Point2f& new_point, const cv::Point2f& predicted) const;
-    
+    bool validateVelocity(const cv::Point2f& new_point) const;
+    void ensurePredicted();
+    void updateKinematics();
+
 public:
     // Constructor (Topic 13)
     explicit KalmanTracker(const TrackerConfig& config = TrackerConfig());
@@ -58,18 +93,39 @@ public:
     
     // Main interface
     void init(const cv::Point2f& initial_point, float size);
-    cv::Point2f predict();
+    cv::Point2f predict();              // Advances once per frame; repeat calls return the same point
     bool isValidDetection(const cv::Point2f& point, float size, bool strict = false) const;
     cv::Point2f update(const cv::Point2f& measurement_point, float size);
     cv::Point2f updateWithoutMeasurement();
     
+    // Shift the track by the camera's pan/tilt (call before predict()); the
+    // ball's velocity relative to the court is unchanged
+    void compensateCameraMotion(const cv::Point2f& shift);
+    
+    // Covariance-driven gating (valid after predict())
+    cv::Matx22f getInnovationCovariance() const;
+    float mahalanobisDistance(const cv::Point2f& point) const;  // Squared
+    bool inGate(const cv::Point2f& point) const;
+    cv::Point2f getPredictedPosition() const { return predicted_position_; }
+    
+    // Bounding box of the gate ellipse, padded by the ball size. Confident
+    // tracks get small regions, uncertain ones widen automatically.
+    cv::Rect2f getSearchRegion() const;
+    
     // Getters (const methods - Topic 19)
     const Trajectory& getTrajectory() const { return trajectory_; }
     bool isActive() const;
     bool isStable() const;
     cv::Point2f getLastPosition() const { return last_position_; }
+    float getLastSize() const { return last_size_; }
     int getTotalDetections() const { return total_detections_; }
     
+    // Valid while the track is active
+    const Kinematics& getKinematics() const { return kinematics_; }
+    
+    // Seconds between frames, for per-second kinematics (default 1/30)
+    void setFrameInterval(float seconds);
+    
     // Reset
     void reset();
 };
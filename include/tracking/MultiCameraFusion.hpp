@@ -0,0 +1,153 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace bbst::tracking {
+
+// Result of triangulating one ball position from several views
+struct Triangulation {
+    bool valid = false;
+    cv::Point3d point;                  // World coordinates (court frame)
+    double reprojection_px = 0.0;       // RMS over the views used
+    int views = 0;
+    uint32_t view_mask = 0;             // Bit i set when view i was used
+};
+
+// Linear (DLT) triangulation refined by Gauss-Newton on the reprojection
+// error. Works on fixed-size 4x4 and 3x3 systems, so the cost is a few
+// microseconds regardless of the number of views. With three or more views,
+// the worst one is dropped while the RMS error exceeds max_reprojection_px.
+Triangulation triangulate(const cv::Matx34d* projections, const cv::Point2f* points, int count,
+                          double max_reprojection_px = 1e9);
+
+// Fundamental matrix mapping points in view 1 to epipolar lines in view 2
+cv::Matx33d fundamentalFromProjections(const cv::Matx34d& p1, const cv::Matx34d& p2);
+
+// Symmetric epipolar distance (px) of a correspondence under F
+double epipolarDistance(const cv::Matx33d& f, const cv::Point2f& x1, const cv::Point2f& x2);
+
+// Constant-acceleration-under-gravity Kalman filter for the 3D ball,
+// state [x y z vx vy vz]; units follow the calibration (meters, seconds)
+class BallKalman3D {
+private:
+    cv::Matx<double, 6, 1> x_;
+    cv::Matx<double, 6, 6> p_;
+    cv::Vec3d gravity_;
+    double process_noise_;              // White acceleration std-dev
+    double measurement_noise_;          // Triangulated position std-dev
+    bool initialized_;
+
+public:
+    BallKalman3D(const cv::Vec3d& gravity, double process_noise, double measurement_noise);
+    
+    void init(const cv::Point3d& position, double max_speed);
+    void predict(double dt);
+    
+    // Squared Mahalanobis distance of a measurement (after predict())
+    double mahalanobis(const cv::Point3d& measurement) const;
+    void update(const cv::Point3d& measurement);
+    
+    bool initialized() const { return initialized_; }
+    void reset() { initialized_ = false; }
+    cv::Point3d position() const { return cv::Point3d(x_(0), x_(1), x_(2)); }
+    cv::Vec3d velocity() const { return cv::Vec3d(x_(3), x_(4), x_(5)); }
+};
+
+struct FusionConfig {
+    double max_interp_gap_ms = 80.0;    // Samples further apart are not interpolated
+    double max_extrapolate_ms = 20.0;   // Lead over a camera's newest sample (its next frame is late)
+    double max_offset_ms = 250.0;       // Clock offset search range (either sign)
+    double offset_step_ms = 2.0;
+    int offset_interval = 15;           // Fused frames between offset estimates (one camera each)
+    int offset_min_samples = 20;        // Matched samples needed for an estimate
+    double offset_smoothing = 0.3;      // Weight of a new estimate
+    double max_reprojection_px = 6.0;
+    double max_speed = 20.0;            // Initial velocity uncertainty (m/s)
+    double process_noise = 3.0;         // White acceleration std-dev (m/s^2)
+    double measurement_noise = 0.05;    // Triangulation std-dev (m)
+    double gate_chi2 = 11.34;           // Mahalanobis gate (99% for 3 dof)
+    int max_missed = 10;                // Fused frames without a measurement before reset
+    cv::Vec3d gravity = cv::Vec3d(0.0, 0.0, -9.81);
+};
+
+// Fused ball state at one instant of the reference clock
+struct FusedBall {
+    bool valid = false;                 // Filter is tracking
+    bool measured = false;              // A triangulation was used this frame
+    double timestamp_ms = 0.0;
+    cv::Point3d position;
+    cv::Vec3d velocity;
+    int views = 0;
+    double reprojection_px = 0.0;
+};
+
+// Fuses per-camera 2D ball tracks from calibrated cameras into one 3D track.
+//
+// Cameras are not genlocked: each reports observations on its own clock.
+// Camera 0 is the reference; every other camera has a clock offset
+// (its clock minus the reference), estimated online by sliding its track in
+// time against camera 0's until the epipolar residual is smallest. At a
+// fusion instant every camera's track is interpolated to that instant,
+// triangulated, and fed to a 3D Kalman filter.
+//
+// All state lives in fixed-size arrays (at most MAX_CAMERAS cameras, HISTORY
+// samples each), so fusing costs the same every frame and never allocates.
+class MultiCameraFusion {
+public:
+    static constexpr int MAX_CAMERAS = 8;
+    static constexpr int HISTORY = 128;
+
+private:
+    struct Sample {
+        double time_ms = 0.0;           // Camera clock
+        cv::Point2f point;
+    };
+    
+    struct Camera {
+        cv::Matx34d projection;
+        cv::Matx33d fundamental;        // From camera 0 to this camera
+        std::array<Sample, HISTORY> ring;
+        int head = 0;                   // Next slot to write
+        int count = 0;
+        double offset_ms = 0.0;
+        bool offset_known = false;
+    };
+    
+    std::array<Camera, MAX_CAMERAS> cameras_;
+    int num_cameras_;
+    FusionConfig config_;
+    BallKalman3D filter_;
+    double last_time_ms_;
+    int missed_;
+    int frames_;
+    int next_offset_camera_;
+    
+    const Sample& sample(const Camera& camera, int age) const;
+    bool interpolate(const Camera& camera, double time_ms, bool extrapolate,
+                     cv::Point2f& point) const;
+
+public:
+    // Two to MAX_CAMERAS projection matrices; camera 0 is the reference clock
+    explicit MultiCameraFusion(const std::vector<cv::Matx34d>& projections,
+                               const FusionConfig& config = FusionConfig());
+    
+    // 2D ball center seen by a camera, timestamped on that camera's clock.
+    // Timestamps must increase per camera.
+    void addObservation(int camera, double timestamp_ms, const cv::Point2f& point);
+    
+    // Fused state at a reference-clock instant; call with increasing times
+    FusedBall fuse(double timestamp_ms);
+    
+    // Estimate a camera's clock offset from the buffered tracks; false when
+    // there is too little overlap with camera 0
+    bool estimateClockOffset(int camera, double& offset_ms) const;
+    
+    double clockOffsetMs(int camera) const { return cameras_[camera].offset_ms; }
+    void setClockOffsetMs(int camera, double offset_ms);
+    
+    int cameraCount() const { return num_cameras_; }
+};
+
+} // namespace bbst::tracking
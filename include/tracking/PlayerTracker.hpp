@@ -0,0 +1,77 @@
+#pragma once
+#include "core/IDetector.hpp"
+#include "tracking/Assignment.hpp"
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <vector>
+
+namespace bbst::tracking {
+
+// Jersey colour signature: 8 hues x 3 saturations for coloured pixels plus
+// 8 brightness bins for white/grey/black ones, L1-normalized
+using Appearance = std::array<float, 32>;
+
+struct PlayerTrackerConfig {
+    float min_iou = 0.1f;               // Predicted box overlap needed to match
+    float appearance_weight = 0.6f;     // Cost = (1 - IoU) + weight * appearance distance
+    float max_cost = 1.3f;
+    float appearance_rate = 0.1f;       // Update rate of a track's cached appearance
+    float position_gain = 0.7f;         // Alpha-beta filter on the box center
+    float velocity_gain = 0.3f;
+    int min_hits = 3;                   // Matches before a track is reported
+    int max_misses = 15;                // Frames a track survives without a match
+};
+
+struct PlayerTrack {
+    int id = 0;
+    cv::Rect2f box;
+    cv::Point2f velocity;               // Box center, px/frame
+    Appearance appearance{};
+    int hits = 0;
+    int misses = 0;                     // Consecutive frames without a match
+};
+
+// Multi-player tracker: constant-velocity boxes, association by IoU plus
+// appearance through a global assignment, so crossing players keep their ids.
+// Appearance is a colour histogram sampled on the torso of each box, about
+// 150 pixels per crop, and cached per track.
+class PlayerTracker {
+private:
+    PlayerTrackerConfig config_;
+    std::vector<PlayerTrack> tracks_;
+    int next_id_;
+    
+    // Per-frame scratch, reused
+    std::vector<const Detection<>*> people_;
+    std::vector<Appearance> appearances_;
+    std::vector<float> cost_;
+    std::vector<char> claimed_;
+    AssignmentSolver solver_;
+    std::vector<PlayerTrack> confirmed_;
+    
+    void predict();
+    void refreshConfirmed();
+
+public:
+    explicit PlayerTracker(const PlayerTrackerConfig& config = PlayerTrackerConfig());
+    
+    // One frame of detections; only those of person_class are used
+    void update(const cv::Mat& frame, const std::vector<Detection<>>& detections, int person_class);
+    
+    // Advance the tracks on a frame whose pass did not look for players
+    // (gated or cropped); nobody is counted as missed
+    void coast();
+    
+    // Tracks with at least min_hits matches, as of the last update or coast
+    const std::vector<PlayerTrack>& confirmed() const { return confirmed_; }
+    const std::vector<PlayerTrack>& tracks() const { return tracks_; }
+    
+    static Appearance appearance(const cv::Mat& bgr, const cv::Rect& box);
+    
+    // Hellinger distance in [0, 1]
+    static float appearanceDistance(const Appearance& a, const Appearance& b);
+    
+    static float iou(const cv::Rect2f& a, const cv::Rect2f& b);
+};
+
+} // namespace bbst::tracking
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace bbst::util {
+
+struct BufferPoolConfig {
+    size_t min_bytes = 256 * 1024;              // Smaller buffers are left to malloc
+    size_t max_cached_bytes = 512 * 1024 * 1024; // Idle memory kept for reuse
+    bool huge_pages = false;                    // Classes >= 2 MB on hugetlbfs pages, else THP
+};
+
+struct BufferPoolStats {
+    uint64_t hits = 0;          // Served from the free lists
+    uint64_t misses = 0;        // Freshly mapped
+    size_t cached_bytes = 0;    // Idle, waiting for reuse
+    size_t mapped_bytes = 0;    // In use + cached
+};
+
+// Size-class pool of large page-backed buffers.
+//
+// Frame-sized buffers are requested and dropped every frame; glibc serves
+// them with mmap/munmap, so each one costs a syscall pair plus a page fault
+// per 4 KiB page on first touch. Here they are kept on per-class free lists
+// and handed out again already faulted in. Classes are four steps per power
+// of two, so 1080p BGR frames, NV12 frames and DNN blobs each settle into
+// their own class with at most 25% slack.
+class BufferPool {
+private:
+    BufferPoolConfig config_;
+    std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_lists_;
+    BufferPoolStats stats_;
+    
+    void* map(size_t bytes);
+
+public:
+    explicit BufferPool(const BufferPoolConfig& config = BufferPoolConfig());
+    ~BufferPool();
+    
+    // Non-copyable (owns the mappings)
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    
+    // Whether a request of this size goes through the pool
+    bool pooled(size_t bytes) const { return bytes >= config_.min_bytes; }
+    
+    // Capacity actually reserved for a request of this size
+    size_t sizeClass(size_t bytes) const;
+    
+    // Page-aligned buffer of at least `bytes`; throws std::bad_alloc.
+    // Only for pooled() sizes.
+    void* acquire(size_t bytes);
+    
+    // `bytes` must be the size passed to acquire()
+    void release(void* buffer, size_t bytes);
+    
+    // Unmap every idle buffer
+    void trim();
+    
+    BufferPoolStats stats();
+    const BufferPoolConfig& getConfig() const { return config_; }
+};
+
+} // namespace bbst::util
@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bbst::util {
+
+// Energy used since EnergyMeter::start()
+struct EnergySample {
+    bool valid = false;             // RAPL was readable
+    double package_joules = 0.0;    // All CPU packages (cores, caches, iGPU)
+    double dram_joules = 0.0;       // 0 where the platform has no DRAM domain
+    double seconds = 0.0;
+    
+    double totalJoules() const { return package_joules + dram_joules; }
+    double watts() const { return seconds > 0.0 ? totalJoules() / seconds : 0.0; }
+};
+
+// Package and DRAM energy from the Linux powercap RAPL counters
+// (/sys/class/powercap/intel-rapl:*/energy_uj; the AMD driver uses the same
+// interface). The counters are machine-wide, so other load on the box is
+// included. energy_uj is root-only on most current kernels: without access
+// the meter reports itself unavailable and every sample is invalid.
+class EnergyMeter {
+private:
+    struct Domain {
+        std::string energy_path;
+        bool dram = false;
+        uint64_t max_range_uj = 0;  // Counter wraps after this
+        uint64_t last_uj = 0;
+        uint64_t accumulated_uj = 0;
+    };
+    
+    std::vector<Domain> domains_;
+    std::chrono::steady_clock::time_point start_time_;
+    
+    static bool readCounter(const std::string& path, uint64_t& value);
+
+public:
+    explicit EnergyMeter(const std::string& powercap_root = "/sys/class/powercap");
+    
+    bool available() const { return !domains_.empty(); }
+    size_t domainCount() const { return domains_.size(); }
+    
+    // Zero the totals
+    void start();
+    
+    // Fold in counter progress. Counters wrap every few tens of minutes
+    // under load, so call this at least every few minutes on long runs.
+    void update();
+    
+    // update(), then the totals since start()
+    EnergySample read();
+};
+
+// "12.4 J (package 10.1 J, DRAM 2.3 J), 0.041 J/frame, 35.2 W" or "unavailable"
+std::string formatEnergy(const EnergySample& sample, int frames);
+
+} // namespace bbst::util
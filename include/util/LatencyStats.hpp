@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bbst::util {
+
+// Distribution of end-to-end latencies, in microseconds
+class LatencyStats {
+private:
+    std::vector<int64_t> samples_;
+    int64_t sum_ = 0;
+
+public:
+    void record(int64_t latency_us);
+    
+    size_t count() const { return samples_.size(); }
+    double meanMs() const;
+    
+    // p in [0, 1]; nearest-rank, 0 when empty
+    double percentileMs(double p) const;
+    double maxMs() const;
+    
+    // "n=600 mean 41.2 p50 40.8 p90 45.1 p99 61.0 max 75.3 ms"
+    std::string summary() const;
+};
+
+} // namespace bbst::util
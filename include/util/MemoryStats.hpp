@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+namespace bbst::util {
+
+// Subsystems memory is attributed to
+enum class MemTag : uint8_t {
+    Other = 0,
+    Decode,
+    Dnn,
+    Render,
+    Tracking,
+    Count
+};
+
+const char* memTagName(MemTag tag);
+
+struct TagStats {
+    int64_t live_bytes = 0;
+    int64_t peak_bytes = 0;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+};
+
+// Process-wide per-subsystem counters. Updates are a few relaxed atomic
+// operations on a cache line of their own, cheap enough to stay enabled.
+class MemoryStats {
+public:
+    static void recordAllocation(MemTag tag, size_t bytes);
+    static void recordFree(MemTag tag, size_t bytes);
+    
+    static TagStats snapshot(MemTag tag);
+    static void reset();
+    
+    // Tag applied to untagged allocations (cv::Mat) on the calling thread
+    static MemTag currentTag();
+    static void setCurrentTag(MemTag tag);
+    
+    // Resident set size from /proc/self/statm; 0 if unavailable
+    static int64_t residentBytes();
+    
+    // One line per subsystem plus RSS
+    static void report(std::ostream& os);
+};
+
+// Attributes allocations made in this scope to a subsystem
+class MemoryScope {
+private:
+    MemTag previous_;
+
+public:
+    explicit MemoryScope(MemTag tag) : previous_(MemoryStats::currentTag()) {
+        MemoryStats::setCurrentTag(tag);
+    }
+    ~MemoryScope() { MemoryStats::setCurrentTag(previous_); }
+    
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+};
+
+// std::pmr resource that counts everything it hands out against one tag
+class CountingResource : public std::pmr::memory_resource {
+private:
+    MemTag tag_;
+    std::pmr::memory_resource* upstream_;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit CountingResource(MemTag tag,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : tag_(tag), upstream_(upstream) {}
+    
+    MemTag tag() const { return tag_; }
+};
+
+// Shared counting resource per tag (lives for the whole process)
+std::pmr::memory_resource* taggedResource(MemTag tag);
+
+// Prints MemoryStats::report every interval and once more when destroyed
+class MemoryReporter {
+private:
+    std::chrono::milliseconds interval_;
+    std::ostream& out_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread thread_;
+    
+    void run();
+
+public:
+    explicit MemoryReporter(std::chrono::milliseconds interval, std::ostream& out = std::cout);
+    ~MemoryReporter();
+    
+    MemoryReporter(const MemoryReporter&) = delete;
+    MemoryReporter& operator=(const MemoryReporter&) = delete;
+};
+
+} // namespace bbst::util
@@ -0,0 +1,31 @@
+#pragma once
+#include "util/BufferPool.hpp"
+#include <opencv2/core.hpp>
+
+namespace bbst::util {
+
+// cv::MatAllocator that recycles large Mat buffers (frames, blobs, network
+// outputs, clones) through a BufferPool. Small Mats go to cv::fastMalloc
+// as with OpenCV's own allocator.
+class PooledMatAllocator : public cv::MatAllocator {
+private:
+    mutable BufferPool pool_;
+
+public:
+    explicit PooledMatAllocator(const BufferPoolConfig& config = BufferPoolConfig());
+    
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                           size_t* step, cv::AccessFlag flags,
+                           cv::UMatUsageFlags usage) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag access,
+                  cv::UMatUsageFlags usage) const override;
+    void deallocate(cv::UMatData* data) const override;
+    
+    BufferPoolStats stats() const { return pool_.stats(); }
+    
+    // Make a process-wide instance the default for all Mats created from
+    // now on; the first call's config wins
+    static PooledMatAllocator& install(const BufferPoolConfig& config = BufferPoolConfig());
+};
+
+} // namespace bbst::util
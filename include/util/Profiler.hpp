@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace bbst::util {
+
+struct ProfilerConfig {
+    int frequency_hz = 997;                     // Per-thread CPU-time sampling rate
+    std::string output_path = "profile.folded";
+    bool zone_frames = true;                    // Prefix stacks with the active zone
+};
+
+// In-process sampling profiler for when perf is not available.
+//
+// Every registered thread gets a CLOCK_THREAD_CPUTIME_ID timer that delivers
+// SIGPROF to that thread. The handler records the call stack into the
+// thread's single-producer ring buffer (no locks, no allocation). A collector
+// thread drains the rings into aggregated stacks; stop() symbolizes them and
+// writes folded stacks ("root;...;leaf count" lines) for flamegraph.pl or
+// speedscope.
+//
+// Symbol names for the executable's own functions need -rdynamic.
+class SamplingProfiler {
+public:
+    // Starts sampling the calling thread; false if already running
+    static bool start(const ProfilerConfig& config = ProfilerConfig());
+    
+    // Stops all timers and writes the output file
+    static void stop();
+    
+    static bool running();
+    
+    // Threads started while the profiler runs opt in with this (or ProfiledThread)
+    static void registerThread();
+    static void unregisterThread();
+    
+    // Interned zone id for a stage name (stable for the process lifetime)
+    static uint16_t zoneId(const char* name);
+    
+    // Zone active on the calling thread; 0 = none
+    static uint16_t currentZone();
+    static void setCurrentZone(uint16_t zone);
+};
+
+// Tags samples taken in this scope with a pipeline stage
+class ProfileZone {
+private:
+    uint16_t previous_;
+
+public:
+    explicit ProfileZone(uint16_t zone)
+        : previous_(SamplingProfiler::currentZone()) {
+        SamplingProfiler::setCurrentZone(zone);
+    }
+    ~ProfileZone() { SamplingProfiler::setCurrentZone(previous_); }
+    
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+// RAII thread registration for worker threads
+class ProfiledThread {
+public:
+    ProfiledThread() { SamplingProfiler::registerThread(); }
+    ~ProfiledThread() { SamplingProfiler::unregisterThread(); }
+    
+    ProfiledThread(const ProfiledThread&) = delete;
+    ProfiledThread& operator=(const ProfiledThread&) = delete;
+};
+
+} // namespace bbst::util
+
+#define BBST_PROFILE_CONCAT_(a, b) a##b
+#define BBST_PROFILE_CONCAT(a, b) BBST_PROFILE_CONCAT_(a, b)
+
+// Zone for the rest of the enclosing scope; the name is interned once per call site
+#define BBST_PROFILE_ZONE(name)                                                        \
+    static const uint16_t BBST_PROFILE_CONCAT(bbst_zone_id_, __LINE__) =              \
+        ::bbst::util::SamplingProfiler::zoneId(name);                                 \
+    ::bbst::util::ProfileZone BBST_PROFILE_CONCAT(bbst_zone_, __LINE__)(              \
+        BBST_PROFILE_CONCAT(bbst_zone_id_, __LINE__))
@@ -0,0 +1,31 @@
+#pragma once
+#include "util/MemoryStats.hpp"
+#include <opencv2/core.hpp>
+
+namespace bbst::util {
+
+// cv::MatAllocator that charges every Mat buffer to the MemoryScope active
+// on the allocating thread. Storage comes from a delegate allocator (OpenCV's
+// standard one or the buffer pool); the tag travels with the buffer, so a
+// Mat released elsewhere is still credited back to the subsystem that
+// created it.
+class TaggingMatAllocator : public cv::MatAllocator {
+private:
+    const cv::MatAllocator* delegate_;
+
+public:
+    explicit TaggingMatAllocator(const cv::MatAllocator* delegate = cv::Mat::getStdAllocator());
+    
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                           size_t* step, cv::AccessFlag flags,
+                           cv::UMatUsageFlags usage) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag access,
+                  cv::UMatUsageFlags usage) const override;
+    void deallocate(cv::UMatData* data) const override;
+    
+    // Make it the default for all Mats created from now on, wrapping the
+    // current default allocator (idempotent)
+    static void install();
+};
+
+} // namespace bbst::util
@@ -0,0 +1,24 @@
+#pragma once
+#include "io/FrameSource.hpp"
+#include <opencv2/opencv.hpp>
+
+namespace bbst::util {
+
+// Fused 4:2:0 -> normalized planar RGB conversion at network input size.
+//
+// Replaces decoder YUV->BGR, then blobFromImage's resize + swapRB + float
+// conversion with a single pass: rows are bilinearly resampled straight from
+// the Y/UV planes and converted with BT.601 (the same coefficients used by
+// cv::COLOR_YUV2BGR_NV12). Output planes are ordered R, G, B.
+class YuvToTensor {
+public:
+    // Writes 3 * dst_size.area() floats into dst
+    static void convert(const io::YuvFrame& src, cv::Size dst_size,
+                        float* dst, float scale = 1.0f / 255.0f);
+
+    // Convenience wrapper returning a 1x3xHxW CV_32F blob
+    static cv::Mat toBlob(const io::YuvFrame& src, cv::Size dst_size,
+                          float scale = 1.0f / 255.0f);
+};
+
+} // namespace bbst::util
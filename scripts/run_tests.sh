@@ -23,4 +23,67 @@ echo "Running tracker tests..."
 echo "Running trajectory tests..."
 ./test_trajectory
 
+echo "Running frame context tests..."
+./test_frame_context
+
+echo "Running YUV tensor tests..."
+./test_yuv_tensor
+
+echo "Running input scale tests..."
+./test_input_scale
+
+echo "Running motion cue tests..."
+./test_motion_cues
+
+echo "Running ingest tests..."
+./test_ingest
+
+echo "Running job table tests..."
+./test_job_table
+
+echo "Running heatmap detector tests..."
+./test_heatmap
+
+echo "Running possession tests..."
+./test_possession
+
+echo "Running player tracking tests..."
+./test_players
+
+echo "Running make/miss tests..."
+./test_make_miss
+
+echo "Running court zone tests..."
+./test_court_zones
+
+echo "Running fusion tests..."
+./test_fusion
+
+echo "Running highlight tests..."
+./test_highlights
+
+echo "Running segmented writer tests..."
+./test_segmented_writer
+
+echo "Running overlay sidecar tests..."
+./test_overlay_sidecar
+
+echo "Running buffer pool tests..."
+./test_buffer_pool
+
+echo "Running latency tests..."
+./test_latency
+
+echo "Running energy meter tests..."
+./test_energy_meter
+
+echo "Running memory stats tests..."
+./test_memory_stats
+
+echo "Running profiler tests..."
+./test_profiler
+
+echo "Running archive tests..."
+./test_archive
+
 echo "All tests completed!"
\ No newline at end of file
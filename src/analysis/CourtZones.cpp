@@ -0,0 +1,179 @@
+#include "analysis/CourtZones.hpp"
+#include <cmath>
+#include <sstream>
+
+namespace bbst::analysis {
+
+const char* courtZoneName(CourtZone zone) {
+    switch (zone) {
+        case CourtZone::Unknown: return "Unknown";
+        case CourtZone::OutOfBounds: return "OutOfBounds";
+        case CourtZone::RestrictedArea: return "RestrictedArea";
+        case CourtZone::Paint: return "Paint";
+        case CourtZone::MidRange: return "MidRange";
+        case CourtZone::LeftCornerThree: return "LeftCornerThree";
+        case CourtZone::RightCornerThree: return "RightCornerThree";
+        case CourtZone::AboveBreakThree: return "AboveBreakThree";
+        case CourtZone::Count: break;
+    }
+    return "Unknown";
+}
+
+CourtZone CourtTemplate::classify(const cv::Point2f& court_m) const {
+    double x = court_m.x;
+    double y = court_m.y;
+    if (x < 0.0 || x > length || y < 0.0 || y > width) return CourtZone::OutOfBounds;
+    
+    // Rotate the far half onto the near one; left and right are preserved
+    if (x > length / 2.0) {
+        x = length - x;
+        y = width - y;
+    }
+    
+    const double dx = x - basket_offset;
+    const double dy = y - width / 2.0;
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    if (distance <= restricted_radius) return CourtZone::RestrictedArea;
+    if (x <= lane_length && std::abs(dy) <= lane_width / 2.0) return CourtZone::Paint;
+    
+    // Straight corner lines up to where they meet the arc
+    const double corner_end = basket_offset +
+        std::sqrt(three_radius * three_radius - corner_three * corner_three);
+    if (x <= corner_end) {
+        if (std::abs(dy) >= corner_three) {
+            // Facing the basket at the near baseline, -y is on the left
+            return dy < 0.0 ? CourtZone::LeftCornerThree : CourtZone::RightCornerThree;
+        }
+    } else if (distance >= three_radius) {
+        return CourtZone::AboveBreakThree;
+    }
+    return CourtZone::MidRange;
+}
+
+// CourtZoneMap
+
+CourtZoneMap::CourtZoneMap(cv::Mat zones, const cv::Matx23f& to_cell, const cv::Matx33d& to_court)
+    : zones_(std::move(zones))
+    , to_cell_(to_cell)
+    , to_court_(to_court)
+{
+}
+
+CourtZoneMap CourtZoneMap::court(const CourtTemplate& court, double cell_m) {
+    const int cols = static_cast<int>(std::ceil(court.length / cell_m));
+    const int rows = static_cast<int>(std::ceil(court.width / cell_m));
+    cv::Mat zones(rows, cols, CV_8U);
+    for (int r = 0; r < rows; ++r) {
+        uint8_t* row = zones.ptr<uint8_t>(r);
+        for (int c = 0; c < cols; ++c) {
+            cv::Point2f center(static_cast<float>((c + 0.5) * cell_m),
+                               static_cast<float>((r + 0.5) * cell_m));
+            row[c] = static_cast<uint8_t>(court.classify(center));
+        }
+    }
+    
+    const float scale = static_cast<float>(1.0 / cell_m);
+    cv::Matx23f to_cell(scale, 0.0f, -0.5f,
+                        0.0f, scale, -0.5f);
+    return CourtZoneMap(zones, to_cell, cv::Matx33d::eye());
+}
+
+CourtZoneMap CourtZoneMap::image(const cv::Matx33d& image_to_court, cv::Size image_size,
+                                 const CourtTemplate& court, double cell_m) {
+    CourtZoneMap court_map = CourtZoneMap::court(court, cell_m);
+    
+    // Pixel -> court meters -> court cell centers, sampled nearest
+    cv::Matx33d to_cell(1.0 / cell_m, 0.0, -0.5,
+                        0.0, 1.0 / cell_m, -0.5,
+                        0.0, 0.0, 1.0);
+    cv::Matx33d pixel_to_cell = to_cell * image_to_court;
+    cv::Mat zones;
+    cv::warpPerspective(court_map.zones_, zones, cv::Mat(pixel_to_cell), image_size,
+                        cv::INTER_NEAREST | cv::WARP_INVERSE_MAP, cv::BORDER_CONSTANT,
+                        cv::Scalar(static_cast<int>(CourtZone::OutOfBounds)));
+    
+    // Pixels beyond the horizon map through negative w onto the court mirrored;
+    // the court center's side of the horizon is the valid one
+    cv::Vec3d center = image_to_court.inv() * cv::Vec3d(court.length / 2.0, court.width / 2.0, 1.0);
+    const double sign = center[2] >= 0.0 ? 1.0 : -1.0;
+    const double wx = image_to_court(2, 0) * sign;
+    const double wy = image_to_court(2, 1) * sign;
+    const double w0 = image_to_court(2, 2) * sign;
+    for (int r = 0; r < zones.rows; ++r) {
+        uint8_t* row = zones.ptr<uint8_t>(r);
+        for (int c = 0; c < zones.cols; ++c) {
+            if (wx * c + wy * r + w0 <= 0.0) row[c] = static_cast<uint8_t>(CourtZone::OutOfBounds);
+        }
+    }
+    
+    cv::Matx23f identity(1.0f, 0.0f, 0.0f,
+                         0.0f, 1.0f, 0.0f);
+    return CourtZoneMap(zones, identity, image_to_court);
+}
+
+void CourtZoneMap::classify(const std::vector<cv::Point2f>& points,
+                            std::vector<CourtZone>& zones) const {
+    zones.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        zones[i] = at(points[i]);
+    }
+}
+
+cv::Point2f CourtZoneMap::toCourt(const cv::Point2f& point) const {
+    cv::Vec3d p = to_court_ * cv::Vec3d(point.x, point.y, 1.0);
+    if (std::abs(p[2]) < 1e-12) return cv::Point2f(-1.0f, -1.0f);
+    return cv::Point2f(static_cast<float>(p[0] / p[2]), static_cast<float>(p[1] / p[2]));
+}
+
+// ShotChart
+
+void ShotChart::add(CourtZone zone, const cv::Point2f& court_point) {
+    attempts[static_cast<size_t>(zone)]++;
+    if (zone != CourtZone::Unknown && zone != CourtZone::OutOfBounds) {
+        court_points.push_back(court_point);
+    }
+}
+
+std::string ShotChart::summary() const {
+    std::ostringstream out;
+    bool first = true;
+    for (size_t z = 0; z < attempts.size(); ++z) {
+        if (attempts[z] == 0) continue;
+        out << (first ? "" : ", ") << courtZoneName(static_cast<CourtZone>(z)) << " " << attempts[z];
+        first = false;
+    }
+    return first ? "no shots" : out.str();
+}
+
+cv::Mat ShotChart::render(const CourtTemplate& court, int pixels_per_meter) const {
+    static const cv::Vec3b palette[static_cast<size_t>(CourtZone::Count)] = {
+        cv::Vec3b(40, 40, 40),      // Unknown
+        cv::Vec3b(60, 60, 60),      // OutOfBounds
+        cv::Vec3b(60, 90, 200),     // RestrictedArea
+        cv::Vec3b(80, 130, 220),    // Paint
+        cv::Vec3b(120, 180, 220),   // MidRange
+        cv::Vec3b(200, 150, 90),    // LeftCornerThree
+        cv::Vec3b(200, 150, 90),    // RightCornerThree
+        cv::Vec3b(170, 120, 70)     // AboveBreakThree
+    };
+    
+    CourtZoneMap map = CourtZoneMap::court(court, 1.0 / pixels_per_meter);
+    const cv::Mat& zones = map.raster();
+    cv::Mat chart(zones.size(), CV_8UC3);
+    for (int r = 0; r < zones.rows; ++r) {
+        const uint8_t* in = zones.ptr<uint8_t>(r);
+        cv::Vec3b* out = chart.ptr<cv::Vec3b>(r);
+        for (int c = 0; c < zones.cols; ++c) {
+            out[c] = palette[in[c] < static_cast<uint8_t>(CourtZone::Count) ? in[c] : 0];
+        }
+    }
+    
+    for (const auto& point : court_points) {
+        cv::Point center(cvRound(point.x * pixels_per_meter), cvRound(point.y * pixels_per_meter));
+        cv::circle(chart, center, 5, cv::Scalar(0, 0, 0), cv::FILLED, cv::LINE_AA);
+        cv::circle(chart, center, 3, cv::Scalar(255, 255, 255), cv::FILLED, cv::LINE_AA);
+    }
+    return chart;
+}
+
+} // namespace bbst::analysis
@@ -0,0 +1,49 @@
+#include "analysis/DetectorComparison.hpp"
+#include <cstdio>
+
+namespace bbst::analysis {
+
+const Detection<>* DetectorComparison::bestBall(const std::vector<Detection<>>& detections,
+                                                const ClassMask& classes) {
+    const Detection<>* best = nullptr;
+    for (const auto& det : detections) {
+        if (!classes.contains(det.class_id)) continue;
+        if (!best || det.confidence > best->confidence) best = &det;
+    }
+    return best;
+}
+
+void DetectorComparison::add(const std::vector<Detection<>>& reference, int64_t reference_us,
+                             const std::vector<Detection<>>& candidate, int64_t candidate_us) {
+    frames_++;
+    reference_latency_.record(reference_us);
+    candidate_latency_.record(candidate_us);
+    
+    const Detection<>* a = bestBall(reference, config_.reference_classes);
+    const Detection<>* b = bestBall(candidate, config_.candidate_classes);
+    if (a && b) {
+        const double distance = cv::norm(a->center - b->center);
+        if (distance <= config_.match_distance) {
+            agreed_++;
+            error_sum_ += distance;
+        } else {
+            disagreed_++;
+        }
+    } else if (a) {
+        reference_only_++;
+    } else if (b) {
+        candidate_only_++;
+    }
+}
+
+std::string DetectorComparison::summary() const {
+    char text[256];
+    std::snprintf(text, sizeof(text),
+                  "frames %d: agreed %d (mean error %.1f px), apart %d, "
+                  "reference only %d, candidate only %d\n",
+                  frames_, agreed_, meanError(), disagreed_, reference_only_, candidate_only_);
+    return std::string(text) + "reference: " + reference_latency_.summary() +
+           "\ncandidate: " + candidate_latency_.summary();
+}
+
+} // namespace bbst::analysis
@@ -0,0 +1,83 @@
+#include "analysis/MakeMiss.hpp"
+#include <cmath>
+
+namespace bbst::analysis {
+
+const char* shotOutcomeName(ShotOutcome outcome) {
+    switch (outcome) {
+        case ShotOutcome::Make: return "Make";
+        case ShotOutcome::Miss: return "Miss";
+        case ShotOutcome::None: break;
+    }
+    return "None";
+}
+
+MakeMissJudge::MakeMissJudge(const MakeMissConfig& config)
+    : config_(config)
+    , in_visit_(false)
+    , came_from_above_(false)
+    , dropped_through_(false)
+    , observations_(0)
+    , missing_(0)
+    , have_last_(false)
+{
+}
+
+cv::Rect2f MakeMissJudge::zone(const cv::Rect& rim, float scale) {
+    const float width = rim.width * scale;
+    const float height = rim.height * scale;
+    const float cx = rim.x + rim.width / 2.0f;
+    const float cy = rim.y + rim.height / 2.0f;
+    return cv::Rect2f(cx - width / 2.0f, cy - height / 2.0f, width, height);
+}
+
+ShotOutcome MakeMissJudge::endVisit() {
+    ShotOutcome outcome = ShotOutcome::None;
+    if (observations_ >= config_.min_observations && came_from_above_) {
+        outcome = dropped_through_ ? ShotOutcome::Make : ShotOutcome::Miss;
+    }
+    
+    in_visit_ = false;
+    came_from_above_ = false;
+    dropped_through_ = false;
+    observations_ = 0;
+    missing_ = 0;
+    have_last_ = false;
+    return outcome;
+}
+
+ShotOutcome MakeMissJudge::update(const cv::Rect& rim, const cv::Point2f* ball) {
+    if (ball == nullptr) {
+        if (in_visit_ && ++missing_ > config_.max_missing) return endVisit();
+        return ShotOutcome::None;
+    }
+    
+    if (!zone(rim, config_.zone_scale).contains(*ball)) {
+        return in_visit_ ? endVisit() : ShotOutcome::None;
+    }
+    
+    in_visit_ = true;
+    missing_ = 0;
+    observations_++;
+    
+    const float rim_plane = rim.y + rim.height / 2.0f;
+    const float rim_center = rim.x + rim.width / 2.0f;
+    if (ball->y < rim.y) {
+        came_from_above_ = true;
+    }
+    
+    // Downward crossing of the rim plane, interpolated to the plane
+    if (have_last_ && came_from_above_ && last_ball_.y <= rim_plane && ball->y > rim_plane) {
+        float t = (rim_plane - last_ball_.y) / (ball->y - last_ball_.y);
+        float x = last_ball_.x + t * (ball->x - last_ball_.x);
+        if (std::abs(x - rim_center) <= rim.width / 2.0f) {
+            dropped_through_ = true;
+        }
+    }
+    
+    last_ball_ = *ball;
+    have_last_ = true;
+    return ShotOutcome::None;
+}
+
+} // namespace bbst::analysis
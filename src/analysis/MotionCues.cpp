@@ -0,0 +1,90 @@
+#include "analysis/MotionCues.hpp"
+#include <algorithm>
+
+namespace bbst::analysis {
+
+MotionCues::MotionCues(const MotionCuesConfig& config)
+    : config_(config)
+{
+}
+
+static float median(std::vector<float>& values) {
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+cv::Point2f MotionCues::estimateCameraMotion(const io::MotionField& field) {
+    if (field.empty()) return cv::Point2f(0.0f, 0.0f);
+    
+    dx_.clear();
+    dy_.clear();
+    for (const auto& vector : field.vectors) {
+        dx_.push_back(vector.motion.x);
+        dy_.push_back(vector.motion.y);
+    }
+    return cv::Point2f(median(dx_), median(dy_));
+}
+
+MotionSummary MotionCues::analyze(const io::MotionField& field) {
+    MotionSummary summary;
+    if (field.intra || field.empty() || field.frame_size.area() <= 0) {
+        return summary;
+    }
+    summary.valid = true;
+    summary.camera_motion = estimateCameraMotion(field);
+    
+    // Rasterize blocks whose motion differs from the camera's
+    const int cell = config_.cell_size;
+    const cv::Rect frame_rect(cv::Point(0, 0), field.frame_size);
+    grid_.create((field.frame_size.height + cell - 1) / cell,
+                 (field.frame_size.width + cell - 1) / cell, CV_8UC1);
+    grid_.setTo(cv::Scalar(0));
+    
+    const float min_residual_sq = config_.min_residual * config_.min_residual;
+    double moving_area = 0.0;
+    
+    for (const auto& vector : field.vectors) {
+        cv::Point2f residual = vector.motion - summary.camera_motion;
+        if (residual.dot(residual) < min_residual_sq) continue;
+        
+        cv::Rect block(static_cast<int>(vector.position.x) - vector.block.width / 2,
+                       static_cast<int>(vector.position.y) - vector.block.height / 2,
+                       vector.block.width, vector.block.height);
+        block &= frame_rect;
+        if (block.empty()) continue;
+        
+        moving_area += block.area();
+        cv::Rect cells(block.x / cell, block.y / cell,
+                       (block.x + block.width - 1) / cell - block.x / cell + 1,
+                       (block.y + block.height - 1) / cell - block.y / cell + 1);
+        grid_(cells).setTo(cv::Scalar(255));
+    }
+    
+    // Bidirectional blocks export two vectors, so the area can double count
+    summary.moving_fraction = std::min(1.0f,
+        static_cast<float>(moving_area / field.frame_size.area()));
+    summary.static_scene = summary.moving_fraction < config_.static_fraction;
+    if (summary.static_scene) return summary;
+    
+    // Connected moving blobs become region proposals
+    int count = cv::connectedComponentsWithStats(grid_, labels_, stats_, centroids_, 8, CV_32S);
+    const float max_area = config_.max_region_fraction * field.frame_size.area();
+    
+    for (int label = 1; label < count; ++label) {
+        if (stats_.at<int>(label, cv::CC_STAT_AREA) < config_.min_region_cells) continue;
+        
+        cv::Rect region(stats_.at<int>(label, cv::CC_STAT_LEFT) * cell,
+                        stats_.at<int>(label, cv::CC_STAT_TOP) * cell,
+                        stats_.at<int>(label, cv::CC_STAT_WIDTH) * cell,
+                        stats_.at<int>(label, cv::CC_STAT_HEIGHT) * cell);
+        region &= frame_rect;
+        if (region.area() > max_area) continue;
+        
+        summary.regions.push_back(region);
+    }
+    
+    return summary;
+}
+
+} // namespace bbst::analysis
@@ -0,0 +1,168 @@
+#include "analysis/Possession.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace bbst::analysis {
+
+// PlayerGrid
+
+PlayerGrid::PlayerGrid(int cell_size)
+    : cell_(std::max(1, cell_size))
+    , cols_(0)
+    , rows_(0)
+    , max_half_extent_(0.0f)
+    , players_(nullptr)
+{
+}
+
+int PlayerGrid::cellCol(float x) const {
+    return std::clamp(static_cast<int>(std::floor(x / cell_)), 0, cols_ - 1);
+}
+
+int PlayerGrid::cellRow(float y) const {
+    return std::clamp(static_cast<int>(std::floor(y / cell_)), 0, rows_ - 1);
+}
+
+float PlayerGrid::boxDistance(const cv::Rect2f& box, const cv::Point2f& point) {
+    const float dx = std::max({box.x - point.x, 0.0f, point.x - (box.x + box.width)});
+    const float dy = std::max({box.y - point.y, 0.0f, point.y - (box.y + box.height)});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void PlayerGrid::build(const std::vector<tracking::PlayerTrack>& players, cv::Size frame_size) {
+    players_ = &players;
+    cols_ = std::max(1, (frame_size.width + cell_ - 1) / cell_);
+    rows_ = std::max(1, (frame_size.height + cell_ - 1) / cell_);
+    cell_start_.assign(static_cast<size_t>(cols_) * rows_ + 1, 0);
+    cell_of_.resize(players.size());
+    items_.resize(players.size());
+    max_half_extent_ = 0.0f;
+    
+    // Count, prefix-sum, scatter
+    for (size_t i = 0; i < players.size(); ++i) {
+        const cv::Rect2f& box = players[i].box;
+        max_half_extent_ = std::max({max_half_extent_, box.width / 2.0f, box.height / 2.0f});
+        cell_of_[i] = cellRow(box.y + box.height / 2.0f) * cols_ + cellCol(box.x + box.width / 2.0f);
+        cell_start_[cell_of_[i]]++;
+    }
+    for (size_t c = 1; c < cell_start_.size(); ++c) {
+        cell_start_[c] += cell_start_[c - 1];
+    }
+    for (size_t i = players.size(); i-- > 0;) {
+        items_[--cell_start_[cell_of_[i]]] = static_cast<int>(i);  // Ends become starts
+    }
+}
+
+int PlayerGrid::nearest(const cv::Point2f& point, float radius, float* distance) const {
+    if (players_ == nullptr || players_->empty()) return -1;
+    
+    // A box within radius has its center within radius + half its size
+    const float reach = radius + max_half_extent_;
+    const int c0 = cellCol(point.x - reach);
+    const int c1 = cellCol(point.x + reach);
+    const int r0 = cellRow(point.y - reach);
+    const int r1 = cellRow(point.y + reach);
+    
+    int best = -1;
+    float best_distance = FLT_MAX;
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            const int cell = r * cols_ + c;
+            for (int k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+                // Ties go to the lower index, whatever the cell order
+                float d = boxDistance((*players_)[items_[k]].box, point);
+                if (d <= radius && (d < best_distance || (d == best_distance && items_[k] < best))) {
+                    best_distance = d;
+                    best = items_[k];
+                }
+            }
+        }
+    }
+    if (distance != nullptr) *distance = best_distance;
+    return best;
+}
+
+// PossessionTracker
+
+const char* possessionEventName(PossessionEventType type) {
+    switch (type) {
+        case PossessionEventType::Gained: return "gained";
+        case PossessionEventType::Released: return "released";
+        case PossessionEventType::Pass: return "pass";
+    }
+    return "unknown";
+}
+
+PossessionTracker::PossessionTracker(const PossessionConfig& config)
+    : config_(config)
+    , grid_(config.grid_cell)
+    , holder_(-1)
+    , candidate_(-1)
+    , candidate_frames_(0)
+    , candidate_since_(0)
+    , away_frames_(0)
+    , away_since_(0)
+    , last_holder_(-1)
+    , release_frame_(-1)
+{
+}
+
+void PossessionTracker::update(int64_t frame, const cv::Point2f* ball,
+                               const std::vector<tracking::PlayerTrack>& players,
+                               cv::Size frame_size, std::vector<PossessionEvent>& events) {
+    // An unseen ball is usually hidden by the hands holding it: keep the state
+    if (ball == nullptr) return;
+    
+    grid_.build(players, frame_size);
+    
+    if (holder_ >= 0) {
+        float holder_distance = FLT_MAX;
+        for (const auto& player : players) {
+            if (player.id == holder_) {
+                holder_distance = PlayerGrid::boxDistance(player.box, *ball);
+            }
+        }
+        
+        if (holder_distance <= config_.release_radius) {
+            away_frames_ = 0;
+        } else if (++away_frames_ == 1) {
+            away_point_ = *ball;
+            away_since_ = frame;
+        }
+        if (away_frames_ < config_.release_frames) return;
+        
+        events.push_back({PossessionEventType::Released, away_since_, holder_, -1});
+        last_holder_ = holder_;
+        release_frame_ = away_since_;
+        release_point_ = away_point_;
+        holder_ = -1;
+        away_frames_ = 0;
+        candidate_ = -1;
+    }
+    
+    // Loose ball: the same nearest player for acquire_frames takes it
+    int nearest = grid_.nearest(*ball, config_.radius);
+    int id = nearest >= 0 ? players[nearest].id : -1;
+    if (id != candidate_) {
+        candidate_ = id;
+        candidate_frames_ = 0;
+        candidate_since_ = frame;
+    }
+    if (candidate_ < 0 || ++candidate_frames_ < config_.acquire_frames) return;
+    
+    holder_ = candidate_;
+    candidate_ = -1;
+    events.push_back({PossessionEventType::Gained, candidate_since_, holder_, -1});
+    
+    if (last_holder_ >= 0 && last_holder_ != holder_ && release_frame_ >= 0) {
+        const int64_t flight = candidate_since_ - release_frame_;
+        const float travel = static_cast<float>(cv::norm(*ball - release_point_));
+        if (flight >= config_.min_flight_frames && flight <= config_.max_flight_frames &&
+            travel >= config_.min_pass_distance) {
+            events.push_back({PossessionEventType::Pass, candidate_since_, holder_, last_holder_});
+        }
+    }
+}
+
+} // namespace bbst::analysis
@@ -0,0 +1,134 @@
+#include "analysis/ShotEvents.hpp"
+#include <algorithm>
+
+namespace bbst::analysis {
+
+namespace {
+
+struct TrackPoint {
+    int frame;
+    float y;
+    cv::Point2f position;
+};
+
+} // namespace
+
+std::vector<ShotEvent> findShotEvents(const std::vector<pipeline::FrameResult>& track,
+                                      const ShotEventConfig& config) {
+    std::vector<TrackPoint> points;
+    for (const auto& result : track) {
+        if (result.tracking) {
+            points.push_back({static_cast<int>(result.frame_index), result.position.y,
+                              result.position});
+        }
+    }
+    std::sort(points.begin(), points.end(),
+              [](const TrackPoint& a, const TrackPoint& b) { return a.frame < b.frame; });
+    
+    std::vector<ShotEvent> events;
+    const int n = static_cast<int>(points.size());
+    for (int i = 0; i < n; ++i) {
+        const TrackPoint& apex = points[i];
+        
+        // Highest point (smallest y) around; ties go to the first frame
+        bool is_apex = true;
+        for (int j = i - 1; j >= 0 && apex.frame - points[j].frame <= config.apex_radius; --j) {
+            if (points[j].y <= apex.y) is_apex = false;
+        }
+        for (int j = i + 1; j < n && points[j].frame - apex.frame <= config.apex_radius; ++j) {
+            if (points[j].y < apex.y) is_apex = false;
+        }
+        if (!is_apex) continue;
+        
+        // Launch: lowest point before the apex within the same flight
+        int launch = i;
+        for (int j = i - 1; j >= 0; --j) {
+            if (points[j + 1].frame - points[j].frame > config.max_gap + 1) break;
+            if (apex.frame - points[j].frame > config.window_frames) break;
+            if (points[j].y > points[launch].y) launch = j;
+        }
+        
+        // Landing: lowest point after the apex within the same flight
+        int land = i;
+        for (int j = i + 1; j < n; ++j) {
+            if (points[j].frame - points[j - 1].frame > config.max_gap + 1) break;
+            if (points[j].frame - apex.frame > config.window_frames) break;
+            if (points[j].y > points[land].y) land = j;
+        }
+        
+        float rise = points[launch].y - apex.y;
+        float drop = points[land].y - apex.y;
+        if (rise < config.min_rise || drop < config.min_drop) continue;
+        
+        ShotEvent event;
+        event.launch_frame = points[launch].frame;
+        event.apex_frame = apex.frame;
+        event.land_frame = points[land].frame;
+        event.rise = rise;
+        event.launch_point = points[launch].position;
+        event.floor_point = event.launch_point;
+        
+        // Double-peaked arcs (rim bounces, tracker jitter) are one shot
+        if (!events.empty() && event.apex_frame - events.back().apex_frame < config.min_separation) {
+            if (event.rise > events.back().rise) events.back() = event;
+            continue;
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+void classifyShots(std::vector<ShotEvent>& events, const CourtZoneMap& image_map) {
+    for (auto& event : events) {
+        event.zone = image_map.at(event.floor_point);
+    }
+}
+
+std::vector<PossessionEvent> possessionFromTrack(const std::vector<pipeline::FrameResult>& track) {
+    std::vector<PossessionEvent> events;
+    int holder = -1;
+    for (const auto& result : track) {
+        if (result.holder == holder) continue;
+        if (holder >= 0) {
+            events.push_back({PossessionEventType::Released, result.frame_index, holder, -1});
+        }
+        if (result.holder >= 0) {
+            events.push_back({PossessionEventType::Gained, result.frame_index, result.holder, -1});
+        }
+        holder = result.holder;
+    }
+    return events;
+}
+
+void attributeShooters(std::vector<ShotEvent>& events, const std::vector<PossessionEvent>& possession,
+                       int tolerance_frames) {
+    for (auto& event : events) {
+        event.shooter = -1;
+        for (const auto& change : possession) {
+            if (change.frame > event.launch_frame + tolerance_frames) break;
+            if (change.type == PossessionEventType::Released) event.shooter = change.player;
+        }
+    }
+}
+
+void locateShooters(std::vector<ShotEvent>& events, const std::vector<pipeline::FrameResult>& track,
+                    int tolerance_frames) {
+    for (auto& event : events) {
+        event.floor_point = event.launch_point;
+        if (event.shooter < 0) continue;
+        
+        int64_t latest = -1;
+        for (const auto& result : track) {
+            if (result.frame_index > event.launch_frame + tolerance_frames) continue;
+            if (result.frame_index < latest) continue;
+            for (const auto& player : result.players) {
+                if (player.id != event.shooter) continue;
+                event.floor_point = cv::Point2f(player.box.x + player.box.width / 2.0f,
+                                                player.box.y + player.box.height);
+                latest = result.frame_index;
+            }
+        }
+    }
+}
+
+} // namespace bbst::analysis
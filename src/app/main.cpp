@@ -1,21 +1,582 @@
+#include "analysis/DetectorComparison.hpp"
+#include "analysis/MotionCues.hpp"
+#include "analysis/ShotEvents.hpp"
+#include "core/FrameContext.hpp"
+#include "detectors/HeatmapDetector.hpp"
 #include "detectors/YoloDetector.hpp"
+#include "ingest/IngestDaemon.hpp"
+#include "io/FrameSource.hpp"
+#include "io/LibavSource.hpp"
+#include "io/OverlaySidecarWriter.hpp"
+#include "io/SegmentedVideoWriter.hpp"
+#include "io/StampedSource.hpp"
+#include "io/TrackCsvWriter.hpp"
+#include "pipeline/ArchiveProcessor.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include "pipeline/HighlightRenderer.hpp"
+#include "pipeline/ShardProcessor.hpp"
 #include "tracking/KalmanTracker.hpp"
+#include "tracking/MultiCameraFusion.hpp"
 #include "ui/OverlayRenderer.hpp"
+#include "util/EnergyMeter.hpp"
+#include "util/MemoryStats.hpp"
+#include "util/PooledMatAllocator.hpp"
+#include "util/Profiler.hpp"
+#include "util/TaggingMatAllocator.hpp"
 #include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <filesystem>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 using namespace bbst;
+using namespace bbst::pipeline;
 using namespace bbst::tracking;
 using namespace bbst::ui;
 
+// Parse "WIDTHxHEIGHT[@FPS]" for raw YUV input
+static bool parseRawSpec(const std::string& spec, cv::Size& size, double& fps) {
+    fps = 30.0;
+    int n = std::sscanf(spec.c_str(), "%dx%d@%lf", &size.width, &size.height, &fps);
+    return n >= 2 && size.width > 0 && size.height > 0 && fps > 0.0;
+}
+
+static void printUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " [options] [input_video] [output_video]\n"
+              << "  --raw-nv12 WxH[@fps]   Input is a raw NV12 stream (file or - for stdin)\n"
+              << "  --raw-i420 WxH[@fps]   Input is a raw I420 stream (file or - for stdin)\n"
+              << "  --adaptive-input       Pick the detector input size from the tracked ball size\n"
+              << "  --synthetic WxH[@fps]  Live synthetic source with stamped frames; reports\n"
+              << "                         capture-to-output latency\n"
+              << "  --frames N             Frames to generate with --synthetic (default 600)\n"
+              << "  --libav                Decode with libavcodec and use its motion vectors for\n"
+              << "                         camera compensation, motion gating and ROI proposals\n"
+              << "  --roi                  Detect inside the tracker's search region when confident\n"
+              << "  --person-class N       Track players from the model's person class N\n"
+              << "  --meters-per-pixel S   Report ball speed in m/s at a fixed image scale\n"
+              << "  --ball-diameter M      Report ball speed in m/s, scaled by the ball's size\n"
+              << "                         (0.24 for a size 7 ball)\n"
+              << "  --rim-burst            Detect a native-resolution rim crop while the ball is near\n"
+              << "                         the rim, and call makes and misses\n"
+              << "  --overlay-sidecar      Write overlay primitives as a JSON Lines sidecar instead of\n"
+              << "                         rendering and re-encoding the video\n"
+              << "  --segments N           Encode the output in N-frame segments on parallel threads,\n"
+              << "                         then join them losslessly with ffmpeg\n"
+              << "  --encode-threads N     Concurrent segment encoders (default: cores, at most 4)\n"
+              << "  --hls                  Keep the segments and write an HLS playlist as the output\n"
+              << "  --archive              Two-pass archive mode: sparse scan, then dense tracking of\n"
+              << "                         active segments in parallel; output is a CSV track file\n"
+              << "  --highlights TRACKS    Render a clip around every shot in TRACKS (a track CSV)\n"
+              << "                         from the input video, without running detection; the\n"
+              << "                         positional output is the clip directory\n"
+              << "  --court FILE           With --highlights: classify shot zones and draw a shot\n"
+              << "                         chart; FILE holds the 3x3 image_to_court homography\n"
+              << "  --compare-heatmap MODEL\n"
+              << "                         Run a heatmap (CenterNet-style) ball model next to the\n"
+              << "                         YOLO model on every frame; report agreement and latency\n"
+              << "  --heatmap-size WxH     Input size of the heatmap model (default 512x512)\n"
+              << "  --heatmap-logits       The heatmap model outputs pre-sigmoid scores\n"
+              << "  --fuse CALIB           Fuse track CSVs from calibrated cameras into a 3D track;\n"
+              << "                         positional: one track per camera, then the output CSV.\n"
+              << "                         CALIB holds 3x4 projections camera_0, camera_1, ...\n"
+              << "  --daemon               Ingest service: process videos dropped into the watched\n"
+              << "                         folders; the positional argument is the output directory\n"
+              << "  --watch-live DIR       Watch DIR, clips are processed before everything else\n"
+              << "  --watch DIR            Watch DIR for recent clips\n"
+              << "  --watch-archive DIR    Watch DIR for backlog, processed when idle\n"
+              << "  --workers N            Daemon worker (and model) count (default 2)\n"
+              << "  --journal FILE         Daemon queue journal (default ingest.journal)\n"
+              << "  --shard-plan TABLE     Chunk the input videos into a shared job table\n"
+              << "  --shard-work TABLE     Process jobs from the table (start one per process)\n"
+              << "  --shard-reduce TABLE   Merge job outputs; the positional argument is the output dir\n"
+              << "  --chunk N              Frames per shard job (default 3000)\n"
+              << "  --shards N             Expected worker processes (default: core count)\n"
+              << "  --profile FILE         Sample CPU stacks and write folded stacks to FILE\n"
+              << "  --profile-hz N         Sampling rate per thread (default 997)\n"
+              << "  --mem-stats SECONDS    Report memory per subsystem every SECONDS and at exit\n"
+              << "  --mat-pool             Recycle large Mat buffers instead of mapping fresh ones\n"
+              << "  --huge-pages           Back the Mat pool with huge pages (implies --mat-pool)\n"
+              << "  --energy               Report package/DRAM energy per frame from RAPL counters\n";
+}
+
+// Multi-process archive reprocessing through an mmap'd job table
+static int runShard(const std::string& mode, const std::string& table_path,
+                    const std::vector<std::string>& positional,
+                    const std::string& model_path, const std::string& names_path,
+                    const YoloConfig& yolo_config, const TrackerConfig& tracker_config,
+                    const PipelineOptions& pipeline_options, const ShardConfig& shard_config) {
+    if (mode == "reduce") {
+        std::string output_dir = positional.empty() ? "tracks" : positional[0];
+        int missing = ShardProcessor::reduce(table_path, output_dir);
+        std::cout << "Merged tracks into " << output_dir << ", " << missing
+                  << " jobs missing" << std::endl;
+        return missing == 0 ? 0 : -1;
+    }
+    
+    ShardProcessor shards(model_path, names_path, yolo_config, tracker_config,
+                          pipeline_options, shard_config);
+    if (mode == "plan") {
+        if (positional.empty()) {
+            std::cerr << "Error: --shard-plan needs input videos" << std::endl;
+            return -1;
+        }
+        size_t jobs = shards.plan(table_path, positional);
+        std::cout << "Planned " << jobs << " jobs over " << positional.size()
+                  << " videos in " << table_path << std::endl;
+        return 0;
+    }
+    
+    int completed = shards.work(table_path);
+    std::cout << "Worker done, " << completed << " jobs completed" << std::endl;
+    return 0;
+}
+
+static std::atomic<bool> g_stop{false};
+
+static void onStopSignal(int) {
+    g_stop = true;
+}
+
+// Drop-folder ingest daemon, runs until SIGINT/SIGTERM
+static int runDaemon(const std::vector<std::pair<std::string, ingest::Priority>>& watch_dirs,
+                     const std::string& model_path, const std::string& names_path,
+                     const YoloConfig& yolo_config, const TrackerConfig& tracker_config,
+                     const PipelineOptions& pipeline_options,
+                     const ingest::IngestConfig& ingest_config) {
+    if (watch_dirs.empty()) {
+        std::cerr << "Error: --daemon needs at least one watched folder" << std::endl;
+        return -1;
+    }
+    
+    ingest::IngestDaemon daemon(model_path, names_path, yolo_config, tracker_config,
+                                pipeline_options, ingest_config);
+    for (const auto& [dir, priority] : watch_dirs) {
+        daemon.watch(dir, priority);
+        std::cout << "Watching " << dir << " (" << ingest::priorityName(priority) << ")" << std::endl;
+    }
+    
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    daemon.run(g_stop);
+    
+    std::cout << "Stopped: " << daemon.completed() << " clips done, "
+              << daemon.failed() << " failed" << std::endl;
+    return 0;
+}
+
+// Two-pass archive processing of a full game, writes per-frame tracks as CSV
+static int runArchive(const std::string& video_path, const std::string& output_path,
+                      const std::string& model_path, const std::string& names_path,
+                      const YoloConfig& yolo_config, const TrackerConfig& tracker_config,
+                      const PipelineOptions& pipeline_options, bool measure_energy) {
+    ArchiveProcessor archive(model_path, names_path, yolo_config, tracker_config,
+                             pipeline_options);
+    
+    // Counters are folded in while both passes run, as the live loop does
+    std::unique_ptr<util::EnergyMeter> energy_meter;
+    if (measure_energy) {
+        energy_meter = std::make_unique<util::EnergyMeter>();
+        if (!energy_meter->available()) {
+            std::cerr << "Warning: RAPL energy counters are not readable "
+                      << "(needs root or read access to /sys/class/powercap)" << std::endl;
+        }
+        archive.setProgressCallback([meter = energy_meter.get()]() { meter->update(); });
+    }
+    
+    std::cout << "Scanning " << video_path << " for active segments..." << std::endl;
+    std::vector<Segment> segments = archive.scan(video_path);
+    std::cout << "Found " << segments.size() << " segments" << std::endl;
+    
+    std::vector<FrameResult> results = archive.processSegments(video_path, segments);
+    
+    io::TrackCsvWriter writer(output_path);
+    for (const auto& result : results) {
+        writer.write(result);
+    }
+    
+    const ArchiveStats& stats = archive.stats();
+    double covered = stats.total_frames > 0
+        ? 100.0 * stats.processed_frames / stats.total_frames : 0.0;
+    std::cout << "\n" << std::string(50, '=') << std::endl;
+    std::cout << std::setw(30) << "ARCHIVE STATISTICS" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    std::cout << "Total frames: " << stats.total_frames << std::endl;
+    std::cout << "Scanned frames: " << stats.scanned_frames << std::endl;
+    std::cout << "Segments: " << stats.segments << std::endl;
+    std::cout << "Densely processed: " << stats.processed_frames << " ("
+              << std::fixed << std::setprecision(1) << covered << "%)" << std::endl;
+    std::cout << "Scan time: " << std::setprecision(2) << stats.scan_ms / 1000.0 << "s" << std::endl;
+    std::cout << "Dense time: " << stats.dense_ms / 1000.0 << "s" << std::endl;
+    if (energy_meter) {
+        // Per input frame, so archive and full processing compare directly
+        std::cout << "Energy: " << util::formatEnergy(energy_meter->read(), stats.total_frames)
+                  << std::endl;
+    }
+    std::cout << "Tracks saved to: " << output_path << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    
+    return 0;
+}
+
+// Shot highlight clips from an existing track file; no model is loaded
+static int runHighlights(const std::string& video_path, const std::string& tracks_path,
+                         const std::string& output_dir, const std::string& court_path) {
+    std::vector<FrameResult> track = io::readTrackCsv(tracks_path);
+    std::vector<analysis::ShotEvent> events = analysis::findShotEvents(track);
+    analysis::attributeShooters(events, analysis::possessionFromTrack(track));
+    analysis::locateShooters(events, track);
+    std::cout << "Found " << events.size() << " shots in " << tracks_path << std::endl;
+    
+    // Shot zones and chart, when the camera's floor homography is known
+    if (!court_path.empty()) {
+        cv::FileStorage calibration(court_path, cv::FileStorage::READ);
+        cv::Mat homography;
+        if (calibration.isOpened()) calibration["image_to_court"] >> homography;
+        if (homography.rows != 3 || homography.cols != 3) {
+            std::cerr << "Error: " << court_path << " has no 3x3 image_to_court homography" << std::endl;
+            return -1;
+        }
+        homography.convertTo(homography, CV_64F);
+        
+        cv::VideoCapture probe(video_path);
+        cv::Size frame_size(static_cast<int>(probe.get(cv::CAP_PROP_FRAME_WIDTH)),
+                            static_cast<int>(probe.get(cv::CAP_PROP_FRAME_HEIGHT)));
+        auto zone_map = analysis::CourtZoneMap::image(cv::Matx33d(homography.ptr<double>()),
+                                                      frame_size);
+        analysis::classifyShots(events, zone_map);
+        
+        analysis::ShotChart chart;
+        for (const auto& event : events) {
+            chart.add(event.zone, zone_map.toCourt(event.floor_point));
+            std::cout << "Shot at frame " << event.apex_frame << ": "
+                      << analysis::courtZoneName(event.zone);
+            if (event.shooter >= 0) std::cout << " by player " << event.shooter;
+            std::cout << std::endl;
+        }
+        std::filesystem::create_directories(output_dir);
+        const std::string chart_path = (std::filesystem::path(output_dir) / "shot_chart.png").string();
+        cv::imwrite(chart_path, chart.render());
+        std::cout << "Shot chart (" << chart.summary() << "): " << chart_path << std::endl;
+    }
+    
+    auto start = cv::getTickCount();
+    HighlightRenderer renderer(video_path, std::move(track));
+    std::vector<HighlightClip> clips = renderer.render(events, output_dir);
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+    
+    for (const auto& clip : clips) {
+        std::cout << clip.path << ": frames " << clip.range.start << "-" << clip.range.end
+                  << ", " << clip.apex_frames.size() << " shot(s)" << std::endl;
+    }
+    std::cout << "Rendered " << clips.size() << " clips in " << std::fixed
+              << std::setprecision(1) << seconds << "s" << std::endl;
+    return 0;
+}
+
+// Runs the YOLO model and a heatmap ball model on every frame of a video and
+// reports where their balls agree and what each costs
+static int runComparison(const std::string& video_path, const std::string& model_path,
+                         const std::string& names_path, YoloConfig yolo_config,
+                         const std::string& heatmap_path, const HeatmapConfig& heatmap_config) {
+    cv::VideoCapture cap(video_path);
+    if (!cap.isOpened()) {
+        std::cerr << "Error: Cannot open video " << video_path << std::endl;
+        return -1;
+    }
+    
+    yolo_config.verbose = false;
+    YoloDetector yolo(model_path, names_path, yolo_config);
+    HeatmapDetector heatmap(heatmap_path, "", heatmap_config);
+    std::cout << "Heatmap model: " << heatmap.getInputSize().width << "x"
+              << heatmap.getInputSize().height
+              << (heatmap.hasSizeOutput() ? ", sizes" : "")
+              << (heatmap.hasOffsetOutput() ? ", offsets" : "") << std::endl;
+    
+    // Neither side pays its first-forward allocation inside the timing
+    yolo.prepareInputSizes({});
+    heatmap.warmUp();
+    
+    auto elapsedUs = [](int64_t start) {
+        return static_cast<int64_t>((cv::getTickCount() - start) * 1e6 / cv::getTickFrequency());
+    };
+    
+    analysis::DetectorComparison comparison;
+    cv::Mat frame;
+    while (cap.read(frame)) {
+        int64_t start = cv::getTickCount();
+        std::vector<Detection<>> reference = yolo.detect(frame, BallClasses{});
+        const int64_t reference_us = elapsedUs(start);
+        
+        start = cv::getTickCount();
+        std::vector<Detection<>> candidate = heatmap.detect(frame);
+        const int64_t candidate_us = elapsedUs(start);
+        
+        comparison.add(reference, reference_us, candidate, candidate_us);
+        if (comparison.frames() % 100 == 0) {
+            std::cout << "Compared " << comparison.frames() << " frames" << std::endl;
+        }
+    }
+    
+    std::cout << comparison.summary() << std::endl;
+    return 0;
+}
+
+// Offline 3D fusion of per-camera tracks, each on its own camera clock
+static int runFusion(const std::string& calibration_path,
+                     const std::vector<std::string>& positional) {
+    if (positional.size() < 3) {
+        std::cerr << "Error: --fuse needs at least two track files and an output file" << std::endl;
+        return -1;
+    }
+    const std::string& output_path = positional.back();
+    const size_t cameras = positional.size() - 1;
+    
+    cv::FileStorage calibration(calibration_path, cv::FileStorage::READ);
+    if (!calibration.isOpened()) {
+        std::cerr << "Error: Cannot open calibration " << calibration_path << std::endl;
+        return -1;
+    }
+    std::vector<cv::Matx34d> projections;
+    std::vector<std::vector<FrameResult>> tracks;
+    for (size_t c = 0; c < cameras; ++c) {
+        cv::Mat projection;
+        calibration["camera_" + std::to_string(c)] >> projection;
+        if (projection.rows != 3 || projection.cols != 4) {
+            std::cerr << "Error: camera_" << c << " is not a 3x4 projection matrix" << std::endl;
+            return -1;
+        }
+        projection.convertTo(projection, CV_64F);
+        projections.emplace_back(projection.ptr<double>());
+        tracks.push_back(io::readTrackCsv(positional[c]));
+    }
+    
+    FusionConfig fusion_config;
+    MultiCameraFusion fusion(projections, fusion_config);
+    std::ofstream out(output_path);
+    out << "time_ms,valid,measured,x,y,z,vx,vy,vz,views,reprojection_px\n";
+    
+    // Fuse at camera 0's frame times; the others are fed as far ahead as
+    // their clock offset can reach
+    std::vector<size_t> next(cameras, 0);
+    int fused = 0;
+    for (const auto& frame : tracks[0]) {
+        const double t = frame.timestamp_ms;
+        for (size_t c = 0; c < cameras; ++c) {
+            const double horizon = t + fusion_config.max_offset_ms;
+            for (; next[c] < tracks[c].size() && tracks[c][next[c]].timestamp_ms <= horizon; ++next[c]) {
+                const FrameResult& r = tracks[c][next[c]];
+                if (r.ball_detected) {
+                    fusion.addObservation(static_cast<int>(c), r.timestamp_ms, r.position);
+                }
+            }
+        }
+        
+        FusedBall ball = fusion.fuse(t);
+        out << std::fixed << std::setprecision(1) << t << ","
+            << ball.valid << "," << ball.measured << ","
+            << std::setprecision(3) << ball.position.x << "," << ball.position.y << ","
+            << ball.position.z << "," << ball.velocity[0] << "," << ball.velocity[1] << ","
+            << ball.velocity[2] << "," << ball.views << ","
+            << std::setprecision(2) << ball.reprojection_px << "\n";
+        if (ball.measured) fused++;
+    }
+    
+    std::cout << "Fused " << fused << "/" << tracks[0].size() << " frames from " << cameras
+              << " cameras" << std::endl;
+    for (size_t c = 1; c < cameras; ++c) {
+        std::cout << "Clock offset camera " << c << ": " << std::setprecision(1)
+                  << fusion.clockOffsetMs(static_cast<int>(c)) << " ms" << std::endl;
+    }
+    std::cout << "3D track saved to: " << output_path << std::endl;
+    return 0;
+}
+
 int main(int argc, char** argv) {
     // Parse arguments
-    std::string video_path = argc > 1 ? argv[1] : "data/videos/tyreseMaxey.mp4";
+    std::vector<std::string> positional;
+    bool raw_input = false;
+    io::YuvLayout raw_layout = io::YuvLayout::NV12;
+    cv::Size raw_size;
+    double raw_fps = 30.0;
+    bool synthetic_input = false;
+    int synthetic_frames = 600;
+    bool adaptive_input = false;
+    bool use_roi = false;
+    bool rim_burst = false;
+    int person_class = -1;
+    float meters_per_pixel = 0.0f;
+    float ball_diameter_m = 0.0f;
+    bool archive_mode = false;
+    std::string highlights_tracks;
+    std::string compare_heatmap;
+    HeatmapConfig heatmap_config;
+    std::string court_path;
+    std::string fusion_calibration;
+    bool overlay_sidecar = false;
+    bool segmented_output = false;
+    io::SegmentedWriterConfig segment_config;
+    bool use_libav = false;
+    bool daemon_mode = false;
+    std::vector<std::pair<std::string, ingest::Priority>> watch_dirs;
+    ingest::IngestConfig ingest_config;
+    std::string shard_mode;
+    std::string shard_table;
+    ShardConfig shard_config;
+    bool profile = false;
+    util::ProfilerConfig profiler_config;
+    int mem_stats_seconds = 0;
+    bool mat_pool = false;
+    bool measure_energy = false;
+    util::BufferPoolConfig pool_config;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--raw-nv12" || arg == "--raw-i420") && i + 1 < argc) {
+            raw_input = true;
+            raw_layout = arg == "--raw-nv12" ? io::YuvLayout::NV12 : io::YuvLayout::I420;
+            if (!parseRawSpec(argv[++i], raw_size, raw_fps)) {
+                std::cerr << "Error: Invalid raw frame spec " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            synthetic_input = true;
+            if (!parseRawSpec(argv[++i], raw_size, raw_fps)) {
+                std::cerr << "Error: Invalid synthetic frame spec " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--frames" && i + 1 < argc) {
+            synthetic_frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--adaptive-input") {
+            adaptive_input = true;
+        } else if (arg == "--roi") {
+            use_roi = true;
+        } else if (arg == "--rim-burst") {
+            rim_burst = true;
+        } else if (arg == "--person-class" && i + 1 < argc) {
+            person_class = std::atoi(argv[++i]);
+            if (BallClasses::contains(person_class) || person_class == RIM_CLASS) {
+                std::cerr << "Error: Person class " << person_class
+                          << " collides with the ball and rim classes" << std::endl;
+                return -1;
+            }
+        } else if (arg == "--meters-per-pixel" && i + 1 < argc) {
+            meters_per_pixel = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--ball-diameter" && i + 1 < argc) {
+            ball_diameter_m = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--archive") {
+            archive_mode = true;
+        } else if (arg == "--highlights" && i + 1 < argc) {
+            highlights_tracks = argv[++i];
+        } else if (arg == "--compare-heatmap" && i + 1 < argc) {
+            compare_heatmap = argv[++i];
+        } else if (arg == "--heatmap-size" && i + 1 < argc) {
+            int width = 0, height = 0;
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                std::cerr << "Error: Invalid heatmap input size " << argv[i] << std::endl;
+                return -1;
+            }
+            heatmap_config.input_width = static_cast<float>(width);
+            heatmap_config.input_height = static_cast<float>(height);
+        } else if (arg == "--heatmap-logits") {
+            heatmap_config.logits = true;
+        } else if (arg == "--court" && i + 1 < argc) {
+            court_path = argv[++i];
+        } else if (arg == "--fuse" && i + 1 < argc) {
+            fusion_calibration = argv[++i];
+        } else if (arg == "--overlay-sidecar") {
+            overlay_sidecar = true;
+        } else if (arg == "--segments" && i + 1 < argc) {
+            segmented_output = true;
+            segment_config.segment_frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--encode-threads" && i + 1 < argc) {
+            segment_config.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--hls") {
+            segmented_output = true;
+            segment_config.playlist = true;
+        } else if (arg == "--libav") {
+            use_libav = true;
+        } else if (arg == "--daemon") {
+            daemon_mode = true;
+        } else if ((arg == "--watch" || arg == "--watch-live" || arg == "--watch-archive") &&
+                   i + 1 < argc) {
+            ingest::Priority priority = arg == "--watch-live" ? ingest::Priority::Live
+                                      : arg == "--watch" ? ingest::Priority::Recent
+                                      : ingest::Priority::Archive;
+            watch_dirs.emplace_back(argv[++i], priority);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            ingest_config.workers = std::atoi(argv[++i]);
+        } else if (arg == "--journal" && i + 1 < argc) {
+            ingest_config.journal_path = argv[++i];
+        } else if ((arg == "--shard-plan" || arg == "--shard-work" || arg == "--shard-reduce") &&
+                   i + 1 < argc) {
+            shard_mode = arg.substr(8);
+            shard_table = argv[++i];
+        } else if (arg == "--chunk" && i + 1 < argc) {
+            shard_config.chunk_frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--shards" && i + 1 < argc) {
+            shard_config.shards = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--profile" && i + 1 < argc) {
+            profile = true;
+            profiler_config.output_path = argv[++i];
+        } else if (arg == "--profile-hz" && i + 1 < argc) {
+            profiler_config.frequency_hz = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--mem-stats" && i + 1 < argc) {
+            mem_stats_seconds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--mat-pool") {
+            mat_pool = true;
+        } else if (arg == "--huge-pages") {
+            mat_pool = true;
+            pool_config.huge_pages = true;
+        } else if (arg == "--energy") {
+            measure_energy = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    
+    std::string video_path = positional.size() > 0 ? positional[0] : "data/videos/tyreseMaxey.mp4";
     std::string model_path = "models/basketball_model.onnx";
     std::string names_path = "models/basketball.names";
-    std::string output_path = argc > 2 ? argv[2] : "output_tracked.mp4";
+    std::string output_path = positional.size() > 1 ? positional[1]
+                            : archive_mode ? "output_tracks.csv"
+                            : !highlights_tracks.empty() ? "highlights"
+                            : overlay_sidecar ? "output_overlay.jsonl"
+                            : segment_config.playlist ? "output_tracked.m3u8" : "output_tracked.mp4";
+    
+    // Written on every exit path, including the daemon's signal shutdown
+    if (profile && util::SamplingProfiler::start(profiler_config)) {
+        std::atexit([] { util::SamplingProfiler::stop(); });
+    }
+    
+    // Installed first so that memory accounting wraps the pool
+    static util::PooledMatAllocator* pool = nullptr;
+    if (mat_pool) {
+        pool = &util::PooledMatAllocator::install(pool_config);
+        std::atexit([] {
+            util::BufferPoolStats stats = pool->stats();
+            std::cout << "Mat pool: " << stats.hits << " reused, " << stats.misses << " mapped, "
+                      << stats.mapped_bytes / (1024 * 1024) << " MB held" << std::endl;
+        });
+    }
+    
+    // Destroyed on every return from main, which prints the final report
+    std::unique_ptr<util::MemoryReporter> memory_reporter;
+    if (mem_stats_seconds > 0) {
+        util::TaggingMatAllocator::install();
+        memory_reporter = std::make_unique<util::MemoryReporter>(
+            std::chrono::seconds(mem_stats_seconds));
+    }
     
     try {
         // Initialize detector
@@ -24,8 +585,6 @@ int main(int argc, char** argv) {
         yolo_config.nms_threshold = 0.45f;
         yolo_config.score_threshold = 0.25f;
         
-        YoloDetector detector(model_path, names_path, yolo_config);
-        
         // Initialize tracker
         TrackerConfig tracker_config;
         tracker_config.max_trajectory_length = 50;
@@ -35,42 +594,87 @@ int main(int argc, char** argv) {
         tracker_config.min_aspect_ratio = 0.3f;
         tracker_config.max_aspect_ratio = 3.0f;
         tracker_config.max_frames_without_detection = 20;
+        tracker_config.meters_per_pixel = meters_per_pixel;
+        tracker_config.ball_diameter_m = ball_diameter_m;
+        
+        // Ball shape priors are applied by the decoder, before NMS
+        applyBallPriors(yolo_config, tracker_config);
+        
+        PipelineOptions pipeline_options;
+        pipeline_options.use_roi = use_roi;
+        pipeline_options.adaptive_input = adaptive_input;
+        pipeline_options.rim_burst = rim_burst;
+        pipeline_options.person_class = person_class;
+        
+        if (!shard_mode.empty()) {
+            return runShard(shard_mode, shard_table, positional, model_path, names_path,
+                            yolo_config, tracker_config, pipeline_options, shard_config);
+        }
+        
+        if (daemon_mode) {
+            if (!positional.empty()) ingest_config.output_dir = positional[0];
+            return runDaemon(watch_dirs, model_path, names_path, yolo_config,
+                             tracker_config, pipeline_options, ingest_config);
+        }
+        
+        if (!fusion_calibration.empty()) {
+            return runFusion(fusion_calibration, positional);
+        }
+        
+        if (!highlights_tracks.empty()) {
+            return runHighlights(video_path, highlights_tracks, output_path, court_path);
+        }
+        
+        if (!compare_heatmap.empty()) {
+            return runComparison(video_path, model_path, names_path, yolo_config, compare_heatmap,
+                                 heatmap_config);
+        }
         
-        KalmanTracker ball_tracker(tracker_config);
+        if (archive_mode) {
+            return runArchive(video_path, output_path, model_path, names_path,
+                              yolo_config, tracker_config, pipeline_options, measure_energy);
+        }
+        
+        YoloDetector detector(model_path, names_path, yolo_config);
+        
+        // Detection + tracking pipeline
+        BallPipeline pipeline(detector, tracker_config, pipeline_options);
+        const KalmanTracker& ball_tracker = pipeline.tracker();
         
         // Initialize renderer
         ColorScheme colors;
         OverlayRenderer renderer(colors, 3, 0.5f);
         
         // Open video
-        cv::VideoCapture cap(video_path);
-        if (!cap.isOpened()) {
+        std::unique_ptr<io::FrameSource> source;
+        if (synthetic_input) {
+            source = std::make_unique<io::StampedSource>(raw_size, raw_fps, synthetic_frames);
+        } else if (raw_input) {
+            source = std::make_unique<io::RawYuvSource>(video_path, raw_size, raw_fps, raw_layout);
+        } else if (use_libav) {
+#ifdef BBST_HAVE_LIBAV
+            source = std::make_unique<io::LibavSource>(video_path);
+#else
+            std::cerr << "Error: Built without libav support" << std::endl;
+            return -1;
+#endif
+        } else {
+            source = std::make_unique<io::VideoFileSource>(video_path);
+        }
+        if (!source->isOpened()) {
             std::cerr << "Error: Cannot open video " << video_path << std::endl;
             return -1;
         }
         
         // Get video properties
-        int frame_width = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
-        int frame_height = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
-        double fps = cap.get(cv::CAP_PROP_FPS);
-        int total_frames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));
+        int frame_width = source->frameSize().width;
+        int frame_height = source->frameSize().height;
+        double fps = source->fps();
+        int total_frames = source->frameCount();
         
         std::cout << "Video: " << frame_width << "x" << frame_height 
                   << " @ " << fps << "fps, " << total_frames << " frames" << std::endl;
         
-        // Setup video writer for output
-        cv::VideoWriter out;
-        int codec = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
-        out.open(output_path, codec, fps, cv::Size(frame_width, frame_height));
-        
-        if (!out.isOpened()) {
-            std::cerr << "Warning: Could not create output video" << std::endl;
-            return -1;
-        }
-        
-        std::cout << "Output will be saved to: " << output_path << std::endl;
-        std::cout << "Processing video... Press 'q' to quit" << std::endl;
-        
         // Load class names
         std::vector<std::string> class_names;
         std::ifstream names_file(names_path);
@@ -79,118 +683,191 @@ int main(int argc, char** argv) {
             class_names.push_back(line);
         }
         
+        // Setup output: either a rendered video or the overlay sidecar, never both
+        cv::VideoWriter out;
+        std::unique_ptr<io::SegmentedVideoWriter> segmented;
+        std::unique_ptr<io::OverlaySidecarWriter> sidecar;
+        if (overlay_sidecar) {
+            sidecar = std::make_unique<io::OverlaySidecarWriter>(
+                output_path, cv::Size(frame_width, frame_height), fps, class_names, colors);
+        } else if (segmented_output) {
+            segmented = std::make_unique<io::SegmentedVideoWriter>(
+                output_path, cv::Size(frame_width, frame_height), fps, segment_config);
+        } else {
+            int codec = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+            out.open(output_path, codec, fps, cv::Size(frame_width, frame_height));
+            
+            if (!out.isOpened()) {
+                std::cerr << "Warning: Could not create output video" << std::endl;
+                return -1;
+            }
+        }
+        
+        std::cout << "Output will be saved to: " << output_path << std::endl;
+        std::cout << "Processing video... Press 'q' to quit" << std::endl;
+        
         int frame_count = 0;
         double total_inference_time = 0.0;
+        int burst_frames = 0;
+        int makes = 0;
+        int misses = 0;
+        int passes = 0;
+        
+        // Stamped frames are timed from capture until they leave the pipeline
+        std::unique_ptr<io::LatencyProbe> latency_probe;
+        if (synthetic_input) {
+            latency_probe = std::make_unique<io::LatencyProbe>();
+        }
+        
+        // Started after model loading so only frame processing is counted
+        std::unique_ptr<util::EnergyMeter> energy_meter;
+        if (measure_energy) {
+            energy_meter = std::make_unique<util::EnergyMeter>();
+            if (!energy_meter->available()) {
+                std::cerr << "Warning: RAPL energy counters are not readable "
+                          << "(needs root or read access to /sys/class/powercap)" << std::endl;
+            }
+        }
         
         cv::Mat frame;
-        while (cap.read(frame)) {
+        io::YuvFrame yuv;
+        const bool use_yuv = source->supportsYuv();
+        analysis::MotionCues motion_cues;
+        while (true) {
+            // BGR is only needed for rendering; the detector reads YUV directly
+            cv::Mat luma;
+            {
+                BBST_PROFILE_ZONE("decode");
+                util::MemoryScope memory(util::MemTag::Decode);
+                if (!(use_yuv ? source->readYuv(yuv) : source->read(frame))) break;
+                if (use_yuv) {
+                    yuv.toBgr(frame);
+                    luma = yuv.luma();
+                }
+            }
             frame_count++;
             auto start = cv::getTickCount();
             
-            // Predict ball position
-            cv::Point2f predicted_pos = ball_tracker.predict();
+            // Derived images (gray, thumbnails, pyramid) shared by all consumers of this frame
+            FrameContext ctx(frame, luma, frame_count - 1, source->timestampMs());
             
-            // Detect objects
-            auto detections = detector.detect(frame);
+            // Codec motion vectors, when the source exports them
+            analysis::MotionSummary motion;
+            if (const io::MotionField* field = source->motionField()) {
+                BBST_PROFILE_ZONE("motion");
+                motion = motion_cues.analyze(*field);
+            }
             
-            // Draw all detections with bounding boxes and labels
-            for (const auto& det : detections) {
-                std::string class_name = "Unknown";
-                if (det.class_id < static_cast<int>(class_names.size())) {
-                    class_name = class_names[det.class_id];
-                }
-                renderer.drawDetection(frame, det, class_name);
+            // Predict, detect, associate and update the tracker
+            FrameResult result = pipeline.process(ctx, use_yuv ? &yuv : nullptr,
+                                                  motion.valid ? &motion : nullptr);
+            const auto& detections = result.detections;
+            burst_frames += result.rim_burst ? 1 : 0;
+            if (result.outcome != analysis::ShotOutcome::None) {
+                (result.outcome == analysis::ShotOutcome::Make ? makes : misses)++;
+                std::cout << "Frame " << frame_count << ": "
+                          << analysis::shotOutcomeName(result.outcome);
+                if (result.shooter >= 0) std::cout << " by player " << result.shooter;
+                std::cout << std::endl;
+            }
+            for (const auto& event : result.possession) {
+                if (event.type != analysis::PossessionEventType::Pass) continue;
+                passes++;
+                std::cout << "Frame " << event.frame + 1 << ": pass " << event.from
+                          << " -> " << event.player << std::endl;
             }
             
-            // Find best basketball detection
-            Detection<>* best_ball = nullptr;
-            float best_confidence = 0.0f;
-            float best_distance = FLT_MAX;
+            const bool draw_trail = ball_tracker.isActive() && ball_tracker.isStable();
             
-            for (auto& det : detections) {
-                if (det.class_id == 0 || det.class_id == 2) {  // basketball or sports ball
-                    float size = (det.box.width + det.box.height) / 2.0f;
-                    float aspect_ratio = static_cast<float>(det.box.width) / det.box.height;
-                    
-                    // Validate aspect ratio
-                    if (aspect_ratio < tracker_config.min_aspect_ratio || 
-                        aspect_ratio > tracker_config.max_aspect_ratio) {
-                        continue;
+            // Sidecar mode: the player draws the overlays, nothing is rendered or encoded
+            if (sidecar) {
+                sidecar->write(result, draw_trail ? &ball_tracker.getTrajectory() : nullptr);
+                total_inference_time += (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+            } else {
+                BBST_PROFILE_ZONE("render");
+                util::MemoryScope memory(util::MemTag::Render);
+                
+                // Draw all detections with bounding boxes and labels
+                for (const auto& det : detections) {
+                    if (det.class_id == person_class) continue;  // Drawn as player tracks below
+                    std::string class_name = "Unknown";
+                    if (det.class_id < static_cast<int>(class_names.size())) {
+                        class_name = class_names[det.class_id];
                     }
-                    
-                    // Validate size
-                    if (size < tracker_config.min_ball_size || 
-                        size > tracker_config.max_ball_size) {
-                        continue;
+                    renderer.drawDetection(frame, det, class_name);
+                }
+                
+                for (const auto& player : result.players) {
+                    Detection<> det;
+                    det.class_id = person_class;
+                    det.box = cv::Rect(player.box);
+                    renderer.drawDetection(frame, det, "Player " + std::to_string(player.id) +
+                                           (player.id == result.holder ? " (ball)" : ""));
+                }
+                
+                // Draw trajectory if active and stable
+                if (draw_trail) {
+                    renderer.drawTrajectory(frame, ball_tracker.getTrajectory());
+                }
+                
+                // Calculate timing
+                auto end = cv::getTickCount();
+                double freq = cv::getTickFrequency() / 1000.0;
+                double processing_time = (end - start) / freq;
+                total_inference_time += processing_time;
+                double processing_fps = 1000.0 / processing_time;
+                
+                // Draw info overlay
+                std::stringstream info_ss;
+                info_ss << "Frame: " << frame_count << "/" << total_frames 
+                        << " | " << std::fixed << std::setprecision(1) 
+                        << processing_time << "ms"
+                        << " | " << processing_fps << "fps"
+                        << " | Det: " << detections.size()
+                        << " | In: " << detector.getInputSize().width
+                        << " | Track: " << (ball_tracker.isActive() ? "Active" : "Lost");
+                if (result.tracking) {
+                    const auto& kin = result.kinematics;
+                    if (kin.calibrated()) {
+                        info_ss << " | " << kin.speedMps() << "m/s";
+                    } else {
+                        info_ss << " | " << kin.speed << "px/s";
                     }
-                    
-                    if (ball_tracker.isActive()) {
-                        float distance = cv::norm(det.center - predicted_pos);
-                        float max_search_radius = tracker_config.max_velocity * 4.0f;
-                        
-                        if (distance < max_search_radius) {
-                            float score = det.confidence * 100.0f - distance * 0.5f;
-                            float current_best = best_confidence * 100.0f - best_distance * 0.5f;
-                            
-                            if (score > current_best) {
-                                best_distance = distance;
-                                best_confidence = det.confidence;
-                                best_ball = &det;
-                            }
-                        }
+                }
+                
+                renderer.drawInfo(frame, info_ss.str(), cv::Point(10, 22));
+                
+                // Write frame to output video
+                {
+                    BBST_PROFILE_ZONE("encode");
+                    if (segmented) {
+                        segmented->write(frame);
                     } else {
-                        if (det.confidence > best_confidence) {
-                            best_confidence = det.confidence;
-                            best_ball = &det;
-                        }
+                        out.write(frame);
                     }
                 }
             }
-            
-            // Update tracker
-            if (best_ball != nullptr) {
-                float size = (best_ball->box.width + best_ball->box.height) / 2.0f;
-                ball_tracker.update(best_ball->center, size);
-            } else {
-                ball_tracker.updateWithoutMeasurement();
-            }
-            
-            // Draw trajectory if active and stable
-            if (ball_tracker.isActive() && ball_tracker.isStable()) {
-                renderer.drawTrajectory(frame, ball_tracker.getTrajectory());
+            if (latency_probe) {
+                latency_probe->observe(frame);
             }
             
-            // Calculate timing
-            auto end = cv::getTickCount();
-            double freq = cv::getTickFrequency() / 1000.0;
-            double processing_time = (end - start) / freq;
-            total_inference_time += processing_time;
-            double processing_fps = 1000.0 / processing_time;
-            
-            // Draw info overlay
-            std::stringstream info_ss;
-            info_ss << "Frame: " << frame_count << "/" << total_frames 
-                    << " | " << std::fixed << std::setprecision(1) 
-                    << processing_time << "ms"
-                    << " | " << processing_fps << "fps"
-                    << " | Det: " << detections.size()
-                    << " | Track: " << (ball_tracker.isActive() ? "Active" : "Lost");
-            
-            renderer.drawInfo(frame, info_ss.str(), cv::Point(10, 22));
-            
-            // Write frame to output video
-            out.write(frame);
-            
             // Display frame
-            cv::imshow("Basketball Tracking", frame);
+            if (!sidecar) {
+                cv::imshow("Basketball Tracking", frame);
+                
+                if (cv::waitKey(1) == 'q') {
+                    std::cout << "\nStopped by user" << std::endl;
+                    break;
+                }
+            }
             
-            if (cv::waitKey(1) == 'q') {
-                std::cout << "\nStopped by user" << std::endl;
-                break;
+            // Fold in RAPL progress before the counters can wrap
+            if (energy_meter && frame_count % 30 == 0) {
+                energy_meter->update();
             }
             
             // Progress update
-            if (frame_count % 30 == 0) {
+            if (frame_count % 30 == 0 && total_frames > 0) {
                 double progress = (static_cast<double>(frame_count) / total_frames) * 100.0;
                 std::cout << "Progress: " << std::fixed << std::setprecision(1) 
                          << progress << "% (" << frame_count << "/" 
@@ -199,9 +876,19 @@ int main(int argc, char** argv) {
         }
         
         // Cleanup
-        cap.release();
-        out.release();
-        cv::destroyAllWindows();
+        int capture_dropped = synthetic_input
+            ? static_cast<const io::StampedSource&>(*source).dropped() : 0;
+        source.reset();
+        if (sidecar) {
+            sidecar->flush();
+        } else {
+            if (segmented) {
+                std::cout << "Joining encoded segments..." << std::endl;
+                segmented->close();
+            }
+            out.release();
+            cv::destroyAllWindows();
+        }
         
         // Print statistics
         double avg_time = total_inference_time / frame_count;
@@ -213,6 +900,22 @@ int main(int argc, char** argv) {
                   << avg_time << "ms" << std::endl;
         std::cout << "Avg FPS: " << std::setprecision(1) 
                   << (1000.0 / avg_time) << std::endl;
+        if (energy_meter) {
+            std::cout << "Energy: " << util::formatEnergy(energy_meter->read(), frame_count)
+                      << std::endl;
+        }
+        if (rim_burst) {
+            std::cout << "Rim bursts: " << burst_frames << " frames, shots: " << makes
+                      << " made / " << (makes + misses) << std::endl;
+        }
+        if (person_class >= 0) {
+            std::cout << "Passes: " << passes << std::endl;
+        }
+        if (latency_probe) {
+            std::cout << "Latency (capture to output): " << latency_probe->stats().summary() << std::endl;
+            std::cout << "Dropped at capture: " << capture_dropped
+                      << ", unreadable stamps: " << latency_probe->unreadable() << std::endl;
+        }
         std::cout << "Output saved to: " << output_path << std::endl;
         std::cout << std::string(50, '=') << std::endl;
         
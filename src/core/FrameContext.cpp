@@ -0,0 +1,93 @@
+#include "core/FrameContext.hpp"
+#include <algorithm>
+#include <bitset>
+
+namespace bbst {
+
+FrameContext::FrameContext(const cv::Mat& frame,
+                           int64_t index,
+                           double timestamp_ms,
+                           int pyramid_levels)
+    : frame_(frame)
+    , index_(index)
+    , timestamp_ms_(timestamp_ms)
+    , pyramid_levels_(std::max(1, pyramid_levels))
+    , dhash_(0)
+{
+}
+
+FrameContext::FrameContext(const cv::Mat& frame,
+                           const cv::Mat& luma,
+                           int64_t index,
+                           double timestamp_ms,
+                           int pyramid_levels)
+    : FrameContext(frame, index, timestamp_ms, pyramid_levels)
+{
+    CV_Assert(luma.empty() || luma.type() == CV_8UC1);
+    gray_ = luma;
+}
+
+const cv::Mat& FrameContext::gray() const {
+    std::call_once(gray_once_, [this]() {
+        if (!gray_.empty()) {
+            return;  // Seeded from a luma plane
+        }
+        if (frame_.channels() == 1) {
+            gray_ = frame_;
+        } else if (frame_.channels() == 4) {
+            cv::cvtColor(frame_, gray_, cv::COLOR_BGRA2GRAY);
+        } else {
+            cv::cvtColor(frame_, gray_, cv::COLOR_BGR2GRAY);
+        }
+    });
+    return gray_;
+}
+
+const cv::Mat& FrameContext::half() const {
+    std::call_once(half_once_, [this]() {
+        const cv::Mat& src = gray();
+        cv::resize(src, half_, cv::Size((src.cols + 1) / 2, (src.rows + 1) / 2),
+                   0, 0, cv::INTER_AREA);
+    });
+    return half_;
+}
+
+const cv::Mat& FrameContext::quarter() const {
+    std::call_once(quarter_once_, [this]() {
+        const cv::Mat& src = half();
+        cv::resize(src, quarter_, cv::Size((src.cols + 1) / 2, (src.rows + 1) / 2),
+                   0, 0, cv::INTER_AREA);
+    });
+    return quarter_;
+}
+
+const std::vector<cv::Mat>& FrameContext::pyramid() const {
+    std::call_once(pyramid_once_, [this]() {
+        cv::buildPyramid(gray(), pyramid_, pyramid_levels_ - 1);
+    });
+    return pyramid_;
+}
+
+uint64_t FrameContext::dHash() const {
+    std::call_once(dhash_once_, [this]() {
+        // Thumbnail from the smallest cached level keeps this cheap
+        cv::Mat thumb;
+        cv::resize(quarter(), thumb, cv::Size(9, 8), 0, 0, cv::INTER_AREA);
+
+        uint64_t hash = 0;
+        for (int y = 0; y < 8; ++y) {
+            const uchar* row = thumb.ptr<uchar>(y);
+            for (int x = 0; x < 8; ++x) {
+                hash = (hash << 1) | (row[x] < row[x + 1] ? 1u : 0u);
+            }
+        }
+        dhash_ = hash;
+    });
+    return dhash_;
+}
+
+int FrameContext::hammingDistance(uint64_t a, uint64_t b) {
+    return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+} // namespace bbst
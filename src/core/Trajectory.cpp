@@ -0,0 +1,11 @@
+#include "core/Trajectory.hpp"
+#include "util/MemoryStats.hpp"
+
+namespace bbst {
+
+Trajectory::Trajectory(size_t max_len)
+    : Trajectory(max_len, util::taggedResource(util::MemTag::Tracking))
+{
+}
+
+} // namespace bbst
@@ -0,0 +1,275 @@
+#include "detectors/HeatmapDetector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace bbst {
+
+HeatmapDetector::HeatmapDetector(const std::string& model_path,
+                                 const std::string& class_names_path,
+                                 const HeatmapConfig& config)
+    : BaseDetector(config.confidence_threshold)
+    , config_(config)
+    , has_sizes_(false)
+    , has_offsets_(false)
+{
+    try {
+        net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNetFromONNX(model_path));
+        configureBackend(*net_);
+        
+        if (!class_names_path.empty()) {
+            loadClassNames(class_names_path);
+        }
+    } catch (const cv::Exception& e) {
+        throw std::runtime_error("Failed to load heatmap model: " + std::string(e.what()));
+    }
+    
+    // Outputs are picked by name; a single-output model is a bare heatmap
+    std::vector<cv::String> outputs = net_->getUnconnectedOutLayersNames();
+    if (outputs.empty()) {
+        throw std::runtime_error("Heatmap model has no outputs: " + model_path);
+    }
+    auto has = [&](const std::string& name) {
+        return std::find(outputs.begin(), outputs.end(), name) != outputs.end();
+    };
+    output_names_.push_back(has(config_.heatmap_output) ? config_.heatmap_output : outputs[0]);
+    has_sizes_ = has(config_.size_output);
+    has_offsets_ = has(config_.offset_output);
+    if (has_sizes_) output_names_.push_back(config_.size_output);
+    if (has_offsets_) output_names_.push_back(config_.offset_output);
+}
+
+void HeatmapDetector::warmUp() {
+    // The first forward allocates every layer buffer
+    const int shape[] = {1, 3, static_cast<int>(config_.input_height), static_cast<int>(config_.input_width)};
+    runInference(cv::Mat(4, shape, CV_32F, cv::Scalar(0)));
+}
+
+cv::Mat HeatmapDetector::preProcess(const cv::Mat& frame) {
+    cv::Mat blob;
+    cv::dnn::blobFromImage(frame, blob, 1.0/255.0,
+                          cv::Size(config_.input_width, config_.input_height),
+                          cv::Scalar(), true, false);
+    return blob;
+}
+
+std::vector<cv::Mat> HeatmapDetector::runInference(const cv::Mat& blob) {
+    net_->setInput(blob);
+    std::vector<cv::Mat> outputs;
+    net_->forward(outputs, output_names_);
+    return outputs;
+}
+
+std::vector<Detection<>> HeatmapDetector::detect(const cv::Mat& frame) {
+    return postProcess(runInference(preProcess(frame)), frame);
+}
+
+std::vector<Detection<>> HeatmapDetector::detect(const cv::Mat& frame, const ClassMask& mask) {
+    return decodeOutputs(runInference(preProcess(frame)), frame.size(), mask);
+}
+
+std::vector<Detection<>> HeatmapDetector::postProcess(const std::vector<cv::Mat>& outputs,
+                                                      const cv::Mat& original_frame) {
+    return decodeOutputs(outputs, original_frame.size(), ClassMask::all());
+}
+
+std::vector<Detection<>> HeatmapDetector::decodeOutputs(const std::vector<cv::Mat>& outputs,
+                                                        const cv::Size& original_size,
+                                                        const ClassMask& mask) const {
+    if (outputs.empty()) return {};
+    
+    HeatmapConfig config = config_;
+    config.confidence_threshold = confidence_threshold_;
+    size_t next = 1;
+    cv::Mat sizes = has_sizes_ && next < outputs.size() ? outputs[next++] : cv::Mat();
+    cv::Mat offsets = has_offsets_ && next < outputs.size() ? outputs[next++] : cv::Mat();
+    return decode(outputs[0], sizes, offsets, config, original_size, mask);
+}
+
+// Channels, rows and cols of a [C, H, W] or [1, C, H, W] blob (or a 2D plane)
+static bool planeShape(const cv::Mat& blob, int& channels, int& rows, int& cols) {
+    if (blob.empty() || blob.type() != CV_32F || !blob.isContinuous()) return false;
+    if (blob.dims == 2) {
+        channels = 1;
+        rows = blob.rows;
+        cols = blob.cols;
+    } else if (blob.dims == 3 || (blob.dims == 4 && blob.size[0] == 1)) {
+        const int first = blob.dims - 3;
+        channels = blob.size[first];
+        rows = blob.size[first + 1];
+        cols = blob.size[first + 2];
+    } else {
+        return false;
+    }
+    return channels > 0 && rows > 0 && cols > 0;
+}
+
+static cv::Mat plane(const cv::Mat& blob, int channel, int rows, int cols) {
+    float* data = const_cast<float*>(blob.ptr<float>()) + static_cast<size_t>(channel) * rows * cols;
+    return cv::Mat(rows, cols, CV_32F, data);
+}
+
+// Vertex of the parabola through (-1, left), (0, centre), (1, right)
+static float parabolaOffset(float left, float centre, float right) {
+    const float curvature = left - 2.0f * centre + right;
+    if (curvature >= 0.0f) return 0.0f;
+    return std::clamp(0.5f * (left - right) / curvature, -0.5f, 0.5f);
+}
+
+// Mark the connected (8-neighbour) plateau of local maxima around (x, y)
+static void fillPlateau(const cv::Mat& scores, const cv::Mat& pooled, int x, int y,
+                        std::vector<uint8_t>& visited) {
+    const float v = scores.at<float>(y, x);
+    std::vector<cv::Point> stack = {cv::Point(x, y)};
+    visited[y * scores.cols + x] = 1;
+    while (!stack.empty()) {
+        const cv::Point p = stack.back();
+        stack.pop_back();
+        for (int ny = std::max(0, p.y - 1); ny <= std::min(scores.rows - 1, p.y + 1); ++ny) {
+            for (int nx = std::max(0, p.x - 1); nx <= std::min(scores.cols - 1, p.x + 1); ++nx) {
+                uint8_t& seen = visited[ny * scores.cols + nx];
+                if (seen || scores.at<float>(ny, nx) != v || pooled.at<float>(ny, nx) != v) continue;
+                seen = 1;
+                stack.emplace_back(nx, ny);
+            }
+        }
+    }
+}
+
+std::vector<HeatmapPeak> HeatmapDetector::findPeaks(const cv::Mat& heatmap, float threshold,
+                                                    int top_k, const ClassMask& mask) {
+    std::vector<HeatmapPeak> peaks;
+    int channels = 0, rows = 0, cols = 0;
+    if (top_k <= 0 || !planeShape(heatmap, channels, rows, cols)) return peaks;
+    
+    cv::Mat pooled;
+    std::vector<uint8_t> visited;      // Plateau cells already covered, allocated on demand
+    for (int c = 0; c < channels; ++c) {
+        if (!mask.contains(c)) continue;
+        
+        // 3x3 max-pool; the default border never wins against a real value
+        cv::Mat scores = plane(heatmap, c, rows, cols);
+        cv::dilate(scores, pooled, cv::Mat());
+        visited.clear();
+        
+        for (int y = 0; y < rows; ++y) {
+            const float* row = scores.ptr<float>(y);
+            const float* pooled_row = pooled.ptr<float>(y);
+            for (int x = 0; x < cols; ++x) {
+                const float v = row[x];
+                if (v < threshold || v != pooled_row[x]) continue;
+                
+                // A plateau is one peak, at its first cell in scan order; the
+                // fill covers any shape (a U would otherwise give two peaks)
+                bool plateau = false;
+                for (int ny = std::max(0, y - 1); ny <= std::min(rows - 1, y + 1) && !plateau; ++ny) {
+                    for (int nx = std::max(0, x - 1); nx <= std::min(cols - 1, x + 1); ++nx) {
+                        if ((nx != x || ny != y) && scores.at<float>(ny, nx) == v) plateau = true;
+                    }
+                }
+                if (plateau) {
+                    if (visited.empty()) visited.assign(static_cast<size_t>(rows) * cols, 0);
+                    if (visited[y * cols + x]) continue;
+                    fillPlateau(scores, pooled, x, y, visited);
+                }
+                
+                HeatmapPeak peak;
+                peak.class_id = c;
+                peak.score = v;
+                peak.cell = cv::Point(x, y);
+                peaks.push_back(peak);
+            }
+        }
+    }
+    
+    // Strongest first; ties by class then scan order so results are stable
+    auto stronger = [](const HeatmapPeak& a, const HeatmapPeak& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.class_id != b.class_id) return a.class_id < b.class_id;
+        return a.cell.y != b.cell.y ? a.cell.y < b.cell.y : a.cell.x < b.cell.x;
+    };
+    if (peaks.size() > static_cast<size_t>(top_k)) {
+        std::nth_element(peaks.begin(), peaks.begin() + top_k, peaks.end(), stronger);
+        peaks.resize(top_k);
+    }
+    std::sort(peaks.begin(), peaks.end(), stronger);
+    
+    // Sub-pixel refinement, only for the survivors
+    for (auto& peak : peaks) {
+        cv::Mat scores = plane(heatmap, peak.class_id, rows, cols);
+        const int x = peak.cell.x;
+        const int y = peak.cell.y;
+        float dx = 0.0f, dy = 0.0f;
+        if (x > 0 && x < cols - 1) {
+            dx = parabolaOffset(scores.at<float>(y, x - 1), peak.score, scores.at<float>(y, x + 1));
+        }
+        if (y > 0 && y < rows - 1) {
+            dy = parabolaOffset(scores.at<float>(y - 1, x), peak.score, scores.at<float>(y + 1, x));
+        }
+        peak.position = cv::Point2f(x + 0.5f + dx, y + 0.5f + dy);
+    }
+    return peaks;
+}
+
+std::vector<Detection<>> HeatmapDetector::decode(const cv::Mat& heatmap, const cv::Mat& sizes,
+                                                 const cv::Mat& offsets, const HeatmapConfig& config,
+                                                 const cv::Size& original_size,
+                                                 const ClassMask& mask) {
+    std::vector<Detection<>> detections;
+    int channels = 0, rows = 0, cols = 0;
+    if (!planeShape(heatmap, channels, rows, cols)) return detections;
+    
+    // Sigmoid is monotonic: threshold and pool the logits, convert survivors
+    float threshold = config.confidence_threshold;
+    if (config.logits) {
+        const float p = std::clamp(threshold, 1e-6f, 1.0f - 1e-6f);
+        threshold = std::log(p / (1.0f - p));
+    }
+    std::vector<HeatmapPeak> peaks = findPeaks(heatmap, threshold, config.top_k, mask);
+    
+    // Side maps must match the heatmap grid to be used
+    int map_channels = 0, map_rows = 0, map_cols = 0;
+    const bool use_sizes = planeShape(sizes, map_channels, map_rows, map_cols) &&
+                           map_channels >= 2 && map_rows == rows && map_cols == cols;
+    const bool use_offsets = planeShape(offsets, map_channels, map_rows, map_cols) &&
+                             map_channels >= 2 && map_rows == rows && map_cols == cols;
+    
+    const float stride_x = config.input_width / cols;
+    const float stride_y = config.input_height / rows;
+    const float x_factor = original_size.width / config.input_width;
+    const float y_factor = original_size.height / config.input_height;
+    
+    for (const auto& peak : peaks) {
+        const int index = peak.cell.y * cols + peak.cell.x;
+        const size_t plane_size = static_cast<size_t>(rows) * cols;
+        
+        cv::Point2f position = peak.position;
+        if (use_offsets) {
+            const float* offset = offsets.ptr<float>();
+            position = cv::Point2f(peak.cell.x + offset[index], peak.cell.y + offset[plane_size + index]);
+        }
+        
+        float width = config.default_size;
+        float height = config.default_size;
+        if (use_sizes) {
+            const float* size = sizes.ptr<float>();
+            width = size[index] * (config.size_in_cells ? stride_x : 1.0f);
+            height = size[plane_size + index] * (config.size_in_cells ? stride_y : 1.0f);
+        }
+        
+        const float cx = position.x * stride_x * x_factor;
+        const float cy = position.y * stride_y * y_factor;
+        width *= x_factor;
+        height *= y_factor;
+        
+        Detection<> det;
+        det.class_id = peak.class_id;
+        det.confidence = config.logits ? 1.0f / (1.0f + std::exp(-peak.score)) : peak.score;
+        det.box = cv::Rect(cvRound(cx - width / 2.0f), cvRound(cy - height / 2.0f),
+                           cvRound(width), cvRound(height));
+        det.center = cv::Point2f(cx, cy);
+        detections.push_back(det);
+    }
+    return detections;
+}
+
+} // namespace bbst
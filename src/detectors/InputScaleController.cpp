@@ -0,0 +1,86 @@
+#include "detectors/InputScaleController.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace bbst {
+
+InputScaleController::InputScaleController(const InputScaleConfig& config)
+    : config_(config)
+    , fallback_(config.default_size)
+    , current_(config.default_size)
+    , candidate_(config.default_size)
+    , streak_(0)
+    , lost_streak_(0)
+{
+    if (config_.sizes.empty()) {
+        throw std::invalid_argument("InputScaleController needs at least one size");
+    }
+    std::sort(config_.sizes.begin(), config_.sizes.end());
+    
+    if (std::find(config_.sizes.begin(), config_.sizes.end(), fallback_) == config_.sizes.end()) {
+        fallback_ = config_.sizes.back();
+    }
+    current_ = candidate_ = fallback_;
+}
+
+float InputScaleController::ballPixels(float ball_size, const cv::Size& frame_size,
+                                       int input_size) {
+    // Frames are stretched to a square input; the longer side shrinks most
+    int longest = std::max(frame_size.width, frame_size.height);
+    if (longest <= 0) return 0.0f;
+    return ball_size * static_cast<float>(input_size) / longest;
+}
+
+int InputScaleController::preferredSize(float ball_size, const cv::Size& frame_size) const {
+    for (int size : config_.sizes) {
+        float needed = config_.target_ball_pixels;
+        
+        // Sizes below the current one must clear the target with a margin
+        if (size < current_) {
+            needed *= 1.0f + config_.hysteresis;
+        }
+        if (ballPixels(ball_size, frame_size, size) >= needed) {
+            return size;
+        }
+    }
+    return config_.sizes.back();
+}
+
+int InputScaleController::update(float ball_size, const cv::Size& frame_size, bool tracking) {
+    // Lost ball: fall back to the default once it stays lost
+    if (!tracking || ball_size <= 0.0f) {
+        streak_ = 0;
+        candidate_ = current_;
+        if (++lost_streak_ >= config_.frames_to_fallback) {
+            current_ = candidate_ = fallback_;
+        }
+        return current_;
+    }
+    lost_streak_ = 0;
+    
+    int preferred = preferredSize(ball_size, frame_size);
+    
+    if (preferred == current_) {
+        streak_ = 0;
+        candidate_ = current_;
+        return current_;
+    }
+    
+    // Count consecutive votes for the same new size
+    if (preferred == candidate_) {
+        streak_++;
+    } else {
+        candidate_ = preferred;
+        streak_ = 1;
+    }
+    
+    int needed = preferred > current_ ? config_.frames_to_grow : config_.frames_to_shrink;
+    if (streak_ >= needed) {
+        current_ = candidate_;
+        streak_ = 0;
+    }
+    
+    return current_;
+}
+
+} // namespace bbst
@@ -1,5 +1,5 @@
 #include "detectors/YoloDetector.hpp"
-#include <fstream>
+#include "util/YuvToTensor.hpp"
 #include <iostream>
 #include <algorithm>
 
@@ -17,20 +17,17 @@ YoloDetector::YoloDetector(const std::string& model_path,
                            const YoloConfig& config)
     : BaseDetector(config.confidence_threshold)
     , config_(config)
+    , model_path_(model_path)
+    , base_size_(static_cast<int>(config.input_width), static_cast<int>(config.input_height))
+    , active_net_(-1)
+    , batch_inference_(true)
 {
     try {
         net_ = std::make_unique<cv::dnn::Net>(
             cv::dnn::readNetFromONNX(model_path)
         );
         
-        // Use GPU if available
-        if (cv::cuda::getCudaEnabledDeviceCount() > 0) {
-            net_->setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
-            net_->setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
-        } else {
-            net_->setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-            net_->setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-        }
+        configureBackend(*net_);
         
         if (!class_names_path.empty()) {
             loadClassNames(class_names_path);
@@ -41,17 +38,57 @@ YoloDetector::YoloDetector(const std::string& model_path,
     }
 }
 
-void YoloDetector::loadClassNames(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open class names file: " + path);
+void YoloDetector::warmUp(cv::dnn::Net& net, const cv::Size& size) {
+    // The first forward at a shape allocates every layer buffer
+    const int shape[] = {1, 3, size.height, size.width};
+    net.setInput(cv::Mat(4, shape, CV_32F, cv::Scalar(0)));
+    std::vector<cv::Mat> outputs;
+    net.forward(outputs, net.getUnconnectedOutLayersNames());
+}
+
+cv::dnn::Net& YoloDetector::activeNet() {
+    return active_net_ < 0 ? *net_ : *sized_nets_[active_net_].second;
+}
+
+void YoloDetector::prepareInputSizes(const std::vector<cv::Size>& sizes) {
+    try {
+        warmUp(*net_, base_size_);
+        
+        for (const auto& size : sizes) {
+            bool prepared = size == base_size_;
+            for (const auto& entry : sized_nets_) {
+                prepared = prepared || entry.first == size;
+            }
+            if (prepared) continue;
+            
+            auto net = std::make_unique<cv::dnn::Net>(cv::dnn::readNetFromONNX(model_path_));
+            configureBackend(*net);
+            warmUp(*net, size);
+            sized_nets_.emplace_back(size, std::move(net));
+        }
+    } catch (const cv::Exception& e) {
+        throw std::runtime_error("Model does not accept the requested input sizes: " +
+                                 std::string(e.what()));
     }
-    
-    class_names_.clear();
-    std::string line;
-    while (std::getline(file, line)) {
-        class_names_.push_back(line);
+}
+
+bool YoloDetector::setInputSize(const cv::Size& size) {
+    int index = -2;
+    if (size == base_size_) {
+        index = -1;
+    } else {
+        for (size_t i = 0; i < sized_nets_.size(); ++i) {
+            if (sized_nets_[i].first == size) {
+                index = static_cast<int>(i);
+            }
+        }
     }
+    if (index == -2) return false;
+    
+    active_net_ = index;
+    config_.input_width = static_cast<float>(size.width);
+    config_.input_height = static_cast<float>(size.height);
+    return true;
 }
 
 cv::Mat YoloDetector::formatYoloInput(const cv::Mat& source) {
@@ -62,39 +99,147 @@ cv::Mat YoloDetector::formatYoloInput(const cv::Mat& source) {
     return blob;
 }
 
+cv::Mat YoloDetector::formatYoloInput(const io::YuvFrame& source) {
+    // Resize, colour conversion and normalization in one pass
+    return util::YuvToTensor::toBlob(
+        source, cv::Size(config_.input_width, config_.input_height));
+}
+
 cv::Mat YoloDetector::preProcess(const cv::Mat& frame) {
     return formatYoloInput(frame);
 }
 
+std::vector<cv::Mat> YoloDetector::runInference(const cv::Mat& blob) {
+    cv::dnn::Net& net = activeNet();
+    net.setInput(blob);
+    std::vector<cv::Mat> outputs;
+    net.forward(outputs, net.getUnconnectedOutLayersNames());
+    return outputs;
+}
+
 std::vector<Detection<>> YoloDetector::detect(const cv::Mat& frame) {
     // Preprocess
     cv::Mat blob = preProcess(frame);
     
     // Run inference
-    net_->setInput(blob);
-    std::vector<cv::Mat> outputs;
-    net_->forward(outputs, net_->getUnconnectedOutLayersNames());
+    std::vector<cv::Mat> outputs = runInference(blob);
     
     // Postprocess
     return postProcess(outputs, frame);
 }
 
+std::vector<Detection<>> YoloDetector::detect(const cv::Mat& frame, const ClassMask& mask) {
+    cv::Mat output = prepareOutput(runInference(formatYoloInput(frame)));
+    if (output.empty()) return {};
+    
+    decoder_.scoreClasses(output, mask);
+    return decoder_.decodeScored(output, config_, frame.size());
+}
+
+std::vector<Detection<>> YoloDetector::detect(const cv::Mat& frame, const cv::Rect& roi,
+                                              const ClassMask& mask) {
+    cv::Rect clipped = roi & cv::Rect(0, 0, frame.cols, frame.rows);
+    if (clipped.empty()) return {};
+    
+    // frame(clipped) is a view; blobFromImage handles the row stride
+    std::vector<Detection<>> detections = detect(frame(clipped), mask);
+    offsetDetections(detections, clipped.tl());
+    return detections;
+}
+
+std::vector<std::vector<Detection<>>> YoloDetector::detectBatch(
+    const cv::Mat& frame, const std::vector<cv::Rect>& regions, const ClassMask& mask)
+{
+    std::vector<std::vector<Detection<>>> results(regions.size());
+    std::vector<cv::Mat> crops;
+    std::vector<size_t> crop_regions;
+    std::vector<cv::Point> crop_offsets;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        cv::Rect clipped = regions[i] & cv::Rect(0, 0, frame.cols, frame.rows);
+        if (clipped.empty()) continue;
+        crops.push_back(frame(clipped));
+        crop_regions.push_back(i);
+        crop_offsets.push_back(clipped.tl());
+    }
+    if (crops.empty()) return results;
+    
+    // One output plane [4 + classes, anchors] per batch entry
+    // (views into raw, which owns the data)
+    std::vector<cv::Mat> raw;
+    std::vector<cv::Mat> outputs;
+    if (batch_inference_ && crops.size() > 1) {
+        try {
+            cv::Mat blob;
+            cv::dnn::blobFromImages(crops, blob, 1.0/255.0,
+                                    cv::Size(config_.input_width, config_.input_height),
+                                    cv::Scalar(), true, false);
+            raw = runInference(blob);
+            if (!raw.empty() && raw[0].dims == 3 &&
+                raw[0].size[0] == static_cast<int>(crops.size())) {
+                for (size_t b = 0; b < crops.size(); ++b) {
+                    cv::Mat plane(raw[0].size[1], raw[0].size[2], CV_32F,
+                                  raw[0].ptr<float>(static_cast<int>(b)));
+                    outputs.push_back(prepareOutput({plane}));
+                }
+            } else {
+                batch_inference_ = false;
+            }
+        } catch (const cv::Exception&) {
+            batch_inference_ = false;
+        }
+    }
+    if (outputs.empty()) {
+        for (const auto& crop : crops) {
+            outputs.push_back(prepareOutput(runInference(formatYoloInput(crop))));
+        }
+    }
+    
+    for (size_t b = 0; b < crops.size(); ++b) {
+        if (outputs[b].empty()) continue;
+        
+        decoder_.scoreClasses(outputs[b], mask);
+        std::vector<Detection<>>& detections = results[crop_regions[b]];
+        detections = decoder_.decodeScored(outputs[b], config_, crops[b].size());
+        offsetDetections(detections, crop_offsets[b]);
+    }
+    return results;
+}
+
+void YoloDetector::offsetDetections(std::vector<Detection<>>& detections, const cv::Point& offset) {
+    for (auto& det : detections) {
+        det.box.x += offset.x;
+        det.box.y += offset.y;
+        det.center += cv::Point2f(static_cast<float>(offset.x), static_cast<float>(offset.y));
+    }
+}
+
+std::vector<Detection<>> YoloDetector::detect(const io::YuvFrame& frame, const ClassMask& mask) {
+    cv::Mat output = prepareOutput(runInference(formatYoloInput(frame)));
+    if (output.empty()) return {};
+    
+    decoder_.scoreClasses(output, mask);
+    return decoder_.decodeScored(output, config_, frameSize(frame));
+}
+
 std::vector<Detection<>> YoloDetector::postProcess(const std::vector<cv::Mat>& outputs,
                                                     const cv::Mat& original_frame) {
-    return parseYoloOutput(outputs, original_frame);
+    return parseYoloOutput(outputs, original_frame.size());
 }
 
 std::vector<Detection<>> YoloDetector::parseYoloOutput(
     const std::vector<cv::Mat>& outputs,
-    const cv::Mat& original_image) 
+    const cv::Size& original_size) 
 {
-    std::vector<int> class_ids;
-    std::vector<float> confidences;
-    std::vector<cv::Rect> boxes;
-    std::vector<Detection<>> detections;
+    cv::Mat output = prepareOutput(outputs);
+    if (output.empty()) return {};
     
+    decoder_.scoreClasses(output, ClassMask::all());
+    return decoder_.decodeScored(output, config_, original_size);
+}
+
+cv::Mat YoloDetector::prepareOutput(const std::vector<cv::Mat>& outputs) const {
     if (outputs.empty()) {
-        return detections;
+        return cv::Mat();
     }
     
     cv::Mat output = outputs[0];
@@ -105,59 +250,156 @@ std::vector<Detection<>> YoloDetector::parseYoloOutput(
     }
     
     // Debug output shape
-    std::cout << "Output shape: [" << output.rows << ", " << output.cols << "]" << std::endl;
+    if (config_.verbose) {
+        std::cout << "Output shape: [" << output.rows << ", " << output.cols << "]" << std::endl;
+        std::cout << "Detected " << output.rows - 4 << " classes in model" << std::endl;
+    }
+    
+    return output;
+}
+
+void YoloDecoder::resetScores(const cv::Mat& output) {
+    best_scores_.assign(output.cols, 0.0f);
+    best_ids_.assign(output.cols, -1);
+    scored_.assign(std::max(output.rows - 4, 0), 0);
+}
+
+void YoloDecoder::scoreClassRow(const cv::Mat& output, int class_id) {
+    // First 4 rows are bbox coords; ignore ids the model does not have
+    if (class_id < 0 || class_id >= output.rows - 4) return;
+    
+    // Each class row is contiguous, so the running max is a straight
+    // vectorizable pass; ties go to the lower id whatever the mask order
+    const float* scores = output.ptr<float>(4 + class_id);
+    const int num_anchors = output.cols;
+    scored_[class_id] = 1;
+    for (int i = 0; i < num_anchors; ++i) {
+        bool better = scores[i] > best_scores_[i] ||
+                      (scores[i] == best_scores_[i] && class_id < best_ids_[i]);
+        best_scores_[i] = better ? scores[i] : best_scores_[i];
+        best_ids_[i] = better ? class_id : best_ids_[i];
+    }
+}
+
+void YoloDecoder::scoreClasses(const cv::Mat& output, const ClassMask& mask) {
+    resetScores(output);
+    
+    if (mask.isAll()) {
+        for (int c = 0; c < output.rows - 4; ++c) {
+            scoreClassRow(output, c);
+        }
+    } else {
+        // Unselected class rows are never read
+        for (int c : mask.ids()) {
+            scoreClassRow(output, c);
+        }
+    }
+}
+
+bool YoloDecoder::outscored(const cv::Mat& output, int anchor, int class_id, float score) const {
+    for (int c = 0; c < static_cast<int>(scored_.size()); ++c) {
+        if (scored_[c]) continue;
+        const float other = output.at<float>(4 + c, anchor);
+        if (other > score || (other == score && c < class_id)) return true;
+    }
+    return false;
+}
+
+std::vector<Detection<>> YoloDecoder::decodeScored(const cv::Mat& output, const YoloConfig& config,
+                                                   const cv::Size& original_size) const {
+    std::vector<int> class_ids;
+    std::vector<float> confidences;
+    std::vector<cv::Rect> boxes;
+    std::vector<Detection<>> detections;
     
     int num_classes = output.rows - 4;  // First 4 rows are bbox coords
-    std::cout << "Detected " << num_classes << " classes in model" << std::endl;
-    
-    float x_factor = original_image.cols / static_cast<float>(config_.input_width);
-    float y_factor = original_image.rows / static_cast<float>(config_.input_height);
-    
-    // Iterate through detections (columns)
-    for (int i = 0; i < output.cols; ++i) {
-        // Get bbox coordinates (first 4 rows)
-        float cx = output.at<float>(0, i);
-        float cy = output.at<float>(1, i);
-        float w = output.at<float>(2, i);
-        float h = output.at<float>(3, i);
-        
-        // Get class scores (remaining rows)
-        float max_score = 0.0f;
-        int max_class_id = -1;
-        
-        for (int c = 0; c < num_classes; ++c) {
-            float score = output.at<float>(4 + c, i);
-            if (score > max_score) {
-                max_score = score;
-                max_class_id = c;
-            }
+    const int num_anchors = output.cols;
+    
+    float x_factor = original_size.width / static_cast<float>(config.input_width);
+    float y_factor = original_size.height / static_cast<float>(config.input_height);
+    
+    // Geometric priors indexed by class id (nullptr = unconstrained)
+    std::vector<const ClassPrior*> priors(num_classes, nullptr);
+    for (const auto& [class_id, prior] : config.class_priors) {
+        if (class_id >= 0 && class_id < num_classes) {
+            priors[class_id] = &prior;
         }
+    }
+    
+    const float* cx_row = output.ptr<float>(0);
+    const float* cy_row = output.ptr<float>(1);
+    const float* w_row = output.ptr<float>(2);
+    const float* h_row = output.ptr<float>(3);
+    
+    // With a mask, unscored rows are read only for anchors that pass the
+    // threshold, to drop those whose best class overall is outside it
+    const bool masked = std::find(scored_.begin(), scored_.end(), 0) != scored_.end();
+    
+    for (int i = 0; i < num_anchors; ++i) {
+        float max_score = best_scores_[i];
+        int max_class_id = best_ids_[i];
         
         // Filter by confidence threshold
-        if (max_score >= config_.confidence_threshold) {
-            // Convert from center format to corner format
-            float x = (cx - w / 2.0f) * x_factor;
-            float y = (cy - h / 2.0f) * y_factor;
-            float width = w * x_factor;
-            float height = h * y_factor;
-            
-            boxes.push_back(cv::Rect(
-                static_cast<int>(x),
-                static_cast<int>(y),
-                static_cast<int>(width),
-                static_cast<int>(height)
-            ));
-            confidences.push_back(max_score);
-            class_ids.push_back(max_class_id);
+        if (max_class_id < 0 || max_score < config.confidence_threshold) {
+            continue;
         }
+        if (masked && outscored(output, i, max_class_id, max_score)) {
+            continue;
+        }
+        
+        float width = w_row[i] * x_factor;
+        float height = h_row[i] * y_factor;
+        
+        // Reject implausible shapes before they reach NMS
+        const ClassPrior* prior = priors[max_class_id];
+        if (prior != nullptr && !prior->accepts(width, height)) {
+            continue;
+        }
+        
+        // Convert from center format to corner format
+        float x = cx_row[i] * x_factor - width / 2.0f;
+        float y = cy_row[i] * y_factor - height / 2.0f;
+        
+        boxes.push_back(cv::Rect(
+            static_cast<int>(x),
+            static_cast<int>(y),
+            static_cast<int>(width),
+            static_cast<int>(height)
+        ));
+        confidences.push_back(max_score);
+        class_ids.push_back(max_class_id);
     }
     
-    std::cout << "Before NMS: " << boxes.size() << " detections" << std::endl;
-    
-    // Apply NMS
-    std::vector<int> nms_result = performNMS(boxes, confidences);
+    // NMS per class, so a ball in front of the rim is not suppressed by it
+    // and a masked decode keeps the same boxes as an unmasked one
+    std::vector<int> nms_result;
+    std::vector<cv::Rect> class_boxes;
+    std::vector<float> class_confidences;
+    std::vector<int> class_indices;
+    std::vector<int> kept;
+    for (int class_id = 0; class_id < num_classes; ++class_id) {
+        class_boxes.clear();
+        class_confidences.clear();
+        class_indices.clear();
+        for (size_t j = 0; j < boxes.size(); ++j) {
+            if (class_ids[j] != class_id) continue;
+            class_boxes.push_back(boxes[j]);
+            class_confidences.push_back(confidences[j]);
+            class_indices.push_back(static_cast<int>(j));
+        }
+        if (class_boxes.empty()) continue;
+        cv::dnn::NMSBoxes(class_boxes, class_confidences, config.score_threshold,
+                          config.nms_threshold, kept);
+        for (int k : kept) nms_result.push_back(class_indices[k]);
+    }
+    std::sort(nms_result.begin(), nms_result.end(), [&](int a, int b) {
+        return confidences[a] != confidences[b] ? confidences[a] > confidences[b] : a < b;
+    });
     
-    std::cout << "After NMS: " << nms_result.size() << " detections" << std::endl;
+    if (config.verbose) {
+        std::cout << "Before NMS: " << boxes.size() << " detections" << std::endl;
+        std::cout << "After NMS: " << nms_result.size() << " detections" << std::endl;
+    }
     
     // Create Detection objects
     for (int idx : nms_result) {
@@ -175,12 +417,4 @@ std::vector<Detection<>> YoloDetector::parseYoloOutput(
     return detections;
 }
 
-std::vector<int> YoloDetector::performNMS(const std::vector<cv::Rect>& boxes,
-                                          const std::vector<float>& confidences) {
-    std::vector<int> indices;
-    cv::dnn::NMSBoxes(boxes, confidences, config_.score_threshold, 
-                     config_.nms_threshold, indices);
-    return indices;
-}
-
-} // namespace bbst
\ No newline at end of file
+} // namespace bbst
@@ -0,0 +1,88 @@
+#include "ingest/DirectoryWatcher.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace bbst::ingest {
+
+DirectoryWatcher::DirectoryWatcher()
+    : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    , buffer_(64 * 1024)
+{
+    if (fd_ < 0) {
+        throw std::runtime_error("inotify_init1 failed: " + std::string(std::strerror(errno)));
+    }
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    ::close(fd_);
+}
+
+void DirectoryWatcher::add(const std::string& dir, Priority priority) {
+    int wd = inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        throw std::runtime_error("Cannot watch " + dir + ": " + std::strerror(errno));
+    }
+    watches_[wd] = {dir, priority};
+}
+
+bool DirectoryWatcher::isVideoFile(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".mp4" || ext == ".mov" || ext == ".mkv" || ext == ".avi" || ext == ".ts";
+}
+
+std::vector<WatchEvent> DirectoryWatcher::poll(int timeout_ms) {
+    std::vector<WatchEvent> events;
+    
+    pollfd pfd{fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, timeout_ms) <= 0) {
+        return events;  // Timeout or EINTR (shutdown signal)
+    }
+    
+    ssize_t length;
+    while ((length = ::read(fd_, buffer_.data(), buffer_.size())) > 0) {
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer_.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+            
+            auto watch = watches_.find(event->wd);
+            if (watch == watches_.end() || event->len == 0 || (event->mask & IN_ISDIR)) {
+                continue;
+            }
+            
+            std::string path = (std::filesystem::path(watch->second.first) / event->name).string();
+            if (isVideoFile(path)) {
+                events.push_back({path, watch->second.second});
+            }
+        }
+    }
+    
+    return events;
+}
+
+std::vector<WatchEvent> DirectoryWatcher::scanExisting() const {
+    std::vector<WatchEvent> events;
+    for (const auto& [wd, watch] : watches_) {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(watch.first, ec)) {
+            if (entry.is_regular_file(ec) && isVideoFile(entry.path().string())) {
+                events.push_back({entry.path().string(), watch.second});
+            }
+        }
+    }
+    
+    // Sorted by name: drop folders usually carry timestamped names
+    std::sort(events.begin(), events.end(),
+              [](const WatchEvent& a, const WatchEvent& b) { return a.path < b.path; });
+    return events;
+}
+
+} // namespace bbst::ingest
@@ -0,0 +1,170 @@
+#include "ingest/IngestDaemon.hpp"
+#include "core/FrameContext.hpp"
+#include "io/FrameSource.hpp"
+#include "io/TrackCsvWriter.hpp"
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+namespace bbst::ingest {
+
+namespace fs = std::filesystem;
+
+IngestDaemon::IngestDaemon(const std::string& model_path,
+                           const std::string& names_path,
+                           const YoloConfig& yolo_config,
+                           const tracking::TrackerConfig& tracker_config,
+                           const pipeline::PipelineOptions& pipeline_options,
+                           const IngestConfig& config)
+    : model_path_(model_path)
+    , names_path_(names_path)
+    , yolo_config_(yolo_config)
+    , tracker_config_(tracker_config)
+    , pipeline_options_(pipeline_options)
+    , config_(config)
+    , journal_(config.journal_path, config.max_attempts)
+    , completed_(0)
+    , failed_(0)
+{
+    yolo_config_.verbose = false;
+    fs::create_directories(config_.output_dir);
+    
+    for (const auto& path : journal_.abandonedPaths()) {
+        std::cerr << "Abandoned after " << config_.max_attempts << " attempts: " << path << std::endl;
+    }
+}
+
+IngestDaemon::~IngestDaemon() {
+    queue_.close();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void IngestDaemon::watch(const std::string& dir, Priority priority) {
+    watcher_.add(dir, priority);
+    roots_.push_back(dir);
+}
+
+std::string IngestDaemon::outputPath(const std::string& video_path) const {
+    const fs::path video = fs::path(video_path).lexically_normal();
+    fs::path name = video.filename();
+    for (const auto& root : roots_) {
+        fs::path relative = video.lexically_relative(fs::path(root).lexically_normal());
+        if (!relative.empty() && *relative.begin() != "..") {
+            name = relative;
+            break;
+        }
+    }
+    return (fs::path(config_.output_dir) / name).string() + ".csv";
+}
+
+void IngestDaemon::submit(const WatchEvent& event, bool check_age) {
+    Priority priority = event.priority;
+    
+    // Catch-up scans find old files in the recent folder too
+    if (check_age && priority == Priority::Recent) {
+        std::error_code ec;
+        auto modified = fs::last_write_time(event.path, ec);
+        auto age = fs::file_time_type::clock::now() - modified;
+        if (!ec && age > std::chrono::hours(config_.recent_window_hours)) {
+            priority = Priority::Archive;
+        }
+    }
+    
+    if (auto job = journal_.enqueue(event.path, priority)) {
+        std::cout << "Queued [" << priorityName(job->priority) << "] " << job->path << std::endl;
+        queue_.push(*job);
+    }
+}
+
+void IngestDaemon::processJob(YoloDetector& detector, const Job& job) {
+    io::VideoFileSource source(job.path);
+    if (!source.isOpened()) {
+        throw std::runtime_error("Cannot open video " + job.path);
+    }
+    
+    // Written under a temporary name: a partial file is never mistaken for output
+    const std::string output = outputPath(job.path);
+    const std::string partial = output + ".part";
+    fs::create_directories(fs::path(output).parent_path());
+    try {
+        io::TrackCsvWriter writer(partial);
+        pipeline::BallPipeline pipeline(detector, tracker_config_, pipeline_options_);
+        
+        cv::Mat frame;
+        int64_t index = 0;
+        while (source.read(frame)) {
+            FrameContext ctx(frame, index++, source.timestampMs());
+            writer.write(pipeline.process(ctx));
+        }
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(partial, ec);
+        throw;
+    }
+    fs::rename(partial, output);
+}
+
+void IngestDaemon::workerLoop(int worker_id) {
+    util::ProfiledThread profiled;
+    YoloDetector& detector = *detectors_[worker_id];
+    
+    while (auto job = queue_.pop()) {
+        journal_.markStarted(*job);
+        auto start = std::chrono::steady_clock::now();
+        
+        try {
+            processJob(detector, *job);
+            journal_.markDone(*job);
+            completed_++;
+            
+            double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            std::cout << "[worker " << worker_id << "] Done " << job->path
+                      << " in " << seconds << "s" << std::endl;
+        } catch (const std::exception& e) {
+            journal_.markFailed(*job);
+            failed_++;
+            std::cerr << "[worker " << worker_id << "] Failed " << job->path
+                      << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+void IngestDaemon::run(const std::atomic<bool>& stop) {
+    // One model per worker, loaded up front and reused for every clip
+    // (cv::dnn::Net is not thread-safe; loading per clip dominates short clips)
+    const int workers = std::max(1, config_.workers);
+    while (static_cast<int>(detectors_.size()) < workers) {
+        detectors_.push_back(std::make_unique<YoloDetector>(model_path_, names_path_, yolo_config_));
+    }
+    
+    // Work left over from the previous session keeps its id and priority
+    for (const auto& job : journal_.pendingJobs()) {
+        queue_.push(job);
+    }
+    for (const auto& event : watcher_.scanExisting()) {
+        submit(event, true);
+    }
+    
+    for (int w = 0; w < workers; ++w) {
+        workers_.emplace_back(&IngestDaemon::workerLoop, this, w);
+    }
+    
+    while (!stop) {
+        for (const auto& event : watcher_.poll(config_.poll_interval_ms)) {
+            submit(event, false);
+        }
+    }
+    
+    queue_.close();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+} // namespace bbst::ingest
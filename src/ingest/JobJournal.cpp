@@ -0,0 +1,210 @@
+#include "ingest/JobJournal.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+namespace bbst::ingest {
+
+JobJournal::JobJournal(const std::string& path, int max_attempts)
+    : path_(path)
+    , next_id_(1)
+    , max_attempts_(max_attempts)
+{
+    replay();
+    compact();
+    
+    out_.open(path_, std::ios::app);
+    if (!out_.is_open()) {
+        throw std::runtime_error("Cannot open job journal: " + path_);
+    }
+}
+
+void JobJournal::applyRecord(const std::string& line) {
+    if (line.size() < 3 || line[1] != '\t') return;
+    
+    std::istringstream fields(line.substr(2));
+    std::string id_field;
+    
+    switch (line[0]) {
+        case 'E': {
+            Job job;
+            std::string priority_field, attempts_field;
+            std::getline(fields, id_field, '\t');
+            std::getline(fields, priority_field, '\t');
+            std::getline(fields, attempts_field, '\t');
+            std::getline(fields, job.path);
+            if (job.path.empty()) return;
+            
+            job.id = std::stoull(id_field);
+            job.priority = static_cast<Priority>(std::stoi(priority_field));
+            job.attempts = std::stoi(attempts_field);
+            pending_[job.id] = job;
+            known_paths_.insert(job.path);
+            next_id_ = std::max(next_id_, job.id + 1);
+            break;
+        }
+        case 'S': {
+            std::getline(fields, id_field);
+            auto it = pending_.find(std::stoull(id_field));
+            if (it != pending_.end()) it->second.attempts++;
+            break;
+        }
+        case 'D': {
+            std::getline(fields, id_field);
+            auto it = pending_.find(std::stoull(id_field));
+            if (it != pending_.end()) {
+                failures_.erase(it->second.path);
+                pending_.erase(it);
+            }
+            break;
+        }
+        case 'F': {
+            std::getline(fields, id_field);
+            auto it = pending_.find(std::stoull(id_field));
+            if (it != pending_.end()) {
+                recordFailure(it->second.path);
+                pending_.erase(it);
+            }
+            break;
+        }
+        case 'K':
+            known_paths_.insert(line.substr(2));
+            break;
+        case 'X': {
+            std::string failures_field, path;
+            std::getline(fields, failures_field, '\t');
+            std::getline(fields, path);
+            if (path.empty()) return;
+            
+            const int failures = std::stoi(failures_field);
+            failures_[path] = failures;
+            if (failures >= max_attempts_) known_paths_.insert(path);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void JobJournal::recordFailure(const std::string& path) {
+    // Retried when found again, until it has failed max_attempts times
+    if (++failures_[path] < max_attempts_) {
+        known_paths_.erase(path);
+    }
+}
+
+void JobJournal::replay() {
+    std::ifstream in(path_);
+    if (!in.is_open()) return;  // First run
+    
+    std::string line;
+    while (std::getline(in, line)) {
+        try {
+            applyRecord(line);
+        } catch (const std::logic_error&) {
+            // Torn last line (killed mid-write): nothing was committed by it
+        }
+    }
+    
+    // Jobs that were running when the daemon died are retried, up to a limit
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.attempts >= max_attempts_) {
+            abandoned_.push_back(it->second.path);
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void JobJournal::compact() {
+    // Write the snapshot next to the journal and rename it over the original,
+    // so a crash here leaves either the old or the new journal intact
+    const std::string tmp_path = path_ + ".tmp";
+    {
+        std::ofstream tmp(tmp_path, std::ios::trunc);
+        if (!tmp.is_open()) {
+            throw std::runtime_error("Cannot write job journal: " + tmp_path);
+        }
+        
+        std::set<std::string> pending_paths;
+        for (const auto& [id, job] : pending_) {
+            pending_paths.insert(job.path);
+        }
+        for (const auto& known : known_paths_) {
+            if (pending_paths.count(known) == 0 && failures_.count(known) == 0) {
+                tmp << "K\t" << known << "\n";
+            }
+        }
+        for (const auto& [path, failures] : failures_) {
+            tmp << "X\t" << failures << "\t" << path << "\n";
+        }
+        for (const auto& [id, job] : pending_) {
+            tmp << "E\t" << job.id << "\t" << static_cast<int>(job.priority) << "\t"
+                << job.attempts << "\t" << job.path << "\n";
+        }
+    }
+    
+    if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace job journal: " + path_);
+    }
+}
+
+void JobJournal::append(const std::string& record) {
+    // Flushed per record: a killed process loses at most the line being written
+    out_ << record << "\n";
+    out_.flush();
+}
+
+std::optional<Job> JobJournal::enqueue(const std::string& path, Priority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!known_paths_.insert(path).second) {
+        return std::nullopt;
+    }
+    
+    Job job;
+    job.id = next_id_++;
+    job.path = path;
+    job.priority = priority;
+    pending_[job.id] = job;
+    
+    append("E\t" + std::to_string(job.id) + "\t" +
+           std::to_string(static_cast<int>(priority)) + "\t0\t" + path);
+    return job;
+}
+
+void JobJournal::markStarted(const Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    append("S\t" + std::to_string(job.id));
+}
+
+void JobJournal::markDone(const Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(job.id);
+    failures_.erase(job.path);
+    append("D\t" + std::to_string(job.id));
+}
+
+void JobJournal::markFailed(const Job& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(job.id);
+    recordFailure(job.path);
+    append("F\t" + std::to_string(job.id));
+}
+
+std::vector<Job> JobJournal::pendingJobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Job> jobs;
+    for (const auto& [id, job] : pending_) {
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+bool JobJournal::isKnown(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return known_paths_.count(path) > 0;
+}
+
+} // namespace bbst::ingest
@@ -0,0 +1,50 @@
+#include "ingest/JobQueue.hpp"
+
+namespace bbst::ingest {
+
+const char* priorityName(Priority priority) {
+    switch (priority) {
+        case Priority::Live: return "live";
+        case Priority::Recent: return "recent";
+        case Priority::Archive: return "archive";
+    }
+    return "unknown";
+}
+
+JobQueue::JobQueue()
+    : closed_(false)
+{
+}
+
+void JobQueue::push(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push(std::move(job));
+    }
+    ready_.notify_one();
+}
+
+std::optional<Job> JobQueue::pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this] { return closed_ || !jobs_.empty(); });
+    if (closed_) return std::nullopt;
+    
+    Job job = jobs_.top();
+    jobs_.pop();
+    return job;
+}
+
+void JobQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    ready_.notify_all();
+}
+
+size_t JobQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+} // namespace bbst::ingest
@@ -0,0 +1,96 @@
+#include "io/FrameSource.hpp"
+#include "util/MemoryStats.hpp"
+#include <stdexcept>
+
+namespace bbst::io {
+
+void YuvFrame::toBgr(cv::Mat& bgr) const {
+    int code = layout == YuvLayout::NV12 ? cv::COLOR_YUV2BGR_NV12
+                                         : cv::COLOR_YUV2BGR_I420;
+    cv::cvtColor(data, bgr, code);
+}
+
+// VideoFileSource
+
+VideoFileSource::VideoFileSource(const std::string& path)
+    : cap_(path)
+{
+}
+
+cv::Size VideoFileSource::frameSize() const {
+    return cv::Size(static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_WIDTH)),
+                    static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_HEIGHT)));
+}
+
+bool VideoFileSource::read(cv::Mat& bgr) {
+    util::MemoryScope memory(util::MemTag::Decode);
+    return cap_.read(bgr);
+}
+
+double VideoFileSource::fps() const {
+    return cap_.get(cv::CAP_PROP_FPS);
+}
+
+int VideoFileSource::frameCount() const {
+    return static_cast<int>(cap_.get(cv::CAP_PROP_FRAME_COUNT));
+}
+
+double VideoFileSource::timestampMs() const {
+    return cap_.get(cv::CAP_PROP_POS_MSEC);
+}
+
+// RawYuvSource
+
+RawYuvSource::RawYuvSource(const std::string& path, cv::Size size, double fps,
+                           YuvLayout layout)
+    : in_(nullptr)
+    , size_(size)
+    , fps_(fps)
+    , layout_(layout)
+    , frames_read_(0)
+{
+    if (size.width <= 0 || size.height <= 0 || size.width % 2 || size.height % 2) {
+        throw std::runtime_error("Raw YUV frames need a positive, even size");
+    }
+
+    if (path == "-") {
+        in_ = &std::cin;
+    } else {
+        file_.open(path, std::ios::binary);
+        if (file_.is_open()) {
+            in_ = &file_;
+        }
+    }
+}
+
+bool RawYuvSource::readYuv(YuvFrame& yuv) {
+    if (!isOpened()) return false;
+    util::MemoryScope memory(util::MemTag::Decode);
+
+    yuv.layout = layout_;
+    yuv.data.create(size_.height * 3 / 2, size_.width, CV_8UC1);
+
+    const std::streamsize bytes = static_cast<std::streamsize>(yuv.data.total());
+    in_->read(reinterpret_cast<char*>(yuv.data.data), bytes);
+    if (in_->gcount() != bytes) {
+        return false;
+    }
+
+    frames_read_++;
+    return true;
+}
+
+bool RawYuvSource::read(cv::Mat& bgr) {
+    util::MemoryScope memory(util::MemTag::Decode);
+    YuvFrame yuv;
+    if (!readYuv(yuv)) return false;
+    yuv.toBgr(bgr);
+    return true;
+}
+
+double RawYuvSource::timestampMs() const {
+    if (fps_ <= 0.0 || frames_read_ == 0) return 0.0;
+    return (frames_read_ - 1) * 1000.0 / fps_;
+}
+
+} // namespace bbst::io
@@ -0,0 +1,202 @@
+#include "io/LibavSource.hpp"
+#include "util/MemoryStats.hpp"
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/motion_vector.h>
+#include <libswscale/swscale.h>
+}
+
+namespace bbst::io {
+
+static void copyPlane(const uint8_t* src, int src_stride, uint8_t* dst,
+                      int width, int height) {
+    for (int y = 0; y < height; ++y) {
+        std::memcpy(dst + static_cast<size_t>(y) * width,
+                    src + static_cast<size_t>(y) * src_stride, width);
+    }
+}
+
+LibavSource::LibavSource(const std::string& path, int threads)
+    : format_(nullptr)
+    , codec_(nullptr)
+    , frame_(nullptr)
+    , packet_(nullptr)
+    , sws_(nullptr)
+    , stream_index_(-1)
+    , time_base_ms_(0.0)
+    , start_pts_(0)
+    , fps_(0.0)
+    , frame_count_(-1)
+    , timestamp_ms_(0.0)
+    , eof_(false)
+{
+    // Failures leave the source closed; callers check isOpened()
+    if (avformat_open_input(&format_, path.c_str(), nullptr, nullptr) < 0 ||
+        avformat_find_stream_info(format_, nullptr) < 0) {
+        close();
+        return;
+    }
+    
+    const AVCodec* decoder = nullptr;
+    stream_index_ = av_find_best_stream(format_, AVMEDIA_TYPE_VIDEO, -1, -1, &decoder, 0);
+    if (stream_index_ < 0) {
+        close();
+        return;
+    }
+    
+    const AVStream* stream = format_->streams[stream_index_];
+    time_base_ms_ = av_q2d(stream->time_base) * 1000.0;
+    start_pts_ = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+    fps_ = av_q2d(stream->avg_frame_rate);
+    frame_count_ = stream->nb_frames > 0 ? static_cast<int>(stream->nb_frames) : -1;
+    
+    codec_ = avcodec_alloc_context3(decoder);
+    if (codec_ == nullptr || avcodec_parameters_to_context(codec_, stream->codecpar) < 0) {
+        close();
+        return;
+    }
+    codec_->thread_count = threads;
+    
+    // Ask the decoder to attach its motion vectors to every frame as side data
+    AVDictionary* options = nullptr;
+    av_dict_set(&options, "flags2", "+export_mvs", 0);
+    int ret = avcodec_open2(codec_, decoder, &options);
+    av_dict_free(&options);
+    
+    frame_ = av_frame_alloc();
+    packet_ = av_packet_alloc();
+    if (ret < 0 || frame_ == nullptr || packet_ == nullptr) {
+        close();
+    }
+}
+
+LibavSource::~LibavSource() {
+    close();
+}
+
+void LibavSource::close() {
+    sws_freeContext(sws_);
+    sws_ = nullptr;
+    av_packet_free(&packet_);
+    av_frame_free(&frame_);
+    avcodec_free_context(&codec_);
+    avformat_close_input(&format_);
+}
+
+cv::Size LibavSource::frameSize() const {
+    if (!isOpened()) return cv::Size();
+    return cv::Size(codec_->width & ~1, codec_->height & ~1);
+}
+
+bool LibavSource::decodeNext() {
+    while (true) {
+        int ret = avcodec_receive_frame(codec_, frame_);
+        if (ret == 0) {
+            if (frame_->best_effort_timestamp != AV_NOPTS_VALUE) {
+                timestamp_ms_ = (frame_->best_effort_timestamp - start_pts_) * time_base_ms_;
+            }
+            extractMotionVectors();
+            return true;
+        }
+        if (ret != AVERROR(EAGAIN) || eof_) {
+            return false;  // End of stream or decode error
+        }
+        
+        // Decoder wants more input
+        if (av_read_frame(format_, packet_) < 0) {
+            eof_ = true;
+            avcodec_send_packet(codec_, nullptr);  // Drain buffered frames
+            continue;
+        }
+        if (packet_->stream_index == stream_index_) {
+            avcodec_send_packet(codec_, packet_);
+        }
+        av_packet_unref(packet_);
+    }
+}
+
+void LibavSource::extractMotionVectors() {
+    motion_.frame_size = cv::Size(frame_->width, frame_->height);
+    motion_.intra = frame_->pict_type == AV_PICTURE_TYPE_I;
+    motion_.vectors.clear();
+    
+    const AVFrameSideData* side = av_frame_get_side_data(frame_, AV_FRAME_DATA_MOTION_VECTORS);
+    if (side == nullptr) return;
+    
+    const auto* vectors = reinterpret_cast<const AVMotionVector*>(side->data);
+    const size_t count = side->size / sizeof(AVMotionVector);
+    motion_.vectors.reserve(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const AVMotionVector& mv = vectors[i];
+        
+        // dst is the block in this frame, src where it came from in the
+        // reference; future references (B-frames) point the other way
+        cv::Point2f motion(static_cast<float>(mv.dst_x - mv.src_x),
+                           static_cast<float>(mv.dst_y - mv.src_y));
+        if (mv.source > 0) {
+            motion = -motion;
+        }
+        
+        MotionVector vector;
+        vector.position = cv::Point2f(static_cast<float>(mv.dst_x), static_cast<float>(mv.dst_y));
+        vector.motion = motion;
+        vector.block = cv::Size(mv.w, mv.h);
+        motion_.vectors.push_back(vector);
+    }
+}
+
+bool LibavSource::readYuv(YuvFrame& yuv) {
+    if (!isOpened()) return false;
+    util::MemoryScope memory(util::MemTag::Decode);
+    if (!decodeNext()) return false;
+    
+    // YuvFrame needs even dimensions; odd ones lose their last row/column
+    const int w = frame_->width & ~1;
+    const int h = frame_->height & ~1;
+    const auto format = static_cast<AVPixelFormat>(frame_->format);
+    const bool even = w == frame_->width && h == frame_->height;
+    
+    yuv.data.create(h * 3 / 2, w, CV_8UC1);
+    uint8_t* luma = yuv.data.data;
+    uint8_t* chroma = luma + static_cast<size_t>(w) * h;
+    
+    if (even && format == AV_PIX_FMT_NV12) {
+        yuv.layout = YuvLayout::NV12;
+        copyPlane(frame_->data[0], frame_->linesize[0], luma, w, h);
+        copyPlane(frame_->data[1], frame_->linesize[1], chroma, w, h / 2);
+        return true;
+    }
+    
+    yuv.layout = YuvLayout::I420;
+    uint8_t* planes[3] = {luma, chroma, chroma + static_cast<size_t>(w / 2) * (h / 2)};
+    int strides[3] = {w, w / 2, w / 2};
+    
+    if (even && (format == AV_PIX_FMT_YUV420P || format == AV_PIX_FMT_YUVJ420P)) {
+        copyPlane(frame_->data[0], frame_->linesize[0], planes[0], w, h);
+        copyPlane(frame_->data[1], frame_->linesize[1], planes[1], w / 2, h / 2);
+        copyPlane(frame_->data[2], frame_->linesize[2], planes[2], w / 2, h / 2);
+        return true;
+    }
+    
+    // Anything else (4:2:2, 10-bit, odd sizes) goes through swscale
+    sws_ = sws_getCachedContext(sws_, frame_->width, frame_->height, format,
+                                w, h, AV_PIX_FMT_YUV420P, SWS_BILINEAR,
+                                nullptr, nullptr, nullptr);
+    if (sws_ == nullptr) return false;
+    sws_scale(sws_, frame_->data, frame_->linesize, 0, frame_->height, planes, strides);
+    return true;
+}
+
+bool LibavSource::read(cv::Mat& bgr) {
+    util::MemoryScope memory(util::MemTag::Decode);
+    YuvFrame yuv;
+    if (!readYuv(yuv)) return false;
+    yuv.toBgr(bgr);
+    return true;
+}
+
+} // namespace bbst::io
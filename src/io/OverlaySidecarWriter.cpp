@@ -0,0 +1,146 @@
+#include "io/OverlaySidecarWriter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <stdexcept>
+
+namespace bbst::io {
+
+// Minimal JSON string escaping for class names
+static std::string quoted(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+OverlaySidecarWriter::OverlaySidecarWriter(const std::string& path, cv::Size frame_size,
+                                           double fps,
+                                           const std::vector<std::string>& class_names,
+                                           const ui::ColorScheme& colors)
+    : out_(path)
+{
+    if (!out_.is_open()) {
+        throw std::runtime_error("Cannot open overlay sidecar: " + path);
+    }
+    
+    out_ << "{\"version\":1"
+         << ",\"width\":" << frame_size.width
+         << ",\"height\":" << frame_size.height
+         << ",\"fps\":" << fps
+         << ",\"classes\":[";
+    for (size_t i = 0; i < class_names.size(); ++i) {
+        out_ << (i ? "," : "") << quoted(class_names[i]);
+    }
+    out_ << "],\"colors\":{"
+         << "\"trajectory\":\"" << hexColor(colors.trajectory) << "\""
+         << ",\"bbox\":\"" << hexColor(colors.bbox) << "\""
+         << ",\"text\":\"" << hexColor(colors.text) << "\""
+         << ",\"background\":\"" << hexColor(colors.background) << "\""
+         << ",\"classes\":{";
+    bool first = true;
+    for (const auto& [class_id, color] : colors.class_colors) {
+        out_ << (first ? "" : ",") << "\"" << class_id << "\":\"" << hexColor(color) << "\"";
+        first = false;
+    }
+    out_ << "}}}\n";
+}
+
+std::string OverlaySidecarWriter::hexColor(const cv::Scalar& bgr) {
+    auto channel = [](double v) {
+        return static_cast<int>(std::clamp(std::lround(v), 0L, 255L));
+    };
+    char text[8];
+    std::snprintf(text, sizeof(text), "#%02x%02x%02x",
+                  channel(bgr[2]), channel(bgr[1]), channel(bgr[0]));
+    return text;
+}
+
+void OverlaySidecarWriter::write(const pipeline::FrameResult& result, const Trajectory* trail) {
+    out_ << "{\"f\":" << result.frame_index
+         << ",\"t\":" << std::fixed << std::setprecision(1) << result.timestamp_ms
+         << ",\"boxes\":[";
+    for (size_t i = 0; i < result.detections.size(); ++i) {
+        const auto& det = result.detections[i];
+        out_ << (i ? ",[" : "[")
+             << det.box.x << "," << det.box.y << ","
+             << det.box.width << "," << det.box.height << ","
+             << det.class_id << ","
+             << std::setprecision(2) << det.confidence << "]";
+    }
+    out_ << "]";
+    
+    // Whole pixels are plenty for a drawn polyline
+    if (trail && trail->size() >= 2) {
+        out_ << ",\"trail\":[";
+        for (size_t i = 0; i < trail->size(); ++i) {
+            cv::Point2f p = (*trail)[i];
+            out_ << (i ? "," : "") << std::lround(p.x) << "," << std::lround(p.y);
+        }
+        out_ << "]";
+    }
+    
+    // Speed, acceleration, signed curvature, flight time; plus m/s when calibrated
+    if (result.tracking) {
+        const tracking::Kinematics& k = result.kinematics;
+        out_ << ",\"kin\":[" << std::setprecision(1) << k.speed << "," << k.acceleration << ","
+             << std::setprecision(5) << k.curvature << ","
+             << std::setprecision(3) << k.flight_time;
+        if (k.calibrated()) {
+            out_ << "," << std::setprecision(2) << k.speedMps();
+        }
+        out_ << "]";
+    }
+    
+    if (!result.players.empty()) {
+        out_ << ",\"players\":[";
+        for (size_t i = 0; i < result.players.size(); ++i) {
+            const auto& player = result.players[i];
+            out_ << (i ? ",[" : "[") << player.id << ","
+                 << std::lround(player.box.x) << "," << std::lround(player.box.y) << ","
+                 << std::lround(player.box.width) << "," << std::lround(player.box.height) << "]";
+        }
+        out_ << "]";
+    }
+    if (result.holder >= 0) {
+        out_ << ",\"holder\":" << result.holder;
+    }
+    
+    if (!result.possession.empty() || result.outcome != analysis::ShotOutcome::None) {
+        out_ << ",\"events\":[";
+        bool first = true;
+        for (const auto& event : result.possession) {
+            out_ << (first ? "" : ",") << "{\"type\":\""
+                 << analysis::possessionEventName(event.type) << "\""
+                 << ",\"frame\":" << event.frame << ",\"player\":" << event.player;
+            if (event.type == analysis::PossessionEventType::Pass) {
+                out_ << ",\"from\":" << event.from;
+            }
+            out_ << "}";
+            first = false;
+        }
+        if (result.outcome != analysis::ShotOutcome::None) {
+            const char* outcome = result.outcome == analysis::ShotOutcome::Make ? "make" : "miss";
+            out_ << (first ? "" : ",") << "{\"type\":\"" << outcome << "\"";
+            if (result.shooter >= 0) {
+                out_ << ",\"shooter\":" << result.shooter;
+            }
+            out_ << "}";
+        }
+        out_ << "]";
+    }
+    out_ << "}\n";
+}
+
+} // namespace bbst::io
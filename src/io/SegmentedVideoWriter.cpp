@@ -0,0 +1,258 @@
+#include "io/SegmentedVideoWriter.hpp"
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace bbst::io {
+
+namespace fs = std::filesystem;
+
+// Runs a program from PATH without a shell; true on exit status 0
+static bool runProgram(const std::vector<std::string>& args) {
+    std::vector<char*> argv;
+    for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    
+    pid_t pid;
+    if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) {
+        return false;
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+SegmentedVideoWriter::SegmentedVideoWriter(const std::string& output_path, cv::Size frame_size,
+                                           double fps, const SegmentedWriterConfig& config)
+    : output_path_(output_path)
+    , frame_size_(frame_size)
+    , fps_(fps > 0.0 ? fps : 30.0)
+    , config_(config)
+    , next_index_(0)
+    , closed_(false)
+    , stopping_(false)
+{
+    config_.segment_frames = std::max(1, config_.segment_frames);
+    config_.max_pending = std::max(1, config_.max_pending);
+    if (config_.threads <= 0) {
+        // Every encoder holds a segment of frames; more than a few buys
+        // little throughput for a lot of memory
+        config_.threads = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 4u));
+    }
+    if (config_.playlist) {
+        config_.fourcc = cv::VideoWriter::fourcc('a', 'v', 'c', '1');
+    }
+    
+    // Fail now rather than after the first segment has been buffered
+    const std::string probe = segmentPath(output_path_, 0, config_.playlist);
+    {
+        cv::VideoWriter writer(probe, config_.fourcc, fps_, frame_size_);
+        if (!writer.isOpened()) {
+            throw std::runtime_error(config_.playlist
+                ? "No H.264 encoder for HLS segments: " + probe
+                : "Cannot create output segment: " + probe);
+        }
+    }
+    std::error_code ec;
+    fs::remove(probe, ec);
+    
+    current_.index = next_index_++;
+    current_.frames.reserve(config_.segment_frames);
+    for (int i = 0; i < config_.threads; ++i) {
+        encoders_.emplace_back(&SegmentedVideoWriter::encoderLoop, this);
+    }
+}
+
+SegmentedVideoWriter::~SegmentedVideoWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "Segmented output incomplete: " << e.what() << std::endl;
+    }
+}
+
+std::string SegmentedVideoWriter::segmentPath(const std::string& output_path, int index,
+                                              bool playlist) {
+    fs::path path(output_path);
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".seg%05d", index);
+    
+    // HLS segments are MPEG-TS; concatenated ones use the output's container
+    std::string extension = playlist ? ".ts" : path.extension().string();
+    return (path.parent_path() / path.stem()).string() + suffix + extension;
+}
+
+std::string SegmentedVideoWriter::concatList(const std::vector<SegmentInfo>& segments) {
+    std::ostringstream list;
+    list << "ffconcat version 1.0\n";
+    for (const auto& segment : segments) {
+        // Single quotes are written as '\'' inside a quoted path
+        std::string quoted;
+        for (char c : fs::absolute(segment.path).string()) {
+            if (c == '\'') quoted += "'\\''";
+            else quoted += c;
+        }
+        list << "file '" << quoted << "'\n";
+    }
+    return list.str();
+}
+
+std::string SegmentedVideoWriter::hlsPlaylist(const std::vector<SegmentInfo>& segments,
+                                              double fps) {
+    int longest = 0;
+    for (const auto& segment : segments) longest = std::max(longest, segment.frames);
+    
+    std::ostringstream playlist;
+    playlist << "#EXTM3U\n"
+             << "#EXT-X-VERSION:3\n"
+             << "#EXT-X-TARGETDURATION:" << static_cast<int>(std::ceil(longest / fps)) << "\n"
+             << "#EXT-X-MEDIA-SEQUENCE:0\n"
+             << "#EXT-X-PLAYLIST-TYPE:VOD\n";
+    for (const auto& segment : segments) {
+        char duration[32];
+        std::snprintf(duration, sizeof(duration), "%.3f", segment.frames / fps);
+        playlist << "#EXTINF:" << duration << ",\n"
+                 << fs::path(segment.path).filename().string() << "\n";
+    }
+    playlist << "#EXT-X-ENDLIST\n";
+    return playlist.str();
+}
+
+void SegmentedVideoWriter::write(const cv::Mat& frame) {
+    if (closed_) return;
+    
+    // The caller keeps drawing into its frame, so the segment owns a copy
+    current_.frames.push_back(frame.clone());
+    if (static_cast<int>(current_.frames.size()) >= config_.segment_frames) {
+        submit();
+    }
+}
+
+void SegmentedVideoWriter::submit() {
+    if (current_.frames.empty()) return;
+    
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_ready_.wait(lock, [this] {
+            return static_cast<int>(pending_.size()) < config_.max_pending;
+        });
+        pending_.push_back(std::move(current_));
+    }
+    work_ready_.notify_one();
+    
+    current_ = Segment();
+    current_.index = next_index_++;
+    current_.frames.reserve(config_.segment_frames);
+}
+
+void SegmentedVideoWriter::encoderLoop() {
+    util::ProfiledThread profiled;
+    while (true) {
+        Segment segment;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) return;  // Stopping and drained
+            segment = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        space_ready_.notify_one();
+        
+        SegmentInfo info = encode(segment);
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_.push_back(info);
+    }
+}
+
+SegmentInfo SegmentedVideoWriter::encode(const Segment& segment) const {
+    BBST_PROFILE_ZONE("encode");
+    
+    SegmentInfo info;
+    info.index = segment.index;
+    info.path = segmentPath(output_path_, segment.index, config_.playlist);
+    info.frames = static_cast<int>(segment.frames.size());
+    
+    // A fresh encoder per segment: the first frame is always a keyframe
+    cv::VideoWriter writer(info.path, config_.fourcc, fps_, frame_size_);
+    if (!writer.isOpened()) return info;
+    for (const auto& frame : segment.frames) {
+        writer.write(frame);
+    }
+    writer.release();
+    info.ok = true;
+    return info;
+}
+
+void SegmentedVideoWriter::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& encoder : encoders_) {
+        if (encoder.joinable()) encoder.join();
+    }
+}
+
+void SegmentedVideoWriter::close() {
+    if (closed_) return;
+    closed_ = true;
+    
+    submit();
+    finish();
+    
+    std::sort(finished_.begin(), finished_.end(),
+              [](const SegmentInfo& a, const SegmentInfo& b) { return a.index < b.index; });
+    for (const auto& segment : finished_) {
+        if (!segment.ok) {
+            throw std::runtime_error("Cannot encode segment " + segment.path);
+        }
+    }
+    if (finished_.empty()) return;
+    
+    if (config_.playlist) {
+        std::ofstream playlist(output_path_);
+        playlist << hlsPlaylist(finished_, fps_);
+        if (!playlist) {
+            throw std::runtime_error("Cannot write playlist " + output_path_);
+        }
+        return;
+    }
+    
+    std::error_code ec;
+    if (finished_.size() == 1) {
+        fs::rename(finished_.front().path, output_path_, ec);
+        if (ec) throw std::runtime_error("Cannot move segment to " + output_path_);
+        return;
+    }
+    
+    // Stream copy: segments are joined without decoding or re-encoding
+    const std::string list_path = output_path_ + ".segments";
+    {
+        std::ofstream list(list_path);
+        list << concatList(finished_);
+        if (!list) throw std::runtime_error("Cannot write segment list " + list_path);
+    }
+    if (!runProgram({config_.ffmpeg, "-hide_banner", "-loglevel", "error", "-y",
+                     "-f", "concat", "-safe", "0", "-i", list_path,
+                     "-c", "copy", output_path_})) {
+        throw std::runtime_error("Concatenation with " + config_.ffmpeg +
+                                 " failed; segments are listed in " + list_path);
+    }
+    for (const auto& segment : finished_) {
+        fs::remove(segment.path, ec);
+    }
+    fs::remove(list_path, ec);
+}
+
+} // namespace bbst::io
@@ -0,0 +1,166 @@
+#include "io/StampedSource.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace bbst::io {
+
+// FrameStamper
+
+static int cellWidth(int width) {
+    return std::max(1, width / FrameStamper::BITS);
+}
+
+int FrameStamper::bandHeight(int width) {
+    return std::max(8, cellWidth(width));
+}
+
+static uint8_t checksum(uint32_t id, int64_t us) {
+    uint64_t value = static_cast<uint64_t>(us);
+    uint8_t sum = 0;
+    for (int i = 0; i < 4; ++i) sum ^= static_cast<uint8_t>(id >> (8 * i));
+    for (int i = 0; i < 8; ++i) sum ^= static_cast<uint8_t>(value >> (8 * i));
+    return static_cast<uint8_t>(sum ^ 0xA5);  // All-black band must not validate
+}
+
+void FrameStamper::stamp(cv::Mat& bgr, const FrameStamp& stamp) {
+    const int cell = cellWidth(bgr.cols);
+    const int band = bandHeight(bgr.cols);
+    if (bgr.cols < BITS || bgr.rows < band) return;
+    
+    const uint64_t us = static_cast<uint64_t>(stamp.capture_us);
+    const uint8_t sum = checksum(stamp.frame_id, stamp.capture_us);
+    
+    cv::Mat strip = bgr.rowRange(bgr.rows - band, bgr.rows);
+    strip.setTo(cv::Scalar::all(0));
+    for (int bit = 0; bit < BITS; ++bit) {
+        bool set = bit < 32 ? (stamp.frame_id >> bit) & 1
+                 : bit < 96 ? (us >> (bit - 32)) & 1
+                 : (sum >> (bit - 96)) & 1;
+        if (set) {
+            strip.colRange(bit * cell, (bit + 1) * cell).setTo(cv::Scalar::all(255));
+        }
+    }
+}
+
+std::optional<FrameStamp> FrameStamper::read(const cv::Mat& bgr) {
+    const int cell = cellWidth(bgr.cols);
+    const int band = bandHeight(bgr.cols);
+    if (bgr.empty() || bgr.cols < BITS || bgr.rows < band) return std::nullopt;
+    
+    cv::Mat gray = bgr.rowRange(bgr.rows - band, bgr.rows);
+    if (gray.channels() == 3) {
+        cv::cvtColor(gray, gray, cv::COLOR_BGR2GRAY);
+    }
+    
+    // Sample the inner part of each cell; edges bleed under compression
+    const int margin_x = cell / 4;
+    const int margin_y = band / 4;
+    uint32_t id = 0;
+    uint64_t us = 0;
+    uint8_t sum = 0;
+    for (int bit = 0; bit < BITS; ++bit) {
+        cv::Rect inner(bit * cell + margin_x, margin_y,
+                       std::max(1, cell - 2 * margin_x), std::max(1, band - 2 * margin_y));
+        if (cv::mean(gray(inner))[0] < 128.0) continue;
+        
+        if (bit < 32) id |= 1u << bit;
+        else if (bit < 96) us |= uint64_t(1) << (bit - 32);
+        else sum |= static_cast<uint8_t>(1u << (bit - 96));
+    }
+    
+    FrameStamp stamp;
+    stamp.frame_id = id;
+    stamp.capture_us = static_cast<int64_t>(us);
+    if (sum != checksum(stamp.frame_id, stamp.capture_us)) return std::nullopt;
+    return stamp;
+}
+
+int64_t FrameStamper::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// StampedSource
+
+StampedSource::StampedSource(cv::Size size, double fps, int frames,
+                             bool realtime, int max_queued)
+    : size_(size)
+    , fps_(fps > 0.0 ? fps : 30.0)
+    , frames_(frames)
+    , realtime_(realtime)
+    , max_queued_(std::max(1, max_queued))
+    , start_(std::chrono::steady_clock::now())
+    , next_frame_(0)
+    , last_frame_(-1)
+    , dropped_(0)
+{
+}
+
+void StampedSource::render(cv::Mat& bgr, int frame) const {
+    bgr.create(size_, CV_8UC3);
+    bgr.setTo(cv::Scalar(40, 60, 90));
+    
+    // One shot arc every two seconds, across the upper part of the frame
+    const double t = std::fmod(frame / fps_, 2.0) / 2.0;
+    const int radius = std::max(3, size_.height / 30);
+    cv::Point center(static_cast<int>(size_.width * (0.1 + 0.8 * t)),
+                     static_cast<int>(size_.height * (0.65 - 2.0 * t * (1.0 - t))));
+    cv::circle(bgr, center, radius, cv::Scalar(0, 140, 255), cv::FILLED, cv::LINE_AA);
+}
+
+bool StampedSource::read(cv::Mat& bgr) {
+    if (next_frame_ >= frames_) return false;
+    
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / fps_));
+    auto exposure = std::chrono::steady_clock::now();
+    
+    if (realtime_) {
+        exposure = start_ + period * next_frame_;
+        auto now = std::chrono::steady_clock::now();
+        if (now < exposure) {
+            std::this_thread::sleep_until(exposure);
+        } else {
+            // Frames exposed while we were busy sit in the queue; only the
+            // newest max_queued survive
+            int behind = static_cast<int>((now - exposure) / period);
+            if (behind >= max_queued_) {
+                int skip = behind - max_queued_ + 1;
+                skip = std::min(skip, frames_ - 1 - next_frame_);
+                next_frame_ += skip;
+                dropped_ += skip;
+                exposure = start_ + period * next_frame_;
+            }
+        }
+    }
+    
+    render(bgr, next_frame_);
+    
+    FrameStamp stamp;
+    stamp.frame_id = static_cast<uint32_t>(next_frame_);
+    stamp.capture_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        exposure.time_since_epoch()).count();
+    FrameStamper::stamp(bgr, stamp);
+    
+    last_frame_ = next_frame_++;
+    return true;
+}
+
+double StampedSource::timestampMs() const {
+    return last_frame_ < 0 ? 0.0 : last_frame_ * 1000.0 / fps_;
+}
+
+// LatencyProbe
+
+bool LatencyProbe::observe(const cv::Mat& bgr) {
+    std::optional<FrameStamp> stamp = FrameStamper::read(bgr);
+    if (!stamp) {
+        unreadable_++;
+        return false;
+    }
+    stats_.record(FrameStamper::nowUs() - stamp->capture_us);
+    return true;
+}
+
+} // namespace bbst::io
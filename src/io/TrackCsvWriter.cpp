@@ -0,0 +1,96 @@
+#include "io/TrackCsvWriter.hpp"
+#include <cstdio>
+#include <iomanip>
+#include <stdexcept>
+
+namespace bbst::io {
+
+TrackCsvWriter::TrackCsvWriter(const std::string& path)
+    : out_(path)
+{
+    if (!out_.is_open()) {
+        throw std::runtime_error("Cannot open track output: " + path);
+    }
+    out_ << header() << "\n";
+}
+
+const char* TrackCsvWriter::header() {
+    return "frame,time_ms,tracking,detected,x,y,size,detections,"
+           "speed_px_s,accel_px_s2,curvature,flight_s,path_px,speed_mps,accel_mps2,m_per_px,"
+           "holder,holder_x,holder_y";
+}
+
+void TrackCsvWriter::write(const pipeline::FrameResult& result) {
+    out_ << result.frame_index << ","
+         << std::fixed << std::setprecision(1) << result.timestamp_ms << ","
+         << (result.tracking ? 1 : 0) << ","
+         << (result.ball_detected ? 1 : 0) << ","
+         << result.position.x << ","
+         << result.position.y << ","
+         << result.ball_size << ","
+         << result.detections.size() << ",";
+    
+    // Kinematics; real units are -1 when uncalibrated
+    const tracking::Kinematics& k = result.kinematics;
+    out_ << k.speed << "," << k.acceleration << ","
+         << std::setprecision(5) << k.curvature << ","
+         << std::setprecision(3) << k.flight_time << ","
+         << std::setprecision(1) << k.path_length << ","
+         << std::setprecision(2) << (k.calibrated() ? k.speedMps() : -1.0f) << ","
+         << (k.calibrated() ? k.accelerationMps2() : -1.0f) << ","
+         << std::setprecision(6) << k.meters_per_pixel << ","
+         << result.holder << ",";
+    
+    // Where the holder stands, -1 while loose
+    cv::Point2f foot(-1.0f, -1.0f);
+    for (const auto& player : result.players) {
+        if (player.id == result.holder) {
+            foot = cv::Point2f(player.box.x + player.box.width / 2.0f, player.box.y + player.box.height);
+        }
+    }
+    out_ << std::setprecision(1) << foot.x << "," << foot.y << "\n";
+}
+
+std::vector<pipeline::FrameResult> readTrackCsv(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Cannot open track file: " + path);
+    }
+    
+    std::vector<pipeline::FrameResult> results;
+    std::string line;
+    std::getline(in, line);  // Header
+    while (std::getline(in, line)) {
+        pipeline::FrameResult result;
+        long long frame = 0;
+        int tracking = 0;
+        int detected = 0;
+        tracking::Kinematics& k = result.kinematics;
+        cv::Point2f foot(-1.0f, -1.0f);
+        
+        // The m/s columns are derived from m_per_px and only written for readers
+        int fields = std::sscanf(line.c_str(), "%lld,%lf,%d,%d,%f,%f,%f,%*d,%f,%f,%f,%f,%f,%*f,%*f,%f,%d,%f,%f",
+                                 &frame, &result.timestamp_ms, &tracking, &detected,
+                                 &result.position.x, &result.position.y, &result.ball_size,
+                                 &k.speed, &k.acceleration, &k.curvature, &k.flight_time,
+                                 &k.path_length, &k.meters_per_pixel, &result.holder,
+                                 &foot.x, &foot.y);
+        if (fields < 7) {
+            continue;  // Files without kinematics columns load with zeros
+        }
+        result.frame_index = frame;
+        result.tracking = tracking != 0;
+        result.ball_detected = detected != 0;
+        if (fields >= 16 && result.holder >= 0 && foot.x >= 0.0f) {
+            // The holder comes back as a zero-size box at its feet
+            tracking::PlayerTrack holder;
+            holder.id = result.holder;
+            holder.box = cv::Rect2f(foot.x, foot.y, 0.0f, 0.0f);
+            result.players.push_back(holder);
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+} // namespace bbst::io
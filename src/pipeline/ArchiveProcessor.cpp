@@ -0,0 +1,180 @@
+#include "pipeline/ArchiveProcessor.hpp"
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace bbst::pipeline {
+
+ArchiveProcessor::ArchiveProcessor(const std::string& model_path,
+                                   const std::string& names_path,
+                                   const YoloConfig& yolo_config,
+                                   const tracking::TrackerConfig& tracker_config,
+                                   const PipelineOptions& pipeline_options,
+                                   const ArchiveConfig& config)
+    : model_path_(model_path)
+    , names_path_(names_path)
+    , yolo_config_(yolo_config)
+    , tracker_config_(tracker_config)
+    , pipeline_options_(pipeline_options)
+    , config_(config)
+{
+    config_.scan_stride = std::max(1, config_.scan_stride);
+    
+    // Per-frame debug output from parallel workers is just noise
+    yolo_config_.verbose = false;
+}
+
+std::vector<Segment> ArchiveProcessor::buildSegments(const std::vector<int>& hit_frames,
+                                                     int total_frames,
+                                                     const ArchiveConfig& config) {
+    std::vector<int> hits(hit_frames);
+    std::sort(hits.begin(), hits.end());
+    
+    std::vector<Segment> segments;
+    for (int hit : hits) {
+        // A hit stands for the whole sampling interval it was taken from
+        Segment seg;
+        seg.start = std::max(0, hit - config.padding_frames);
+        seg.end = std::min(total_frames, hit + config.scan_stride + config.padding_frames);
+        if (seg.length() <= 0) continue;
+        
+        if (!segments.empty() && seg.start - segments.back().end < config.merge_gap_frames) {
+            segments.back().end = std::max(segments.back().end, seg.end);
+        } else {
+            segments.push_back(seg);
+        }
+    }
+    return segments;
+}
+
+std::vector<Segment> ArchiveProcessor::scan(const std::string& video_path) {
+    auto start = cv::getTickCount();
+    
+    cv::VideoCapture cap(video_path);
+    if (!cap.isOpened()) {
+        throw std::runtime_error("Cannot open video " + video_path);
+    }
+    
+    // Low-resolution, ball-only scan detector. Models exported with a fixed
+    // input shape (the default export) reject the small size and scan at
+    // their native size instead.
+    YoloConfig scan_config = yolo_config_;
+    scan_config.confidence_threshold = std::max(scan_config.confidence_threshold,
+                                                config_.scan_confidence);
+    YoloDetector detector(model_path_, "", scan_config);
+    if (config_.scan_input_size > 0) {
+        const cv::Size scan_size(config_.scan_input_size, config_.scan_input_size);
+        try {
+            detector.prepareInputSizes({scan_size});
+            detector.setInputSize(scan_size);
+        } catch (const std::runtime_error&) {
+            // Keep the native input size
+        }
+    }
+    
+    std::vector<int> hits;
+    cv::Mat frame;
+    int index = 0;
+    int scanned = 0;
+    
+    // grab() skips the colour conversion and copy for frames we don't sample
+    while (cap.grab()) {
+        if (index % config_.scan_stride == 0 && cap.retrieve(frame)) {
+            scanned++;
+            if (!detector.detect(frame, BallClasses{}).empty()) {
+                hits.push_back(index);
+            }
+        }
+        index++;
+        if (on_progress_ && index % config_.progress_frames == 0) {
+            on_progress_();
+        }
+    }
+    
+    stats_.total_frames = index;
+    stats_.scanned_frames = scanned;
+    stats_.scan_ms = (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+    
+    return buildSegments(hits, index, config_);
+}
+
+std::vector<FrameResult> ArchiveProcessor::processSegments(const std::string& video_path,
+                                                           const std::vector<Segment>& segments) {
+    auto start = cv::getTickCount();
+    
+    int workers = config_.workers > 0
+        ? config_.workers
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    workers = std::min(workers, static_cast<int>(segments.size()));
+    
+    std::vector<std::vector<FrameResult>> per_segment(segments.size());
+    std::atomic<size_t> next_segment{0};
+    std::mutex progress_mutex;
+    
+    // Each worker owns a detector (cv::dnn::Net is not thread-safe) and a
+    // capture, and pulls segments until none are left
+    auto worker = [&]() {
+        util::ProfiledThread profiled;
+        YoloDetector detector(model_path_, names_path_, yolo_config_);
+        cv::VideoCapture cap(video_path);
+        if (!cap.isOpened()) {
+            throw std::runtime_error("Cannot open video " + video_path);
+        }
+        
+        // One pipeline per worker, so input sizes are warmed once
+        BallPipeline pipeline(detector, tracker_config_, pipeline_options_);
+        cv::Mat frame;
+        int processed = 0;
+        for (size_t i = next_segment++; i < segments.size(); i = next_segment++) {
+            const Segment& seg = segments[i];
+            cap.set(cv::CAP_PROP_POS_FRAMES, seg.start);
+            
+            // Fresh state per segment: segments are independent plays
+            pipeline.reset();
+            auto& results = per_segment[i];
+            results.reserve(seg.length());
+            
+            for (int f = seg.start; f < seg.end && cap.read(frame); ++f) {
+                FrameContext ctx(frame, f, cap.get(cv::CAP_PROP_POS_MSEC));
+                results.push_back(pipeline.process(ctx));
+                
+                if (on_progress_ && ++processed % config_.progress_frames == 0) {
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    on_progress_();
+                }
+            }
+        }
+    };
+    
+    std::vector<std::future<void>> futures;
+    for (int w = 0; w < workers; ++w) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    for (auto& f : futures) {
+        f.get();  // Rethrows worker exceptions
+    }
+    
+    // Segments are disjoint and sorted, so concatenation keeps frame order
+    std::vector<FrameResult> results;
+    for (auto& seg_results : per_segment) {
+        std::move(seg_results.begin(), seg_results.end(), std::back_inserter(results));
+    }
+    
+    stats_.segments = segments.size();
+    stats_.processed_frames = static_cast<int>(results.size());
+    stats_.dense_ms = (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+    
+    return results;
+}
+
+std::vector<FrameResult> ArchiveProcessor::run(const std::string& video_path) {
+    std::vector<Segment> segments = scan(video_path);
+    return processSegments(video_path, segments);
+}
+
+} // namespace bbst::pipeline
@@ -0,0 +1,359 @@
+#include "pipeline/BallPipeline.hpp"
+#include "util/MemoryStats.hpp"
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace bbst::pipeline {
+
+void applyBallPriors(YoloConfig& yolo_config, const tracking::TrackerConfig& tracker_config) {
+    ClassPrior ball_prior;
+    ball_prior.min_size = tracker_config.min_ball_size;
+    ball_prior.max_size = tracker_config.max_ball_size;
+    ball_prior.min_aspect_ratio = tracker_config.min_aspect_ratio;
+    ball_prior.max_aspect_ratio = tracker_config.max_aspect_ratio;
+    yolo_config.class_priors[0] = ball_prior;  // basketball
+    yolo_config.class_priors[2] = ball_prior;  // sports ball
+}
+
+BallPipeline::BallPipeline(YoloDetector& detector,
+                           const tracking::TrackerConfig& tracker_config,
+                           const PipelineOptions& options)
+    : detector_(detector)
+    , tracker_(tracker_config)
+    , options_(options)
+    , have_rim_(false)
+    , frames_since_rim_refresh_(0)
+    , frames_gated_(0)
+    , make_miss_(options.make_miss)
+    , burst_active_(false)
+    , players_(options.players)
+    , full_view_(false)
+    , possession_(options.possession)
+    , last_frame_index_(-1)
+    , last_timestamp_ms_(0.0)
+{
+    // All input sizes are warmed before the first frame
+    if (options_.adaptive_input) {
+        std::vector<cv::Size> sizes;
+        for (int size : scale_controller_.sizes()) {
+            sizes.emplace_back(size, size);
+        }
+        detector_.prepareInputSizes(sizes);
+    }
+}
+
+void BallPipeline::reset() {
+    tracker_.reset();
+    scale_controller_ = InputScaleController();
+    if (options_.adaptive_input) {
+        detector_.setInputSize(cv::Size(scale_controller_.current(), scale_controller_.current()));
+    }
+    cached_rim_ = Detection<>();
+    have_rim_ = false;
+    frames_since_rim_refresh_ = 0;
+    frames_gated_ = 0;
+    make_miss_ = analysis::MakeMissJudge(options_.make_miss);
+    burst_active_ = false;
+    players_ = tracking::PlayerTracker(options_.players);
+    full_view_ = false;
+    possession_ = analysis::PossessionTracker(options_.possession);
+    last_frame_index_ = -1;
+    last_timestamp_ms_ = 0.0;
+}
+
+cv::Rect BallPipeline::squareRegion(const cv::Rect2f& region, int min_size,
+                                    const cv::Size& frame_size) {
+    int side = std::max(min_size, static_cast<int>(std::ceil(std::max(region.width, region.height))));
+    cv::Point2f center(region.x + region.width / 2.0f, region.y + region.height / 2.0f);
+    cv::Rect square(static_cast<int>(center.x) - side / 2, static_cast<int>(center.y) - side / 2,
+                    side, side);
+    return square & cv::Rect(cv::Point(0, 0), frame_size);
+}
+
+ClassMask BallPipeline::passMask(const ClassMask& classes) const {
+    return options_.person_class >= 0 ? classes.with(options_.person_class) : classes;
+}
+
+cv::Rect BallPipeline::rimBurstRegion(const cv::Rect& rim, float zone_scale,
+                                     const cv::Point2f& predicted, int side,
+                                     const cv::Size& frame_size) {
+    cv::Rect2f zone = analysis::MakeMissJudge::zone(rim, zone_scale);
+    if (!zone.contains(predicted)) return cv::Rect();
+    
+    // The crop covers the zone at no less than native resolution
+    side = std::max(side, static_cast<int>(std::ceil(std::max(zone.width, zone.height))));
+    side = std::min(side, std::min(frame_size.width, frame_size.height));
+    int x = cvRound(zone.x + zone.width / 2.0f) - side / 2;
+    int y = cvRound(zone.y + zone.height / 2.0f) - side / 2;
+    x = std::clamp(x, 0, frame_size.width - side);
+    y = std::clamp(y, 0, frame_size.height - side);
+    return cv::Rect(x, y, side, side);
+}
+
+void BallPipeline::compensateCameraMotion(const cv::Point2f& shift) {
+    // Pans move the court in the image: the track and the rim move with it
+    tracker_.compensateCameraMotion(shift);
+    if (have_rim_) {
+        cached_rim_.center += shift;
+        cached_rim_.box.x = cvRound(cached_rim_.center.x - cached_rim_.box.width / 2.0f);
+        cached_rim_.box.y = cvRound(cached_rim_.center.y - cached_rim_.box.height / 2.0f);
+    }
+}
+
+bool BallPipeline::gateFrame(const analysis::MotionSummary* motion) {
+    // Nothing moved and nothing is tracked: the detector cannot find a new ball
+    bool gate = options_.motion_gating && motion != nullptr && motion->valid &&
+                motion->static_scene && have_rim_ && !tracker_.isActive() &&
+                frames_since_rim_refresh_ < options_.rim_refresh_interval &&
+                frames_gated_ < options_.max_gated_frames;
+    frames_gated_ = gate ? frames_gated_ + 1 : 0;
+    return gate;
+}
+
+cv::Rect BallPipeline::proposeRegion(const FrameContext& ctx,
+                                     const analysis::MotionSummary* motion) const {
+    const cv::Size frame_size = ctx.frame().size();
+    cv::Rect roi;
+    
+    if (tracker_.isActive() && tracker_.getTotalDetections() > 5) {
+        // Covariance-sized search region of a confident track
+        roi = squareRegion(tracker_.getSearchRegion(), options_.min_roi_size, frame_size);
+    } else if (!tracker_.isActive() && motion != nullptr && motion->valid &&
+               !motion->regions.empty()) {
+        // No track: look where the codec saw something move. The union of
+        // several players' regions is almost always too big to crop, so take
+        // one: nearest where the ball was lost, else nearest the rim, else
+        // the largest
+        const bool lost = tracker_.getTotalDetections() > 0;
+        const cv::Point2f anchor = lost ? tracker_.getLastPosition() : cached_rim_.center;
+        const cv::Rect* moving = &motion->regions.front();
+        double best = DBL_MAX;
+        for (const auto& region : motion->regions) {
+            const cv::Point2f center(region.x + region.width / 2.0f, region.y + region.height / 2.0f);
+            const double score = lost || have_rim_ ? cv::norm(center - anchor) : -region.area();
+            if (score < best) {
+                best = score;
+                moving = &region;
+            }
+        }
+        roi = squareRegion(cv::Rect2f(*moving), options_.min_roi_size, frame_size);
+    }
+    
+    if (roi.area() > frame_size.area() / 4) {
+        roi = cv::Rect();  // Too uncertain to be worth cropping
+    }
+    return roi;
+}
+
+std::vector<Detection<>> BallPipeline::detectWithBurst(const FrameContext& ctx,
+                                                       const cv::Rect& roi,
+                                                       const cv::Rect& burst) {
+    const cv::Mat& frame = ctx.frame();
+    cv::Rect normal = roi.empty() ? cv::Rect(0, 0, frame.cols, frame.rows) : roi;
+    const ClassMask mask = passMask(BallClasses::toRuntime().with(RIM_CLASS));
+    auto batch = detector_.detectBatch(frame, {normal, burst}, mask);
+    
+    // Inside the crop the native-resolution boxes replace the downscaled ones
+    std::vector<Detection<>> detections;
+    for (const auto& det : batch[0]) {
+        if (det.class_id != RIM_CLASS && !burst.contains(det.center)) {
+            detections.push_back(det);
+        }
+    }
+    
+    // A sharper rim box from the crop, for the make/miss plane
+    const Detection<>* rim = nullptr;
+    for (const auto& det : batch[1]) {
+        if (det.class_id == RIM_CLASS) {
+            if (rim == nullptr || det.confidence > rim->confidence) rim = &det;
+        } else {
+            detections.push_back(det);
+        }
+    }
+    if (rim != nullptr && rim->confidence >= cached_rim_.confidence * 0.5f) {
+        cached_rim_ = *rim;
+    }
+    return detections;
+}
+
+std::vector<Detection<>> BallPipeline::detectObjects(const FrameContext& ctx,
+                                                     const io::YuvFrame* yuv,
+                                                     const analysis::MotionSummary* motion,
+                                                     const cv::Point2f& predicted) {
+    std::vector<Detection<>> detections;
+    burst_active_ = false;
+    full_view_ = true;
+    
+    if (!have_rim_ || frames_since_rim_refresh_ >= options_.rim_refresh_interval) {
+        detections = yuv ? detector_.detect(*yuv) : detector_.detect(ctx.frame());
+        frames_since_rim_refresh_ = 0;
+        have_rim_ = false;
+        for (const auto& det : detections) {
+            if (det.class_id == RIM_CLASS && (!have_rim_ || det.confidence > cached_rim_.confidence)) {
+                cached_rim_ = det;
+                have_rim_ = true;
+            }
+        }
+        return detections;
+    }
+    
+    // ROI mode: crop to the tracker's search region or the moving blobs
+    cv::Rect roi;
+    if (options_.use_roi) {
+        roi = proposeRegion(ctx, motion);
+    }
+    
+    // Ball heading for the rim: add the native-resolution rim crop to the batch
+    cv::Rect burst;
+    if (options_.rim_burst && tracker_.isActive()) {
+        burst = rimBurstRegion(cached_rim_.box, options_.make_miss.zone_scale, predicted,
+                               detector_.getInputSize().width, ctx.frame().size());
+    }
+    
+    full_view_ = roi.empty();
+    if (!burst.empty()) {
+        detections = detectWithBurst(ctx, roi, burst);
+        burst_active_ = true;
+    } else if (!roi.empty()) {
+        detections = detector_.detect(ctx.frame(), roi, passMask(BallClasses::toRuntime()));
+    } else if (options_.person_class >= 0) {
+        const ClassMask mask = passMask(BallClasses::toRuntime());
+        detections = yuv ? detector_.detect(*yuv, mask) : detector_.detect(ctx.frame(), mask);
+    } else {
+        detections = yuv ? detector_.detect(*yuv, BallClasses{})
+                         : detector_.detect(ctx.frame(), BallClasses{});
+    }
+    detections.push_back(cached_rim_);
+    frames_since_rim_refresh_++;
+    
+    return detections;
+}
+
+const Detection<>* BallPipeline::selectBall(const std::vector<Detection<>>& detections,
+                                            const cv::Point2f& predicted) const {
+    const Detection<>* best_ball = nullptr;
+    float best_confidence = 0.0f;
+    float best_distance = FLT_MAX;
+    
+    for (const auto& det : detections) {
+        if (!BallClasses::contains(det.class_id)) continue;
+        
+        // Size and aspect ratio already enforced by the decoder priors
+        if (tracker_.isActive()) {
+            // Mahalanobis gate from the Kalman innovation covariance
+            if (!tracker_.inGate(det.center)) continue;
+            
+            float distance = cv::norm(det.center - predicted);
+            float score = det.confidence * 100.0f - distance * 0.5f;
+            float current_best = best_confidence * 100.0f - best_distance * 0.5f;
+            
+            if (score > current_best) {
+                best_distance = distance;
+                best_confidence = det.confidence;
+                best_ball = &det;
+            }
+        } else if (det.confidence > best_confidence) {
+            best_confidence = det.confidence;
+            best_ball = &det;
+        }
+    }
+    
+    return best_ball;
+}
+
+FrameResult BallPipeline::process(const FrameContext& ctx, const io::YuvFrame* yuv,
+                                  const analysis::MotionSummary* motion) {
+    FrameResult result;
+    result.frame_index = ctx.index();
+    result.timestamp_ms = ctx.timestampMs();
+    
+    // Per-second kinematics follow the stream's clock, not a nominal fps
+    if (last_frame_index_ >= 0 && result.frame_index > last_frame_index_ &&
+        result.timestamp_ms > last_timestamp_ms_) {
+        tracker_.setFrameInterval(static_cast<float>(
+            (result.timestamp_ms - last_timestamp_ms_) / 1000.0 /
+            static_cast<double>(result.frame_index - last_frame_index_)));
+    }
+    last_frame_index_ = result.frame_index;
+    last_timestamp_ms_ = result.timestamp_ms;
+    
+    // Predict ball position
+    cv::Point2f predicted;
+    {
+        BBST_PROFILE_ZONE("predict");
+        util::MemoryScope memory(util::MemTag::Tracking);
+        if (motion != nullptr && motion->valid) {
+            compensateCameraMotion(motion->camera_motion);
+        }
+        predicted = tracker_.predict();
+    }
+    
+    // Cheapest input size that keeps the tracked ball detectable
+    if (options_.adaptive_input) {
+        int input_size = scale_controller_.update(tracker_.getLastSize(), ctx.frame().size(),
+                                                  tracker_.isActive());
+        detector_.setInputSize(cv::Size(input_size, input_size));
+    }
+    
+    result.gated = gateFrame(motion);
+    if (result.gated) {
+        result.detections.push_back(cached_rim_);
+        frames_since_rim_refresh_++;
+    } else {
+        BBST_PROFILE_ZONE("detect");
+        util::MemoryScope memory(util::MemTag::Dnn);
+        result.detections = detectObjects(ctx, yuv, motion, predicted);
+        result.rim_burst = burst_active_;
+    }
+    
+    // Update tracker
+    BBST_PROFILE_ZONE("track");
+    util::MemoryScope memory(util::MemTag::Tracking);
+    const Detection<>* best_ball = selectBall(result.detections, predicted);
+    if (best_ball != nullptr) {
+        float size = (best_ball->box.width + best_ball->box.height) / 2.0f;
+        int detections_before = tracker_.getTotalDetections();
+        tracker_.update(best_ball->center, size);
+        result.ball_detected = tracker_.getTotalDetections() > detections_before;
+    } else {
+        tracker_.updateWithoutMeasurement();
+    }
+    
+    // Rim visits are judged on raw detections, the filter smooths the drop
+    if (options_.rim_burst && have_rim_) {
+        result.outcome = make_miss_.update(cached_rim_.box,
+                                           result.ball_detected ? &best_ball->center : nullptr);
+    }
+    
+    // Players only move on frames whose pass saw the whole court; the ball
+    // goes to the nearest of them
+    if (options_.person_class >= 0) {
+        BBST_PROFILE_ZONE("players");
+        if (!result.gated && full_view_) {
+            players_.update(ctx.frame(), result.detections, options_.person_class);
+        } else {
+            players_.coast();
+        }
+        result.players = players_.confirmed();
+        
+        possession_.update(result.frame_index, result.ball_detected ? &best_ball->center : nullptr,
+                           result.players, ctx.frame().size(), result.possession);
+        result.holder = possession_.holder();
+        if (result.outcome != analysis::ShotOutcome::None) {
+            result.shooter = possession_.lastHolder();
+        }
+    }
+    
+    result.tracking = tracker_.isActive();
+    result.position = tracker_.getLastPosition();
+    result.ball_size = tracker_.getLastSize();
+    if (result.tracking) {
+        result.kinematics = tracker_.getKinematics();
+    }
+    
+    return result;
+}
+
+} // namespace bbst::pipeline
@@ -0,0 +1,169 @@
+#include "pipeline/HighlightRenderer.hpp"
+#include "ui/OverlayRenderer.hpp"
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bbst::pipeline {
+
+namespace fs = std::filesystem;
+
+HighlightRenderer::HighlightRenderer(const std::string& video_path, std::vector<FrameResult> track,
+                                     const HighlightConfig& config)
+    : video_path_(video_path)
+    , track_(std::move(track))
+    , config_(config)
+{
+    std::sort(track_.begin(), track_.end(), [](const FrameResult& a, const FrameResult& b) {
+        return a.frame_index < b.frame_index;
+    });
+}
+
+std::vector<HighlightClip> HighlightRenderer::planClips(
+    const std::vector<analysis::ShotEvent>& events, int total_frames,
+    const std::string& video_path, const std::string& output_dir,
+    const HighlightConfig& config) {
+    std::vector<HighlightClip> clips;
+    for (const auto& event : events) {
+        Segment range;
+        range.start = std::max(0, event.launch_frame - config.pre_frames);
+        range.end = event.land_frame + config.post_frames + 1;
+        if (total_frames > 0) range.end = std::min(range.end, total_frames);
+        if (range.length() <= 0) continue;
+        
+        if (!clips.empty() && range.start <= clips.back().range.end) {
+            clips.back().range.end = std::max(clips.back().range.end, range.end);
+            clips.back().apex_frames.push_back(event.apex_frame);
+            continue;
+        }
+        HighlightClip clip;
+        clip.index = static_cast<int>(clips.size()) + 1;
+        clip.range = range;
+        clip.apex_frames.push_back(event.apex_frame);
+        clips.push_back(clip);
+    }
+    
+    const std::string stem = fs::path(video_path).stem().string();
+    for (auto& clip : clips) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "_shot%02d", clip.index);
+        clip.path = (fs::path(output_dir) / (stem + name + config.extension)).string();
+    }
+    return clips;
+}
+
+int HighlightRenderer::rowAt(int frame) const {
+    auto it = std::lower_bound(track_.begin(), track_.end(), frame,
+                               [](const FrameResult& r, int f) { return r.frame_index < f; });
+    if (it == track_.end() || it->frame_index != frame) return -1;
+    return static_cast<int>(it - track_.begin());
+}
+
+Trajectory HighlightRenderer::trailAt(int row) const {
+    // Walk back over the continuous tracked run, then replay it forwards
+    int first = row;
+    while (first > 0 && row - first + 1 < config_.trail_length &&
+           track_[first - 1].tracking &&
+           track_[first].frame_index - track_[first - 1].frame_index == 1) {
+        first--;
+    }
+    
+    Trajectory trail(config_.trail_length);
+    for (int i = first; i <= row; ++i) {
+        trail += track_[i].position;
+    }
+    return trail;
+}
+
+void HighlightRenderer::renderClip(cv::VideoCapture& cap, const HighlightClip& clip,
+                                   double fps) const {
+    ui::OverlayRenderer renderer(ui::ColorScheme(), 3, 0.5f);
+    cv::VideoWriter out;
+    cv::Mat frame;
+    
+    cap.set(cv::CAP_PROP_POS_FRAMES, clip.range.start);
+    for (int f = clip.range.start; f < clip.range.end; ++f) {
+        {
+            BBST_PROFILE_ZONE("decode");
+            if (!cap.read(frame)) break;
+        }
+        if (!out.isOpened()) {
+            out.open(clip.path, config_.fourcc, fps, frame.size());
+            if (!out.isOpened()) {
+                throw std::runtime_error("Cannot create clip " + clip.path);
+            }
+        }
+        
+        BBST_PROFILE_ZONE("render");
+        int row = rowAt(f);
+        if (row >= 0 && track_[row].tracking) {
+            renderer.drawTrajectory(frame, trailAt(row));
+        }
+        
+        std::stringstream info;
+        info << "Shot " << clip.index << " | Frame: " << f
+             << " | " << std::fixed << std::setprecision(2) << f / fps << "s";
+        renderer.drawInfo(frame, info.str(), cv::Point(10, 22));
+        
+        BBST_PROFILE_ZONE("encode");
+        out.write(frame);
+    }
+}
+
+std::vector<HighlightClip> HighlightRenderer::render(
+    const std::vector<analysis::ShotEvent>& events, const std::string& output_dir) {
+    int total_frames = 0;
+    {
+        cv::VideoCapture cap(video_path_);
+        if (!cap.isOpened()) {
+            throw std::runtime_error("Cannot open video " + video_path_);
+        }
+        total_frames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));
+    }
+    
+    fs::create_directories(output_dir);
+    std::vector<HighlightClip> clips = planClips(events, total_frames, video_path_,
+                                                 output_dir, config_);
+    if (clips.empty()) return clips;
+    
+    int workers = config_.workers > 0
+        ? config_.workers
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    workers = std::min(workers, static_cast<int>(clips.size()));
+    
+    std::atomic<size_t> next_clip{0};
+    
+    // Each worker owns a capture and pulls clips until none are left
+    auto worker = [&]() {
+        util::ProfiledThread profiled;
+        cv::VideoCapture cap(video_path_);
+        if (!cap.isOpened()) {
+            throw std::runtime_error("Cannot open video " + video_path_);
+        }
+        double fps = cap.get(cv::CAP_PROP_FPS);
+        if (fps <= 0.0) fps = 30.0;
+        
+        for (size_t i = next_clip++; i < clips.size(); i = next_clip++) {
+            renderClip(cap, clips[i], fps);
+        }
+    };
+    
+    std::vector<std::future<void>> futures;
+    for (int w = 0; w < workers; ++w) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    for (auto& f : futures) {
+        f.get();  // Rethrows worker exceptions
+    }
+    
+    return clips;
+}
+
+} // namespace bbst::pipeline
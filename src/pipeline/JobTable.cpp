@@ -0,0 +1,325 @@
+#include "pipeline/JobTable.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bbst::pipeline {
+
+// Atomics in a shared mapping must not hide a lock inside the process
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomics must be lock-free");
+static_assert(std::atomic<int64_t>::is_always_lock_free, "64-bit atomics must be lock-free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "32-bit atomics must be lock-free");
+
+static constexpr uint32_t TABLE_MAGIC = 0x42425354;  // "BBST"
+static constexpr uint32_t TABLE_VERSION = 2;
+static constexpr uint32_t MAX_ATTEMPTS_LIMIT = 15;   // 4-bit field
+
+struct alignas(64) JobTable::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t job_count;
+    uint32_t video_count;
+    uint32_t shards;
+    uint32_t max_attempts;
+    int64_t lease_ms;
+    int64_t epoch_ms;                       // Creation time; leases count from here
+    std::atomic<uint32_t> next_rank;
+};
+
+// One cache line per job so workers claiming neighbours don't false-share
+struct alignas(64) JobTable::Slot {
+    std::atomic<uint64_t> word;             // state | attempts | sequence | lease
+    JobSpec spec;
+};
+
+// Claim word: [63:60] state, [59:56] attempts, [55:32] sequence, [31:0] lease
+// deadline in ms since the table was created. The sequence changes on every
+// transition, so a stale token never matches; the lease lives in the same
+// word, so it only ever changes together with a successful CAS.
+static uint64_t packWord(JobState state, uint32_t attempts, uint32_t sequence, uint32_t lease) {
+    return (static_cast<uint64_t>(state) << 60) |
+           (static_cast<uint64_t>(attempts & 0xF) << 56) |
+           (static_cast<uint64_t>(sequence & 0xFFFFFF) << 32) |
+           lease;
+}
+
+static JobState stateOf(uint64_t word) { return static_cast<JobState>(word >> 60); }
+static uint32_t attemptsOf(uint64_t word) { return static_cast<uint32_t>(word >> 56) & 0xF; }
+static uint32_t sequenceOf(uint64_t word) { return static_cast<uint32_t>(word >> 32) & 0xFFFFFF; }
+static uint32_t leaseOf(uint64_t word) { return static_cast<uint32_t>(word); }
+
+static uint64_t transition(uint64_t word, JobState state, uint32_t lease) {
+    return packWord(state, attemptsOf(word), sequenceOf(word) + 1, lease);
+}
+
+static uint64_t transition(uint64_t word, JobState state) {
+    return transition(word, state, leaseOf(word));
+}
+
+static size_t alignUp(size_t value) {
+    return (value + 63) & ~static_cast<size_t>(63);
+}
+
+std::vector<JobSpec> planChunks(const std::vector<int>& frame_counts, int chunk_frames) {
+    std::vector<JobSpec> jobs;
+    for (size_t v = 0; v < frame_counts.size(); ++v) {
+        for (int start = 0; start < frame_counts[v]; start += chunk_frames) {
+            JobSpec spec;
+            spec.video = static_cast<uint32_t>(v);
+            spec.start = start;
+            spec.end = std::min(frame_counts[v], start + chunk_frames);
+            jobs.push_back(spec);
+        }
+    }
+    return jobs;
+}
+
+int64_t JobTable::nowMs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+void JobTable::create(const std::string& table_path,
+                      const std::vector<std::string>& videos,
+                      const std::vector<JobSpec>& jobs,
+                      uint32_t shards,
+                      int64_t lease_ms,
+                      uint32_t max_attempts) {
+    for (const auto& video : videos) {
+        if (video.size() >= MAX_PATH_LENGTH) {
+            throw std::runtime_error("Video path too long for job table: " + video);
+        }
+    }
+    
+    const size_t paths_offset = alignUp(sizeof(Header));
+    const size_t slots_offset = alignUp(paths_offset + videos.size() * MAX_PATH_LENGTH);
+    const size_t size = slots_offset + jobs.size() * sizeof(Slot);
+    
+    // Built under a temporary name so workers never map a half-written table
+    const std::string tmp_path = table_path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Cannot create job table " + tmp_path + ": " + std::strerror(errno));
+    }
+    
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Cannot map job table: " + std::string(std::strerror(errno)));
+    }
+    
+    char* bytes = static_cast<char*>(base);
+    Header* header = new (bytes) Header();
+    header->magic = TABLE_MAGIC;
+    header->version = TABLE_VERSION;
+    header->job_count = static_cast<uint32_t>(jobs.size());
+    header->video_count = static_cast<uint32_t>(videos.size());
+    header->shards = std::max(1u, shards);
+    header->max_attempts = std::min(std::max(1u, max_attempts), MAX_ATTEMPTS_LIMIT);
+    header->lease_ms = lease_ms;
+    header->epoch_ms = nowMs();
+    header->next_rank.store(0);
+    
+    for (size_t v = 0; v < videos.size(); ++v) {
+        std::strncpy(bytes + paths_offset + v * MAX_PATH_LENGTH, videos[v].c_str(), MAX_PATH_LENGTH - 1);
+    }
+    
+    Slot* slots = reinterpret_cast<Slot*>(bytes + slots_offset);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        Slot* slot = new (&slots[i]) Slot();
+        slot->word.store(packWord(JobState::Pending, 0, 0, 0));
+        slot->spec = jobs[i];
+    }
+    
+    ::msync(base, size, MS_SYNC);
+    ::munmap(base, size);
+    
+    if (std::rename(tmp_path.c_str(), table_path.c_str()) != 0) {
+        throw std::runtime_error("Cannot install job table " + table_path);
+    }
+}
+
+JobTable::JobTable(const std::string& table_path)
+    : fd_(-1)
+    , base_(MAP_FAILED)
+    , size_(0)
+    , header_(nullptr)
+    , slots_(nullptr)
+    , paths_(nullptr)
+    , rank_(0)
+{
+    fd_ = ::open(table_path.c_str(), O_RDWR);
+    struct stat st;
+    if (fd_ < 0 || ::fstat(fd_, &st) != 0) {
+        throw std::runtime_error("Cannot open job table " + table_path + ": " + std::strerror(errno));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    
+    if (size_ >= sizeof(Header)) {
+        base_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    }
+    if (base_ == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot map job table " + table_path);
+    }
+    
+    char* bytes = static_cast<char*>(base_);
+    header_ = reinterpret_cast<Header*>(bytes);
+    const size_t paths_offset = alignUp(sizeof(Header));
+    const size_t slots_offset = alignUp(paths_offset + header_->video_count * MAX_PATH_LENGTH);
+    
+    if (header_->magic != TABLE_MAGIC || header_->version != TABLE_VERSION ||
+        size_ < slots_offset + header_->job_count * sizeof(Slot)) {
+        ::munmap(base_, size_);
+        ::close(fd_);
+        throw std::runtime_error("Not a job table: " + table_path);
+    }
+    
+    paths_ = bytes + paths_offset;
+    slots_ = reinterpret_cast<Slot*>(bytes + slots_offset);
+    rank_ = header_->next_rank.fetch_add(1);
+}
+
+JobTable::~JobTable() {
+    ::munmap(base_, size_);
+    ::close(fd_);
+}
+
+uint32_t JobTable::jobCount() const { return header_->job_count; }
+uint32_t JobTable::videoCount() const { return header_->video_count; }
+uint32_t JobTable::shardCount() const { return header_->shards; }
+int64_t JobTable::leaseMs() const { return header_->lease_ms; }
+
+int64_t JobTable::tableMs(int64_t now_ms) const {
+    return now_ms - header_->epoch_ms;
+}
+
+uint32_t JobTable::leaseDeadline(int64_t now_ms) const {
+    return static_cast<uint32_t>(std::clamp<int64_t>(tableMs(now_ms) + header_->lease_ms, 0, UINT32_MAX));
+}
+
+std::string JobTable::videoPath(uint32_t video) const {
+    return std::string(paths_ + static_cast<size_t>(video) * MAX_PATH_LENGTH);
+}
+
+JobSpec JobTable::job(uint32_t index) const {
+    return slots_[index].spec;
+}
+
+JobState JobTable::state(uint32_t index) const {
+    return stateOf(slots_[index].word.load());
+}
+
+uint32_t JobTable::shardBegin(uint32_t shard) const {
+    return static_cast<uint32_t>(static_cast<uint64_t>(shard) * header_->job_count / header_->shards);
+}
+
+std::optional<JobClaim> JobTable::tryClaim(uint32_t index, bool stolen, int64_t now_ms) {
+    Slot& slot = slots_[index];
+    uint64_t word = slot.word.load();
+    
+    bool reclaimed = false;
+    if (stateOf(word) == JobState::Claimed) {
+        // A clock behind the epoch means the host rebooted: no owner survived
+        const int64_t elapsed = tableMs(now_ms);
+        if (elapsed >= 0 && leaseOf(word) > elapsed) return std::nullopt;
+        reclaimed = true;  // Owner stopped renewing, presumably dead
+    } else if (stateOf(word) != JobState::Pending) {
+        return std::nullopt;
+    }
+    
+    // A job that keeps killing its workers is given up on
+    uint32_t attempts = attemptsOf(word) + 1;
+    if (attempts > header_->max_attempts) {
+        slot.word.compare_exchange_strong(word, transition(word, JobState::Failed));
+        return std::nullopt;
+    }
+    
+    // State and lease in one CAS: a losing racer leaves the winner's lease alone
+    uint64_t token = packWord(JobState::Claimed, attempts, sequenceOf(word) + 1, leaseDeadline(now_ms));
+    if (!slot.word.compare_exchange_strong(word, token)) {
+        return std::nullopt;  // Another worker won the race
+    }
+    
+    JobClaim claim;
+    claim.index = index;
+    claim.spec = slot.spec;
+    claim.token = token;
+    claim.stolen = stolen;
+    claim.reclaimed = reclaimed;
+    return claim;
+}
+
+std::optional<JobClaim> JobTable::claim() {
+    const int64_t now = nowMs();
+    const uint32_t shards = header_->shards;
+    const uint32_t home = rank_ % shards;
+    
+    // Home shard from the front
+    for (uint32_t i = shardBegin(home); i < shardBegin(home + 1); ++i) {
+        if (auto claim = tryClaim(i, false, now)) return claim;
+    }
+    
+    // Steal from the back of the other shards, away from their owners
+    for (uint32_t k = 1; k < shards; ++k) {
+        uint32_t victim = (home + k) % shards;
+        for (uint32_t i = shardBegin(victim + 1); i-- > shardBegin(victim);) {
+            if (auto claim = tryClaim(i, true, now)) return claim;
+        }
+    }
+    
+    return std::nullopt;
+}
+
+bool JobTable::renew(JobClaim& claim) {
+    // Fails without touching the lease once someone else owns the job
+    uint64_t expected = claim.token;
+    uint64_t next = transition(claim.token, JobState::Claimed, leaseDeadline(nowMs()));
+    if (!slots_[claim.index].word.compare_exchange_strong(expected, next)) {
+        return false;
+    }
+    claim.token = next;
+    return true;
+}
+
+bool JobTable::complete(const JobClaim& claim) {
+    uint64_t expected = claim.token;
+    return slots_[claim.index].word.compare_exchange_strong(
+        expected, transition(claim.token, JobState::Done));
+}
+
+bool JobTable::fail(const JobClaim& claim) {
+    uint64_t expected = claim.token;
+    return slots_[claim.index].word.compare_exchange_strong(
+        expected, transition(claim.token, JobState::Failed));
+}
+
+JobCounts JobTable::counts() const {
+    JobCounts counts;
+    for (uint32_t i = 0; i < header_->job_count; ++i) {
+        switch (state(i)) {
+            case JobState::Pending: counts.pending++; break;
+            case JobState::Claimed: counts.claimed++; break;
+            case JobState::Done: counts.done++; break;
+            case JobState::Failed: counts.failed++; break;
+        }
+    }
+    return counts;
+}
+
+bool JobTable::finished() const {
+    JobCounts c = counts();
+    return c.pending == 0 && c.claimed == 0;
+}
+
+} // namespace bbst::pipeline
@@ -0,0 +1,178 @@
+#include "pipeline/ShardProcessor.hpp"
+#include "core/FrameContext.hpp"
+#include "io/TrackCsvWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+namespace bbst::pipeline {
+
+namespace fs = std::filesystem;
+
+ShardProcessor::ShardProcessor(const std::string& model_path,
+                               const std::string& names_path,
+                               const YoloConfig& yolo_config,
+                               const tracking::TrackerConfig& tracker_config,
+                               const PipelineOptions& pipeline_options,
+                               const ShardConfig& config)
+    : model_path_(model_path)
+    , names_path_(names_path)
+    , yolo_config_(yolo_config)
+    , tracker_config_(tracker_config)
+    , pipeline_options_(pipeline_options)
+    , config_(config)
+{
+    yolo_config_.verbose = false;
+}
+
+std::string ShardProcessor::jobOutputPath(const std::string& table_path, uint32_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "job_%06u.csv", index);
+    return (fs::path(table_path + ".jobs") / name).string();
+}
+
+size_t ShardProcessor::plan(const std::string& table_path,
+                            const std::vector<std::string>& videos) const {
+    std::vector<int> frame_counts;
+    for (const auto& video : videos) {
+        cv::VideoCapture cap(video);
+        if (!cap.isOpened()) {
+            throw std::runtime_error("Cannot open video " + video);
+        }
+        frame_counts.push_back(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT)));
+    }
+    
+    std::vector<JobSpec> jobs = planChunks(frame_counts, config_.chunk_frames);
+    uint32_t shards = config_.shards > 0
+        ? config_.shards
+        : std::max(1u, std::thread::hardware_concurrency());
+    
+    fs::create_directories(table_path + ".jobs");
+    JobTable::create(table_path, videos, jobs, shards, config_.lease_ms, config_.max_attempts);
+    return jobs.size();
+}
+
+bool ShardProcessor::processJob(JobTable& table, JobClaim& claim, YoloDetector& detector,
+                                cv::VideoCapture& cap, const std::string& table_path) {
+    const JobSpec& spec = claim.spec;
+    
+    // Warm the tracker up on the frames before the chunk so tracks crossing
+    // the boundary are already established when output starts
+    const int first = std::max(0, spec.start - config_.warmup_frames);
+    cap.set(cv::CAP_PROP_POS_FRAMES, first);
+    
+    const std::string output = jobOutputPath(table_path, claim.index);
+    const std::string partial = output + "." + std::to_string(::getpid()) + ".part";
+    try {
+        io::TrackCsvWriter writer(partial);
+        BallPipeline pipeline(detector, tracker_config_, pipeline_options_);
+        
+        cv::Mat frame;
+        for (int f = first; f < spec.end && cap.read(frame); ++f) {
+            FrameContext ctx(frame, f, cap.get(cv::CAP_PROP_POS_MSEC));
+            FrameResult result = pipeline.process(ctx);
+            if (f >= spec.start) {
+                writer.write(result);
+            }
+            
+            if ((f - first) % config_.renew_interval_frames == 0 && !table.renew(claim)) {
+                std::remove(partial.c_str());
+                return false;  // Reclaimed by another worker, drop our copy
+            }
+        }
+    } catch (...) {
+        std::remove(partial.c_str());
+        throw;
+    }
+    
+    // Output is in place before the job is marked done; if another worker
+    // took the job over it writes identical content
+    fs::rename(partial, output);
+    return table.complete(claim);
+}
+
+int ShardProcessor::work(const std::string& table_path) {
+    JobTable table(table_path);
+    YoloDetector detector(model_path_, names_path_, yolo_config_);
+    
+    cv::VideoCapture cap;
+    uint32_t open_video = UINT32_MAX;
+    int completed = 0;
+    
+    while (!table.finished()) {
+        auto claim = table.claim();
+        if (!claim) {
+            // Everything left is held by live workers: wait for them to finish
+            // or for a lease to run out
+            auto wait = std::min<int64_t>(1000, std::max<int64_t>(1, table.leaseMs() / 4));
+            std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+            continue;
+        }
+        
+        try {
+            if (claim->spec.video != open_video) {
+                open_video = claim->spec.video;
+                if (!cap.open(table.videoPath(open_video))) {
+                    open_video = UINT32_MAX;
+                    throw std::runtime_error("Cannot open video " + table.videoPath(claim->spec.video));
+                }
+            }
+            
+            if (processJob(table, *claim, detector, cap, table_path)) {
+                completed++;
+                std::cout << "[rank " << table.rank() << "] job " << claim->index
+                          << (claim->stolen ? " (stolen)" : "")
+                          << (claim->reclaimed ? " (reclaimed)" : "") << " done" << std::endl;
+            }
+        } catch (const std::exception& e) {
+            table.fail(*claim);
+            std::cerr << "[rank " << table.rank() << "] job " << claim->index
+                      << " failed: " << e.what() << std::endl;
+        }
+    }
+    
+    return completed;
+}
+
+int ShardProcessor::reduce(const std::string& table_path, const std::string& output_dir) {
+    JobTable table(table_path);
+    fs::create_directories(output_dir);
+    
+    int missing = 0;
+    for (uint32_t v = 0; v < table.videoCount(); ++v) {
+        std::string video = table.videoPath(v);
+        // Prefixed with the video index so same-named clips from different
+        // folders don't overwrite each other
+        std::string name = std::to_string(v) + "-" + fs::path(video).stem().string() + ".csv";
+        std::ofstream out(fs::path(output_dir) / name);
+        out << io::TrackCsvWriter::header() << "\n";
+        
+        // Jobs were planned in frame order, so concatenation keeps it
+        for (uint32_t i = 0; i < table.jobCount(); ++i) {
+            if (table.job(i).video != v) continue;
+            
+            std::ifstream in(jobOutputPath(table_path, i));
+            if (table.state(i) != JobState::Done || !in.is_open()) {
+                std::cerr << "Missing output for " << video << " frames " << table.job(i).start
+                          << "-" << table.job(i).end << std::endl;
+                missing++;
+                continue;
+            }
+            
+            std::string line;
+            std::getline(in, line);  // Per-job header
+            while (std::getline(in, line)) {
+                out << line << "\n";
+            }
+        }
+    }
+    
+    return missing;
+}
+
+} // namespace bbst::pipeline
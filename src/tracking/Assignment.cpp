@@ -0,0 +1,83 @@
+#include "tracking/Assignment.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace bbst::tracking {
+
+const std::vector<int>& AssignmentSolver::solve(const std::vector<float>& cost, int rows, int cols,
+                                                float max_cost) {
+    std::vector<int>& result = result_;
+    result.assign(rows, -1);
+    if (rows == 0 || cols == 0) return result;
+    
+    // Forbidden pairs cost more than any full set of allowed ones, so the
+    // solver assigns as many allowed pairs as it can before using them
+    const int n = std::max(rows, cols);
+    const double forbidden = static_cast<double>(max_cost) * (n + 1) + 1.0;
+    const int stride = n + 1;
+    a_.assign(static_cast<size_t>(stride) * stride, forbidden);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            float value = cost[static_cast<size_t>(r) * cols + c];
+            if (value < max_cost) a_[(r + 1) * stride + c + 1] = value;
+        }
+    }
+    
+    const double inf = std::numeric_limits<double>::infinity();
+    u_.assign(n + 1, 0.0);
+    v_.assign(n + 1, 0.0);
+    match_.assign(n + 1, 0);             // Row matched to each column (0 = none)
+    way_.assign(n + 1, 0);
+    
+    for (int i = 1; i <= n; ++i) {
+        // Grow an alternating path from row i until it reaches a free column
+        match_[0] = i;
+        int j0 = 0;
+        min_slack_.assign(n + 1, inf);
+        used_.assign(n + 1, 0);
+        do {
+            used_[j0] = 1;
+            const int i0 = match_[j0];
+            double delta = inf;
+            int j1 = 0;
+            for (int j = 1; j <= n; ++j) {
+                if (used_[j]) continue;
+                double slack = a_[i0 * stride + j] - u_[i0] - v_[j];
+                if (slack < min_slack_[j]) {
+                    min_slack_[j] = slack;
+                    way_[j] = j0;
+                }
+                if (min_slack_[j] < delta) {
+                    delta = min_slack_[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= n; ++j) {
+                if (used_[j]) {
+                    u_[match_[j]] += delta;
+                    v_[j] -= delta;
+                } else {
+                    min_slack_[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (match_[j0] != 0);
+        
+        // Flip the path
+        do {
+            const int j1 = way_[j0];
+            match_[j0] = match_[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+    
+    for (int j = 1; j <= cols; ++j) {
+        const int r = match_[j] - 1;
+        if (r >= 0 && r < rows && cost[static_cast<size_t>(r) * cols + (j - 1)] < max_cost) {
+            result[r] = j - 1;
+        }
+    }
+    return result;
+}
+
+} // namespace bbst::tracking
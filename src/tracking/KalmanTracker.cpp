@@ -11,6 +11,9 @@ KalmanTracker::KalmanTracker(const TrackerConfig& config)
     , last_size_(0.0f)
     , consecutive_good_detections_(0)
     , total_detections_(0)
+    , predicted_(false)
+    , frame_interval_s_(1.0f / 30.0f)
+    , track_frames_(0)
     , config_(config)
 {
     initKalmanFilter();
@@ -30,21 +33,36 @@ void KalmanTracker::initKalmanFilter() {
         1, 0, 0, 0,
         0, 1, 0, 0);
     
-    // Process noise
-    cv::setIdentity(kf_->processNoiseCov, cv::Scalar::all(1e-1));
+    // Process noise: white acceleration of std-dev process_noise (px/frame^2)
+    float q = config_.process_noise * config_.process_noise;
+    kf_->processNoiseCov = (cv::Mat_<float>(4, 4) << 
+        q / 4, 0,     q / 2, 0,
+        0,     q / 4, 0,     q / 2,
+        q / 2, 0,     q,     0,
+        0,     q / 2, 0,     q);
     
-    // Measurement noise
-    cv::setIdentity(kf_->measurementNoiseCov, cv::Scalar::all(2e-1));
+    // Measurement noise (px^2)
+    float r = config_.measurement_noise * config_.measurement_noise;
+    cv::setIdentity(kf_->measurementNoiseCov, cv::Scalar::all(r));
     
-    // Error covariance
-    cv::setIdentity(kf_->errorCovPost, cv::Scalar::all(1));
+    // Error covariance: position known to measurement accuracy, velocity
+    // anywhere up to max_velocity
+    float v = config_.max_velocity * config_.max_velocity;
+    kf_->errorCovPost = (cv::Mat_<float>(4, 4) << 
+        r, 0, 0, 0,
+        0, r, 0, 0,
+        0, 0, v, 0,
+        0, 0, 0, v);
 }
 
 void KalmanTracker::init(const cv::Point2f& initial_point, float size) {
     kf_->statePost = (cv::Mat_<float>(4, 1) << 
         initial_point.x, initial_point.y, 0, 0);
+    initKalmanFilter();  // Reset covariance for the new track
     
     initialized_ = true;
+    predicted_ = false;
+    predicted_position_ = initial_point;
     frames_without_detection_ = 0;
     last_position_ = initial_point;
     last_size_ = size;
@@ -53,13 +71,110 @@ void KalmanTracker::init(const cv::Point2f& initial_point, float size) {
     
     trajectory_ = Trajectory(config_.max_trajectory_length);  // Reset trajectory
     trajectory_ += initial_point;  // Use operator+= (Topic 23)
+    
+    kinematics_ = Kinematics();
+    track_frames_ = 0;
+    last_velocity_ = cv::Point2f();
+    acceleration_ = cv::Point2f();
+    updateKinematics();
+}
+
+void KalmanTracker::setFrameInterval(float seconds) {
+    if (seconds > 0.0f) frame_interval_s_ = seconds;
+}
+
+void KalmanTracker::updateKinematics() {
+    // statePost holds the current state after correct() and after predict()
+    const cv::Mat& state = kf_->statePost;
+    const cv::Point2f velocity(state.at<float>(2), state.at<float>(3));
+    const float dt = frame_interval_s_;
+    
+    if (track_frames_ > 0) {
+        acceleration_ += ((velocity - last_velocity_) - acceleration_) * 0.3f;
+        
+        // Newest segment of the trajectory ring
+        const size_t n = trajectory_.size();
+        if (n >= 2) {
+            kinematics_.path_length += static_cast<float>(cv::norm(trajectory_[n - 1] - trajectory_[n - 2]));
+        }
+    }
+    last_velocity_ = velocity;
+    track_frames_++;
+    
+    const float speed = static_cast<float>(cv::norm(velocity));
+    kinematics_.speed = speed / dt;
+    kinematics_.acceleration = static_cast<float>(cv::norm(acceleration_)) / (dt * dt);
+    kinematics_.curvature = speed > 0.5f
+        ? (velocity.x * acceleration_.y - velocity.y * acceleration_.x) / (speed * speed * speed)
+        : 0.0f;
+    kinematics_.flight_time = (track_frames_ - 1) * dt;
+    
+    // The ball's apparent size gives the local scale wherever it is in depth
+    if (config_.meters_per_pixel > 0.0f) {
+        kinematics_.meters_per_pixel = config_.meters_per_pixel;
+    } else if (config_.ball_diameter_m > 0.0f && last_size_ > 0.0f) {
+        const float scale = config_.ball_diameter_m / last_size_;
+        kinematics_.meters_per_pixel = kinematics_.meters_per_pixel > 0.0f
+            ? kinematics_.meters_per_pixel + (scale - kinematics_.meters_per_pixel) * 0.2f
+            : scale;
+    }
 }
 
 cv::Point2f KalmanTracker::predict() {
     if (!initialized_) return cv::Point2f(-1, -1);
+    if (predicted_) return predicted_position_;  // Already advanced this frame
     
     cv::Mat prediction = kf_->predict();
-    return cv::Point2f(prediction.at<float>(0), prediction.at<float>(1));
+    predicted_ = true;
+    predicted_position_ = cv::Point2f(prediction.at<float>(0), prediction.at<float>(1));
+    return predicted_position_;
+}
+
+void KalmanTracker::compensateCameraMotion(const cv::Point2f& shift) {
+    if (!initialized_) return;
+    
+    for (cv::Mat* state : {&kf_->statePre, &kf_->statePost}) {
+        state->at<float>(0) += shift.x;
+        state->at<float>(1) += shift.y;
+    }
+    predicted_position_ += shift;
+    last_position_ += shift;
+    trajectory_.translate(shift);  // Trail and path length stay in one frame
+}
+
+void KalmanTracker::ensurePredicted() {
+    // Validation and coasting reuse the caller's predict() for this frame
+    // instead of advancing the filter a second time
+    predict();
+}
+
+cv::Matx22f KalmanTracker::getInnovationCovariance() const {
+    // S = H P H^T + R, where H selects the position block
+    const cv::Mat& P = predicted_ ? kf_->errorCovPre : kf_->errorCovPost;
+    const cv::Mat& R = kf_->measurementNoiseCov;
+    return cv::Matx22f(
+        P.at<float>(0, 0) + R.at<float>(0, 0), P.at<float>(0, 1) + R.at<float>(0, 1),
+        P.at<float>(1, 0) + R.at<float>(1, 0), P.at<float>(1, 1) + R.at<float>(1, 1));
+}
+
+float KalmanTracker::mahalanobisDistance(const cv::Point2f& point) const {
+    cv::Vec2f innovation(point.x - predicted_position_.x,
+                         point.y - predicted_position_.y);
+    cv::Vec2f weighted = getInnovationCovariance().inv() * innovation;
+    return innovation.dot(weighted);
+}
+
+bool KalmanTracker::inGate(const cv::Point2f& point) const {
+    return mahalanobisDistance(point) <= config_.gate_chi2;
+}
+
+cv::Rect2f KalmanTracker::getSearchRegion() const {
+    // Axis-aligned extent of the ellipse {y : y^T S^-1 y <= gate}
+    cv::Matx22f S = getInnovationCovariance();
+    float half_w = std::sqrt(config_.gate_chi2 * S(0, 0)) + last_size_ / 2.0f;
+    float half_h = std::sqrt(config_.gate_chi2 * S(1, 1)) + last_size_ / 2.0f;
+    return cv::Rect2f(predicted_position_.x - half_w, predicted_position_.y - half_h,
+                      2.0f * half_w, 2.0f * half_h);
 }
 
 bool KalmanTracker::validateSize(float size) const {
@@ -72,17 +187,10 @@ bool KalmanTracker::validateAspectRatio(float width, float height) const {
            aspect_ratio <= config_.max_aspect_ratio;
 }
 
-bool KalmanTracker::validateVelocity(const cv::Point2f& new_point, 
-                                     const cv::Point2f& predicted) const {
-    float distance = cv::norm(new_point - predicted);
-    float max_allowed = config_.max_velocity * 2.0f;
-    
-    // Stricter when stable
-    if (consecutive_good_detections_ > 20) {
-        max_allowed = config_.max_velocity * 1.2f;
-    }
-    
-    return distance < max_allowed;
+bool KalmanTracker::validateVelocity(const cv::Point2f& new_point) const {
+    // Gate radius follows the filter's uncertainty: tight for confident
+    // tracks, wider after misses or sudden changes
+    return inGate(new_point);
 }
 
 bool KalmanTracker::isValidDetection(const cv::Point2f& measurement,
@@ -103,8 +211,8 @@ bool KalmanTracker::isValidDetection(const cv::Point2f& measurement,
     }
     
     // Velocity check
-    cv::Point2f predicted = const_cast<KalmanTracker*>(this)->predict();
-    if (frames_without_detection_ < 15 && !validateVelocity(measurement, predicted)) {
+    const_cast<KalmanTracker*>(this)->ensurePredicted();
+    if (!validateVelocity(measurement)) {
         return false;
     }
     
@@ -127,6 +235,7 @@ cv::Point2f KalmanTracker::update(const cv::Point2f& measurement_point, float si
     
     cv::Mat estimated = kf_->correct(measurement_);
     cv::Point2f corrected_point(estimated.at<float>(0), estimated.at<float>(1));
+    predicted_ = false;
     
     // Update trajectory using operator+= (Topic 23)
     trajectory_ += corrected_point;
@@ -136,6 +245,7 @@ cv::Point2f KalmanTracker::update(const cv::Point2f& measurement_point, float si
     total_detections_++;
     last_position_ = corrected_point;
     last_size_ = size;
+    updateKinematics();
     
     return corrected_point;
 }
@@ -149,11 +259,14 @@ cv::Point2f KalmanTracker::updateWithoutMeasurement() {
         consecutive_good_detections_--;
     }
     
-    cv::Point2f predicted = predict();
+    ensurePredicted();
+    cv::Point2f predicted = predicted_position_;
+    predicted_ = false;
     
     if (frames_without_detection_ <= config_.max_frames_without_detection) {
         trajectory_ += predicted;
         last_position_ = predicted;
+        updateKinematics();
     } else {
         reset();
     }
@@ -172,11 +285,14 @@ bool KalmanTracker::isStable() const {
 
 void KalmanTracker::reset() {
     initialized_ = false;
+    predicted_ = false;
     frames_without_detection_ = 0;
     consecutive_good_detections_ = 0;
     total_detections_ = 0;
     last_size_ = 0;
     trajectory_ = Trajectory(config_.max_trajectory_length);
+    kinematics_ = Kinematics();
+    track_frames_ = 0;
 }
 
 } // namespace bbst::tracking
\ No newline at end of file
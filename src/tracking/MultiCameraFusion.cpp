@@ -0,0 +1,490 @@
+#include "tracking/MultiCameraFusion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace bbst::tracking {
+
+// Triangulation
+
+// Eigenvector of the smallest eigenvalue of a symmetric 4x4 matrix (cyclic Jacobi)
+static cv::Vec4d smallestEigenvector(cv::Matx44d a) {
+    cv::Matx44d v = cv::Matx44d::eye();
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        double off = 0.0;
+        for (int p = 0; p < 4; ++p)
+            for (int q = p + 1; q < 4; ++q) off += a(p, q) * a(p, q);
+        if (off < 1e-24) break;
+        
+        for (int p = 0; p < 4; ++p) {
+            for (int q = p + 1; q < 4; ++q) {
+                if (std::abs(a(p, q)) < 1e-300) continue;
+                double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+                double t = (theta >= 0 ? 1.0 : -1.0) /
+                           (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+                for (int k = 0; k < 4; ++k) {
+                    double akp = a(k, p), akq = a(k, q);
+                    a(k, p) = c * akp - s * akq;
+                    a(k, q) = s * akp + c * akq;
+                }
+                for (int k = 0; k < 4; ++k) {
+                    double apk = a(p, k), aqk = a(q, k);
+                    a(p, k) = c * apk - s * aqk;
+                    a(q, k) = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 4; ++k) {
+                    double vkp = v(k, p), vkq = v(k, q);
+                    v(k, p) = c * vkp - s * vkq;
+                    v(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    
+    int best = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (a(i, i) < a(best, best)) best = i;
+    }
+    return cv::Vec4d(v(0, best), v(1, best), v(2, best), v(3, best));
+}
+
+// Projection of a world point; false when it is behind the camera
+static bool project(const cv::Matx34d& p, const cv::Point3d& x, cv::Point2d& uv) {
+    double u = p(0, 0) * x.x + p(0, 1) * x.y + p(0, 2) * x.z + p(0, 3);
+    double v = p(1, 0) * x.x + p(1, 1) * x.y + p(1, 2) * x.z + p(1, 3);
+    double w = p(2, 0) * x.x + p(2, 1) * x.y + p(2, 2) * x.z + p(2, 3);
+    if (w <= 1e-12) return false;
+    uv = cv::Point2d(u / w, v / w);
+    return true;
+}
+
+// DLT plus Gauss-Newton over the views in mask
+static Triangulation solveViews(const cv::Matx34d* projections, const cv::Point2f* points,
+                                int count, uint32_t mask) {
+    Triangulation result;
+    
+    // Normal matrix of the DLT system, rows normalized for conditioning
+    cv::Matx44d ata = cv::Matx44d::zeros();
+    int views = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!(mask & (1u << i))) continue;
+        const cv::Matx34d& p = projections[i];
+        const double xy[2] = {points[i].x, points[i].y};
+        for (int r = 0; r < 2; ++r) {
+            double row[4];
+            double norm = 0.0;
+            for (int k = 0; k < 4; ++k) {
+                row[k] = xy[r] * p(2, k) - p(r, k);
+                norm += row[k] * row[k];
+            }
+            norm = std::sqrt(norm);
+            if (norm < 1e-12) continue;
+            for (int j = 0; j < 4; ++j)
+                for (int k = 0; k < 4; ++k) ata(j, k) += row[j] * row[k] / (norm * norm);
+        }
+        views++;
+    }
+    if (views < 2) return result;
+    
+    cv::Vec4d h = smallestEigenvector(ata);
+    if (std::abs(h[3]) < 1e-12) return result;  // Point at infinity
+    cv::Point3d x(h[0] / h[3], h[1] / h[3], h[2] / h[3]);
+    
+    // Refine on the reprojection error, the quantity that is actually Gaussian
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        cv::Matx33d jtj = cv::Matx33d::zeros();
+        cv::Vec3d jtr(0.0, 0.0, 0.0);
+        bool in_front = true;
+        for (int i = 0; i < count && in_front; ++i) {
+            if (!(mask & (1u << i))) continue;
+            const cv::Matx34d& p = projections[i];
+            double num[3];
+            for (int r = 0; r < 3; ++r) {
+                num[r] = p(r, 0) * x.x + p(r, 1) * x.y + p(r, 2) * x.z + p(r, 3);
+            }
+            if (num[2] <= 1e-12) {
+                in_front = false;
+                break;
+            }
+            const double w = num[2];
+            const double residual[2] = {num[0] / w - points[i].x, num[1] / w - points[i].y};
+            for (int r = 0; r < 2; ++r) {
+                double j[3];
+                for (int k = 0; k < 3; ++k) {
+                    j[k] = (p(r, k) * w - num[r] * p(2, k)) / (w * w);
+                }
+                for (int a = 0; a < 3; ++a) {
+                    jtr[a] += j[a] * residual[r];
+                    for (int b = 0; b < 3; ++b) jtj(a, b) += j[a] * j[b];
+                }
+            }
+        }
+        if (!in_front) return result;
+        
+        double det = cv::determinant(jtj);
+        if (std::abs(det) < 1e-300) break;
+        cv::Vec3d step = jtj.inv() * jtr;
+        x -= cv::Point3d(step[0], step[1], step[2]);
+        if (cv::norm(step) < 1e-9) break;
+    }
+    
+    // Final error, and every view must see the point in front of it
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) {
+        if (!(mask & (1u << i))) continue;
+        cv::Point2d uv;
+        if (!project(projections[i], x, uv)) return result;
+        double dx = uv.x - points[i].x;
+        double dy = uv.y - points[i].y;
+        sum += dx * dx + dy * dy;
+    }
+    
+    result.valid = true;
+    result.point = x;
+    result.views = views;
+    result.view_mask = mask;
+    result.reprojection_px = std::sqrt(sum / views);
+    return result;
+}
+
+Triangulation triangulate(const cv::Matx34d* projections, const cv::Point2f* points, int count,
+                          double max_reprojection_px) {
+    count = std::min(count, 32);
+    uint32_t mask = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1u;
+    Triangulation result = solveViews(projections, points, count, mask);
+    
+    // Drop the worst view while the rest disagree (a false detection in one camera)
+    while (result.valid && result.views > 2 && result.reprojection_px > max_reprojection_px) {
+        int worst = -1;
+        double worst_error = -1.0;
+        for (int i = 0; i < count; ++i) {
+            if (!(mask & (1u << i))) continue;
+            cv::Point2d uv;
+            project(projections[i], result.point, uv);
+            double error = std::hypot(uv.x - points[i].x, uv.y - points[i].y);
+            if (error > worst_error) {
+                worst_error = error;
+                worst = i;
+            }
+        }
+        mask &= ~(1u << worst);
+        result = solveViews(projections, points, count, mask);
+    }
+    return result;
+}
+
+cv::Matx33d fundamentalFromProjections(const cv::Matx34d& p1, const cv::Matx34d& p2) {
+    // Camera 1 center: C = -M^-1 p4 for P1 = [M | p4]
+    cv::Matx33d m;
+    cv::Vec3d p4;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) m(r, c) = p1(r, c);
+        p4[r] = p1(r, 3);
+    }
+    cv::Vec3d c = -(m.inv() * p4);
+    cv::Vec4d center(c[0], c[1], c[2], 1.0);
+    
+    // Epipole in view 2 and the pseudo-inverse of P1
+    cv::Vec3d e = p2 * center;
+    cv::Matx33d ex(0.0, -e[2], e[1],
+                   e[2], 0.0, -e[0],
+                   -e[1], e[0], 0.0);
+    cv::Matx43d p1_pinv = p1.t() * (p1 * p1.t()).inv();
+    return ex * (p2 * p1_pinv);
+}
+
+double epipolarDistance(const cv::Matx33d& f, const cv::Point2f& x1, const cv::Point2f& x2) {
+    cv::Vec3d a(x1.x, x1.y, 1.0);
+    cv::Vec3d b(x2.x, x2.y, 1.0);
+    cv::Vec3d line2 = f * a;
+    cv::Vec3d line1 = f.t() * b;
+    double e = std::abs(b.dot(line2));
+    double n2 = std::hypot(line2[0], line2[1]);
+    double n1 = std::hypot(line1[0], line1[1]);
+    if (n1 < 1e-12 || n2 < 1e-12) return std::numeric_limits<double>::infinity();
+    return 0.5 * (e / n2 + e / n1);
+}
+
+// BallKalman3D
+
+BallKalman3D::BallKalman3D(const cv::Vec3d& gravity, double process_noise,
+                           double measurement_noise)
+    : x_(cv::Matx<double, 6, 1>::zeros())
+    , p_(cv::Matx<double, 6, 6>::eye())
+    , gravity_(gravity)
+    , process_noise_(process_noise)
+    , measurement_noise_(measurement_noise)
+    , initialized_(false)
+{
+}
+
+void BallKalman3D::init(const cv::Point3d& position, double max_speed) {
+    x_ = cv::Matx<double, 6, 1>::zeros();
+    x_(0) = position.x;
+    x_(1) = position.y;
+    x_(2) = position.z;
+    
+    // Position known to measurement accuracy, velocity anywhere up to max_speed
+    p_ = cv::Matx<double, 6, 6>::zeros();
+    const double r = measurement_noise_ * measurement_noise_;
+    const double v = max_speed * max_speed;
+    for (int i = 0; i < 3; ++i) {
+        p_(i, i) = r;
+        p_(i + 3, i + 3) = v;
+    }
+    initialized_ = true;
+}
+
+void BallKalman3D::predict(double dt) {
+    if (!initialized_ || dt <= 0.0) return;
+    
+    // Ballistic flight: gravity is a known input, everything else is noise
+    cv::Matx<double, 6, 6> f = cv::Matx<double, 6, 6>::eye();
+    for (int i = 0; i < 3; ++i) f(i, i + 3) = dt;
+    x_ = f * x_;
+    for (int i = 0; i < 3; ++i) {
+        x_(i) += 0.5 * gravity_[i] * dt * dt;
+        x_(i + 3) += gravity_[i] * dt;
+    }
+    
+    const double q = process_noise_ * process_noise_;
+    cv::Matx<double, 6, 6> noise = cv::Matx<double, 6, 6>::zeros();
+    for (int i = 0; i < 3; ++i) {
+        noise(i, i) = q * dt * dt * dt * dt / 4.0;
+        noise(i, i + 3) = noise(i + 3, i) = q * dt * dt * dt / 2.0;
+        noise(i + 3, i + 3) = q * dt * dt;
+    }
+    p_ = f * p_ * f.t() + noise;
+}
+
+double BallKalman3D::mahalanobis(const cv::Point3d& measurement) const {
+    cv::Matx33d s;
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) s(r, c) = p_(r, c);
+    const double noise = measurement_noise_ * measurement_noise_;
+    for (int i = 0; i < 3; ++i) s(i, i) += noise;
+    
+    cv::Vec3d y(measurement.x - x_(0), measurement.y - x_(1), measurement.z - x_(2));
+    return y.dot(s.inv() * y);
+}
+
+void BallKalman3D::update(const cv::Point3d& measurement) {
+    // H = [I 0]: S = P_pp + R, K = P_:p S^-1
+    cv::Matx33d s;
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) s(r, c) = p_(r, c);
+    const double noise = measurement_noise_ * measurement_noise_;
+    for (int i = 0; i < 3; ++i) s(i, i) += noise;
+    const cv::Matx33d s_inv = s.inv();
+    
+    cv::Matx<double, 6, 3> pht;
+    for (int r = 0; r < 6; ++r)
+        for (int c = 0; c < 3; ++c) pht(r, c) = p_(r, c);
+    const cv::Matx<double, 6, 3> k = pht * s_inv;
+    
+    cv::Vec3d y(measurement.x - x_(0), measurement.y - x_(1), measurement.z - x_(2));
+    x_ += k * y;
+    
+    // P -= K H P, where H P is the top three rows of P
+    p_ -= k * pht.t();
+}
+
+// MultiCameraFusion
+
+MultiCameraFusion::MultiCameraFusion(const std::vector<cv::Matx34d>& projections,
+                                     const FusionConfig& config)
+    : num_cameras_(static_cast<int>(projections.size()))
+    , config_(config)
+    , filter_(config.gravity, config.process_noise, config.measurement_noise)
+    , last_time_ms_(0.0)
+    , missed_(0)
+    , frames_(0)
+    , next_offset_camera_(1)
+{
+    if (num_cameras_ < 2 || num_cameras_ > MAX_CAMERAS) {
+        throw std::invalid_argument("Fusion needs 2 to 8 cameras");
+    }
+    for (int i = 0; i < num_cameras_; ++i) {
+        cameras_[i].projection = projections[i];
+        cameras_[i].fundamental = i == 0 ? cv::Matx33d::zeros()
+                                         : fundamentalFromProjections(projections[0], projections[i]);
+    }
+    cameras_[0].offset_known = true;
+}
+
+void MultiCameraFusion::addObservation(int camera, double timestamp_ms, const cv::Point2f& point) {
+    if (camera < 0 || camera >= num_cameras_) return;
+    Camera& cam = cameras_[camera];
+    if (cam.count > 0 && timestamp_ms <= sample(cam, 0).time_ms) return;  // Out of order
+    
+    cam.ring[cam.head].time_ms = timestamp_ms;
+    cam.ring[cam.head].point = point;
+    cam.head = (cam.head + 1) % HISTORY;
+    cam.count = std::min(cam.count + 1, HISTORY);
+}
+
+void MultiCameraFusion::setClockOffsetMs(int camera, double offset_ms) {
+    if (camera <= 0 || camera >= num_cameras_) return;
+    cameras_[camera].offset_ms = offset_ms;
+    cameras_[camera].offset_known = true;
+}
+
+const MultiCameraFusion::Sample& MultiCameraFusion::sample(const Camera& camera, int age) const {
+    return camera.ring[(camera.head - 1 - age + 2 * HISTORY) % HISTORY];
+}
+
+bool MultiCameraFusion::interpolate(const Camera& camera, double time_ms, bool extrapolate,
+                                    cv::Point2f& point) const {
+    if (camera.count == 0) return false;
+    
+    // Newest sample at or before time_ms (times decrease with age)
+    int lo = 0;
+    int hi = camera.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (sample(camera, mid).time_ms <= time_ms) hi = mid;
+        else lo = mid + 1;
+    }
+    if (lo == camera.count) return false;  // Older than the history
+    
+    const Sample& before = sample(camera, lo);
+    if (lo == 0) {
+        if (before.time_ms == time_ms) {
+            point = before.point;
+            return true;
+        }
+        
+        // Ahead of the newest sample: the camera's next frame has not arrived yet
+        if (!extrapolate || camera.count < 2 || time_ms - before.time_ms > config_.max_extrapolate_ms) {
+            return false;
+        }
+        const Sample& older = sample(camera, 1);
+        double span = before.time_ms - older.time_ms;
+        if (span > config_.max_interp_gap_ms) return false;
+        float a = static_cast<float>((time_ms - before.time_ms) / span);
+        point = before.point + (before.point - older.point) * a;
+        return true;
+    }
+    
+    const Sample& after = sample(camera, lo - 1);
+    double span = after.time_ms - before.time_ms;
+    if (span > config_.max_interp_gap_ms) return false;
+    float a = static_cast<float>((time_ms - before.time_ms) / span);
+    point = before.point + (after.point - before.point) * a;
+    return true;
+}
+
+bool MultiCameraFusion::estimateClockOffset(int camera, double& offset_ms) const {
+    if (camera <= 0 || camera >= num_cameras_) return false;
+    const Camera& ref = cameras_[0];
+    const Camera& cam = cameras_[camera];
+    const double cap = 20.0;  // px; one bad pair must not dominate
+    
+    const int steps = static_cast<int>(config_.max_offset_ms / config_.offset_step_ms);
+    std::array<double, 2 * 1024 + 1> costs;
+    if (steps <= 0 || 2 * steps + 1 > static_cast<int>(costs.size())) return false;
+    
+    int best = -1;
+    for (int s = -steps; s <= steps; ++s) {
+        const double delta = s * config_.offset_step_ms;
+        double sum = 0.0;
+        int matched = 0;
+        for (int age = 0; age < ref.count; ++age) {
+            const Sample& r = sample(ref, age);
+            cv::Point2f p;
+            if (!interpolate(cam, r.time_ms + delta, false, p)) continue;
+            sum += std::min(cap, epipolarDistance(cam.fundamental, r.point, p));
+            matched++;
+        }
+        double& cost = costs[s + steps];
+        cost = matched >= config_.offset_min_samples ? sum / matched
+                                                     : std::numeric_limits<double>::infinity();
+        if (best < 0 || cost < costs[best]) best = s + steps;
+    }
+    if (best < 0 || !std::isfinite(costs[best])) return false;
+    
+    // Sub-step refinement by a parabola through the neighbours
+    double refined = best - steps;
+    if (best > 0 && best < 2 * steps && std::isfinite(costs[best - 1]) &&
+        std::isfinite(costs[best + 1])) {
+        double denom = costs[best - 1] - 2.0 * costs[best] + costs[best + 1];
+        if (denom > 1e-12) {
+            refined += 0.5 * (costs[best - 1] - costs[best + 1]) / denom;
+        }
+    }
+    offset_ms = refined * config_.offset_step_ms;
+    return true;
+}
+
+FusedBall MultiCameraFusion::fuse(double timestamp_ms) {
+    frames_++;
+    
+    // Clock offsets drift slowly: refresh one camera per interval, round robin
+    if (config_.offset_interval > 0 && frames_ % config_.offset_interval == 0) {
+        const int camera = next_offset_camera_;
+        next_offset_camera_ = next_offset_camera_ % (num_cameras_ - 1) + 1;
+        double estimate;
+        if (estimateClockOffset(camera, estimate)) {
+            Camera& cam = cameras_[camera];
+            cam.offset_ms = cam.offset_known
+                ? cam.offset_ms + config_.offset_smoothing * (estimate - cam.offset_ms)
+                : estimate;
+            cam.offset_known = true;
+        }
+    }
+    
+    // Every camera's view of the ball at this instant
+    std::array<cv::Matx34d, MAX_CAMERAS> projections;
+    std::array<cv::Point2f, MAX_CAMERAS> points;
+    int views = 0;
+    for (int i = 0; i < num_cameras_; ++i) {
+        const Camera& cam = cameras_[i];
+        if (interpolate(cam, timestamp_ms + cam.offset_ms, true, points[views])) {
+            projections[views] = cam.projection;
+            views++;
+        }
+    }
+    
+    if (filter_.initialized()) {
+        filter_.predict((timestamp_ms - last_time_ms_) / 1000.0);
+    }
+    last_time_ms_ = timestamp_ms;
+    
+    Triangulation tri;
+    if (views >= 2) {
+        tri = triangulate(projections.data(), points.data(), views, config_.max_reprojection_px);
+    }
+    bool measured = tri.valid && tri.reprojection_px <= config_.max_reprojection_px;
+    if (measured) {
+        if (!filter_.initialized()) {
+            filter_.init(tri.point, config_.max_speed);
+        } else if (filter_.mahalanobis(tri.point) <= config_.gate_chi2) {
+            filter_.update(tri.point);
+        } else {
+            measured = false;
+        }
+    }
+    if (measured) {
+        missed_ = 0;
+    } else if (filter_.initialized() && ++missed_ > config_.max_missed) {
+        filter_.reset();
+        missed_ = 0;
+    }
+    
+    FusedBall result;
+    result.timestamp_ms = timestamp_ms;
+    result.valid = filter_.initialized();
+    result.measured = measured;
+    result.views = tri.valid ? tri.views : views;
+    result.reprojection_px = tri.reprojection_px;
+    if (result.valid) {
+        result.position = filter_.position();
+        result.velocity = filter_.velocity();
+    }
+    return result;
+}
+
+} // namespace bbst::tracking
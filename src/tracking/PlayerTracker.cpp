@@ -0,0 +1,166 @@
+#include "tracking/PlayerTracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace bbst::tracking {
+
+PlayerTracker::PlayerTracker(const PlayerTrackerConfig& config)
+    : config_(config)
+    , next_id_(1)
+{
+}
+
+Appearance PlayerTracker::appearance(const cv::Mat& bgr, const cv::Rect& box) {
+    Appearance histogram{};
+    
+    // Torso: below the head, above the shorts, away from the arms
+    cv::Rect torso(box.x + box.width / 4, box.y + box.height / 6,
+                   box.width / 2, box.height / 3);
+    torso &= cv::Rect(0, 0, bgr.cols, bgr.rows);
+    if (torso.empty()) return histogram;
+    
+    // A fixed grid of samples, so the cost does not grow with the box
+    const int samples = 12;
+    const int step_x = std::max(1, torso.width / samples);
+    const int step_y = std::max(1, torso.height / samples);
+    float total = 0.0f;
+    for (int y = torso.y + step_y / 2; y < torso.br().y; y += step_y) {
+        const cv::Vec3b* row = bgr.ptr<cv::Vec3b>(y);
+        for (int x = torso.x + step_x / 2; x < torso.br().x; x += step_x) {
+            const int b = row[x][0];
+            const int g = row[x][1];
+            const int r = row[x][2];
+            const int max = std::max({r, g, b});
+            const int min = std::min({r, g, b});
+            const int chroma = max - min;
+            
+            int bin;
+            if (max == 0 || chroma * 4 < max) {
+                bin = 24 + max * 8 / 256;   // Low saturation: brightness only
+            } else {
+                float hue;                  // [0, 6)
+                if (max == r) hue = static_cast<float>(g - b) / chroma + (g < b ? 6.0f : 0.0f);
+                else if (max == g) hue = static_cast<float>(b - r) / chroma + 2.0f;
+                else hue = static_cast<float>(r - g) / chroma + 4.0f;
+                int hue_bin = std::min(7, static_cast<int>(hue * 8.0f / 6.0f));
+                int saturation_bin = std::min(2, chroma * 3 / (max + 1));
+                bin = hue_bin * 3 + saturation_bin;
+            }
+            histogram[bin] += 1.0f;
+            total += 1.0f;
+        }
+    }
+    
+    for (auto& value : histogram) value /= total;
+    return histogram;
+}
+
+float PlayerTracker::appearanceDistance(const Appearance& a, const Appearance& b) {
+    float coefficient = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        coefficient += std::sqrt(a[i] * b[i]);
+    }
+    return std::sqrt(std::max(0.0f, 1.0f - coefficient));
+}
+
+float PlayerTracker::iou(const cv::Rect2f& a, const cv::Rect2f& b) {
+    const float overlap = (a & b).area();
+    const float joint = a.area() + b.area() - overlap;
+    return joint > 0.0f ? overlap / joint : 0.0f;
+}
+
+void PlayerTracker::predict() {
+    for (auto& track : tracks_) {
+        track.box.x += track.velocity.x;
+        track.box.y += track.velocity.y;
+    }
+}
+
+void PlayerTracker::update(const cv::Mat& frame, const std::vector<Detection<>>& detections,
+                           int person_class) {
+    predict();
+    
+    people_.clear();
+    appearances_.clear();
+    for (const auto& det : detections) {
+        if (det.class_id != person_class) continue;
+        people_.push_back(&det);
+        appearances_.push_back(appearance(frame, det.box));
+    }
+    
+    // Gated IoU + appearance costs, tracks x people
+    const int rows = static_cast<int>(tracks_.size());
+    const int cols = static_cast<int>(people_.size());
+    cost_.assign(static_cast<size_t>(rows) * cols, config_.max_cost);
+    for (int t = 0; t < rows; ++t) {
+        for (int p = 0; p < cols; ++p) {
+            float overlap = iou(tracks_[t].box, cv::Rect2f(people_[p]->box));
+            if (overlap < config_.min_iou) continue;
+            cost_[static_cast<size_t>(t) * cols + p] = (1.0f - overlap) + config_.appearance_weight *
+                appearanceDistance(tracks_[t].appearance, appearances_[p]);
+        }
+    }
+    const std::vector<int>& match = solver_.solve(cost_, rows, cols, config_.max_cost);
+    
+    claimed_.assign(cols, 0);
+    for (int t = 0; t < rows; ++t) {
+        PlayerTrack& track = tracks_[t];
+        if (match[t] < 0) {
+            track.misses++;
+            continue;
+        }
+        
+        const int p = match[t];
+        claimed_[p] = 1;
+        const cv::Rect2f measured(people_[p]->box);
+        const cv::Point2f predicted_center(track.box.x + track.box.width / 2.0f,
+                                           track.box.y + track.box.height / 2.0f);
+        const cv::Point2f innovation =
+            cv::Point2f(measured.x + measured.width / 2.0f, measured.y + measured.height / 2.0f) -
+            predicted_center;
+        const cv::Point2f center = predicted_center + innovation * config_.position_gain;
+        track.velocity += innovation * config_.velocity_gain;
+        track.box.width += (measured.width - track.box.width) * config_.position_gain;
+        track.box.height += (measured.height - track.box.height) * config_.position_gain;
+        track.box.x = center.x - track.box.width / 2.0f;
+        track.box.y = center.y - track.box.height / 2.0f;
+        
+        for (size_t i = 0; i < track.appearance.size(); ++i) {
+            track.appearance[i] += (appearances_[p][i] - track.appearance[i]) * config_.appearance_rate;
+        }
+        track.hits++;
+        track.misses = 0;
+    }
+    
+    // Lost tracks go; tentative ones on their first miss
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(), [this](const PlayerTrack& track) {
+        return track.misses > config_.max_misses ||
+               (track.hits < config_.min_hits && track.misses > 0);
+    }), tracks_.end());
+    
+    for (int p = 0; p < cols; ++p) {
+        if (claimed_[p]) continue;
+        PlayerTrack track;
+        track.id = next_id_++;
+        track.box = cv::Rect2f(people_[p]->box);
+        track.appearance = appearances_[p];
+        track.hits = 1;
+        tracks_.push_back(track);
+    }
+    refreshConfirmed();
+}
+
+void PlayerTracker::coast() {
+    predict();
+    refreshConfirmed();
+}
+
+void PlayerTracker::refreshConfirmed() {
+    // Keeps its capacity, so steady-state frames don't allocate
+    confirmed_.clear();
+    for (const auto& track : tracks_) {
+        if (track.hits >= config_.min_hits) confirmed_.push_back(track);
+    }
+}
+
+} // namespace bbst::tracking
@@ -0,0 +1,121 @@
+#include "util/BufferPool.hpp"
+#include <new>
+#include <sys/mman.h>
+
+namespace bbst::util {
+
+static constexpr size_t PAGE_SIZE = 4096;
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+BufferPool::BufferPool(const BufferPoolConfig& config)
+    : config_(config)
+{
+}
+
+BufferPool::~BufferPool() {
+    trim();
+}
+
+size_t BufferPool::sizeClass(size_t bytes) const {
+    size_t size = bytes < config_.min_bytes ? config_.min_bytes : bytes;
+    
+    // Four classes per power of two: step is a quarter of the next lower one
+    size_t power = 1;
+    while (power * 2 < size) {
+        power *= 2;
+    }
+    size_t step = power >= 4 ? power / 4 : 1;
+    size = roundUp(size, step);
+    
+    // Only classes of a huge page or more are rounded to one; padding a
+    // 300 KB blob to 2 MB would waste most of it
+    const bool huge = config_.huge_pages && size >= HUGE_PAGE_SIZE;
+    return roundUp(size, huge ? HUGE_PAGE_SIZE : PAGE_SIZE);
+}
+
+void* BufferPool::map(size_t bytes) {
+    const bool huge = config_.huge_pages && bytes >= HUGE_PAGE_SIZE;
+    if (huge) {
+#ifdef MAP_HUGETLB
+        // Only succeeds when pages are reserved (vm.nr_hugepages)
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) return p;
+#endif
+    }
+    
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return nullptr;
+
+#ifdef MADV_HUGEPAGE
+    if (huge) {
+        ::madvise(p, bytes, MADV_HUGEPAGE);  // Best effort
+    }
+#endif
+    return p;
+}
+
+void* BufferPool::acquire(size_t bytes) {
+    const size_t cls = sizeClass(bytes);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_lists_.find(cls);
+        if (it != free_lists_.end() && !it->second.empty()) {
+            void* buffer = it->second.back();
+            it->second.pop_back();
+            stats_.hits++;
+            stats_.cached_bytes -= cls;
+            return buffer;
+        }
+        stats_.misses++;
+        stats_.mapped_bytes += cls;
+    }
+    
+    // Map outside the lock; faults are taken by whoever first writes
+    void* buffer = map(cls);
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.mapped_bytes -= cls;
+        throw std::bad_alloc();
+    }
+    return buffer;
+}
+
+void BufferPool::release(void* buffer, size_t bytes) {
+    if (buffer == nullptr) return;
+    const size_t cls = sizeClass(bytes);
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stats_.cached_bytes + cls <= config_.max_cached_bytes) {
+            free_lists_[cls].push_back(buffer);
+            stats_.cached_bytes += cls;
+            return;
+        }
+        stats_.mapped_bytes -= cls;
+    }
+    ::munmap(buffer, cls);
+}
+
+void BufferPool::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [cls, buffers] : free_lists_) {
+        for (void* buffer : buffers) {
+            ::munmap(buffer, cls);
+        }
+        stats_.mapped_bytes -= cls * buffers.size();
+        buffers.clear();
+    }
+    stats_.cached_bytes = 0;
+}
+
+BufferPoolStats BufferPool::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace bbst::util
@@ -0,0 +1,103 @@
+#include "util/EnergyMeter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace bbst::util {
+
+namespace fs = std::filesystem;
+
+bool EnergyMeter::readCounter(const std::string& path, uint64_t& value) {
+    std::ifstream in(path);
+    unsigned long long raw = 0;
+    if (!(in >> raw)) return false;
+    value = raw;
+    return true;
+}
+
+EnergyMeter::EnergyMeter(const std::string& powercap_root) {
+    std::error_code ec;
+    std::vector<fs::path> zones;
+    for (const auto& entry : fs::directory_iterator(powercap_root, ec)) {
+        // Zones are "intel-rapl:P" (package) and "intel-rapl:P:S" (subzones);
+        // "intel-rapl-mmio:*" duplicates the package counters
+        std::string zone = entry.path().filename().string();
+        if (zone.rfind("intel-rapl:", 0) == 0) {
+            zones.push_back(entry.path());
+        }
+    }
+    std::sort(zones.begin(), zones.end());
+    
+    for (const auto& zone : zones) {
+        std::string name;
+        std::ifstream name_file(zone / "name");
+        if (!std::getline(name_file, name)) continue;
+        
+        // core/uncore are part of the package, psys is the whole platform
+        const bool package = name.rfind("package", 0) == 0;
+        const bool dram = name == "dram";
+        if (!package && !dram) continue;
+        
+        Domain domain;
+        domain.energy_path = (zone / "energy_uj").string();
+        domain.dram = dram;
+        if (!readCounter(domain.energy_path, domain.last_uj)) continue;  // Not readable
+        readCounter((zone / "max_energy_range_uj").string(), domain.max_range_uj);
+        domains_.push_back(domain);
+    }
+    
+    start();
+}
+
+void EnergyMeter::start() {
+    for (auto& domain : domains_) {
+        readCounter(domain.energy_path, domain.last_uj);
+        domain.accumulated_uj = 0;
+    }
+    start_time_ = std::chrono::steady_clock::now();
+}
+
+void EnergyMeter::update() {
+    for (auto& domain : domains_) {
+        uint64_t now = 0;
+        if (!readCounter(domain.energy_path, now)) continue;
+        
+        if (now >= domain.last_uj) {
+            domain.accumulated_uj += now - domain.last_uj;
+        } else if (domain.max_range_uj > domain.last_uj) {
+            // Wrapped once since the last update
+            domain.accumulated_uj += domain.max_range_uj - domain.last_uj + now + 1;
+        }
+        domain.last_uj = now;
+    }
+}
+
+EnergySample EnergyMeter::read() {
+    EnergySample sample;
+    if (!available()) return sample;
+    
+    update();
+    sample.valid = true;
+    for (const auto& domain : domains_) {
+        double joules = domain.accumulated_uj / 1e6;
+        (domain.dram ? sample.dram_joules : sample.package_joules) += joules;
+    }
+    sample.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time_).count();
+    return sample;
+}
+
+std::string formatEnergy(const EnergySample& sample, int frames) {
+    if (!sample.valid) {
+        return "unavailable (RAPL not readable)";
+    }
+    
+    char text[160];
+    std::snprintf(text, sizeof(text), "%.1f J (package %.1f J, DRAM %.1f J), %.3f J/frame, %.1f W",
+                  sample.totalJoules(), sample.package_joules, sample.dram_joules,
+                  frames > 0 ? sample.totalJoules() / frames : 0.0, sample.watts());
+    return text;
+}
+
+} // namespace bbst::util
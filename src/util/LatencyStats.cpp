@@ -0,0 +1,39 @@
+#include "util/LatencyStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace bbst::util {
+
+void LatencyStats::record(int64_t latency_us) {
+    samples_.push_back(latency_us);
+    sum_ += latency_us;
+}
+
+double LatencyStats::meanMs() const {
+    return samples_.empty() ? 0.0 : sum_ / 1000.0 / samples_.size();
+}
+
+double LatencyStats::percentileMs(double p) const {
+    if (samples_.empty()) return 0.0;
+    
+    std::vector<int64_t> sorted(samples_);
+    size_t rank = static_cast<size_t>(std::ceil(std::clamp(p, 0.0, 1.0) * sorted.size()));
+    size_t index = rank == 0 ? 0 : rank - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index] / 1000.0;
+}
+
+double LatencyStats::maxMs() const {
+    return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end()) / 1000.0;
+}
+
+std::string LatencyStats::summary() const {
+    char text[160];
+    std::snprintf(text, sizeof(text), "n=%zu mean %.1f p50 %.1f p90 %.1f p99 %.1f max %.1f ms",
+                  count(), meanMs(), percentileMs(0.5), percentileMs(0.9),
+                  percentileMs(0.99), maxMs());
+    return text;
+}
+
+} // namespace bbst::util
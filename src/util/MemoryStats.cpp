@@ -0,0 +1,173 @@
+#include "util/MemoryStats.hpp"
+#include <cstdio>
+#include <iomanip>
+#include <unistd.h>
+
+namespace bbst::util {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemTag::Count);
+
+// One cache line per tag: threads allocating for different subsystems
+// don't contend
+struct alignas(64) TagCounters {
+    std::atomic<int64_t> live{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+};
+
+TagCounters g_counters[TAG_COUNT];
+thread_local MemTag tl_tag = MemTag::Other;
+
+TagCounters& counters(MemTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return g_counters[index < TAG_COUNT ? index : 0];
+}
+
+} // namespace
+
+const char* memTagName(MemTag tag) {
+    switch (tag) {
+        case MemTag::Decode: return "decode";
+        case MemTag::Dnn: return "dnn";
+        case MemTag::Render: return "render";
+        case MemTag::Tracking: return "tracking";
+        default: return "other";
+    }
+}
+
+void MemoryStats::recordAllocation(MemTag tag, size_t bytes) {
+    TagCounters& c = counters(tag);
+    int64_t live = c.live.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                   static_cast<int64_t>(bytes);
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    
+    int64_t peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryStats::recordFree(MemTag tag, size_t bytes) {
+    TagCounters& c = counters(tag);
+    c.live.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+TagStats MemoryStats::snapshot(MemTag tag) {
+    const TagCounters& c = counters(tag);
+    TagStats stats;
+    stats.live_bytes = c.live.load(std::memory_order_relaxed);
+    stats.peak_bytes = c.peak.load(std::memory_order_relaxed);
+    stats.allocations = c.allocations.load(std::memory_order_relaxed);
+    stats.frees = c.frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryStats::reset() {
+    for (auto& c : g_counters) {
+        // Live bytes stay: the memory is still out there
+        c.peak.store(c.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        c.allocations.store(0, std::memory_order_relaxed);
+        c.frees.store(0, std::memory_order_relaxed);
+    }
+}
+
+MemTag MemoryStats::currentTag() {
+    return tl_tag;
+}
+
+void MemoryStats::setCurrentTag(MemTag tag) {
+    tl_tag = tag;
+}
+
+int64_t MemoryStats::residentBytes() {
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return 0;
+    
+    long pages = 0, resident = 0;
+    int n = std::fscanf(statm, "%ld %ld", &pages, &resident);
+    std::fclose(statm);
+    return n == 2 ? static_cast<int64_t>(resident) * sysconf(_SC_PAGESIZE) : 0;
+}
+
+void MemoryStats::report(std::ostream& os) {
+    constexpr double MB = 1024.0 * 1024.0;
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    
+    os << "Memory by subsystem (live / peak MB, allocations, frees):" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        MemTag tag = static_cast<MemTag>(i);
+        TagStats stats = snapshot(tag);
+        if (stats.allocations == 0 && stats.live_bytes == 0) continue;
+        
+        os << "  " << std::left << std::setw(10) << memTagName(tag) << std::right
+           << std::setw(9) << stats.live_bytes / MB << " / "
+           << std::setw(9) << stats.peak_bytes / MB
+           << std::setw(12) << stats.allocations
+           << std::setw(12) << stats.frees << "\n";
+    }
+    os << "  RSS " << residentBytes() / MB << " MB" << std::endl;
+    
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    void* p = upstream_->allocate(bytes, alignment);
+    MemoryStats::recordAllocation(tag_, bytes);
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+    MemoryStats::recordFree(tag_, bytes);
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+std::pmr::memory_resource* taggedResource(MemTag tag) {
+    // Never destroyed: containers in static objects may release memory late
+    static CountingResource* resources[TAG_COUNT] = {
+        new CountingResource(MemTag::Other),
+        new CountingResource(MemTag::Decode),
+        new CountingResource(MemTag::Dnn),
+        new CountingResource(MemTag::Render),
+        new CountingResource(MemTag::Tracking),
+    };
+    size_t index = static_cast<size_t>(tag);
+    return resources[index < TAG_COUNT ? index : 0];
+}
+
+MemoryReporter::MemoryReporter(std::chrono::milliseconds interval, std::ostream& out)
+    : interval_(interval)
+    , out_(out)
+    , stop_(false)
+    , thread_(&MemoryReporter::run, this)
+{
+}
+
+MemoryReporter::~MemoryReporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    MemoryStats::report(out_);
+}
+
+void MemoryReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, interval_, [this] { return stop_; })) {
+        MemoryStats::report(out_);
+    }
+}
+
+} // namespace bbst::util
@@ -0,0 +1,70 @@
+#include "util/PooledMatAllocator.hpp"
+
+namespace bbst::util {
+
+PooledMatAllocator::PooledMatAllocator(const BufferPoolConfig& config)
+    : pool_(config)
+{
+}
+
+cv::UMatData* PooledMatAllocator::allocate(int dims, const int* sizes, int type, void* data,
+                                           size_t* step, cv::AccessFlag /*flags*/,
+                                           cv::UMatUsageFlags /*usage*/) const {
+    // Same layout rules as OpenCV's StdMatAllocator: honour caller steps
+    // for user data, otherwise fill in dense ones
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims - 1; i >= 0; i--) {
+        if (step != nullptr) {
+            if (data != nullptr && step[i] != CV_AUTOSTEP) {
+                total = step[i];
+            } else {
+                step[i] = total;
+            }
+        }
+        total *= sizes[i];
+    }
+    
+    uchar* buffer = static_cast<uchar*>(data);
+    if (buffer == nullptr) {
+        buffer = static_cast<uchar*>(pool_.pooled(total) ? pool_.acquire(total)
+                                                         : cv::fastMalloc(total));
+    }
+    
+    cv::UMatData* u = new cv::UMatData(this);
+    u->data = u->origdata = buffer;
+    u->size = total;
+    if (data != nullptr) {
+        u->flags |= cv::UMatData::USER_ALLOCATED;
+    }
+    return u;
+}
+
+bool PooledMatAllocator::allocate(cv::UMatData* data, cv::AccessFlag /*access*/,
+                                  cv::UMatUsageFlags /*usage*/) const {
+    return data != nullptr;
+}
+
+void PooledMatAllocator::deallocate(cv::UMatData* data) const {
+    if (data == nullptr) return;
+    
+    CV_Assert(data->urefcount == 0);
+    CV_Assert(data->refcount == 0);
+    if (!(data->flags & cv::UMatData::USER_ALLOCATED)) {
+        if (pool_.pooled(data->size)) {
+            pool_.release(data->origdata, data->size);
+        } else {
+            cv::fastFree(data->origdata);
+        }
+        data->origdata = nullptr;
+    }
+    delete data;
+}
+
+PooledMatAllocator& PooledMatAllocator::install(const BufferPoolConfig& config) {
+    // Never destroyed: Mats in static objects are released after main returns
+    static PooledMatAllocator* allocator = new PooledMatAllocator(config);
+    cv::Mat::setDefaultAllocator(allocator);
+    return *allocator;
+}
+
+} // namespace bbst::util
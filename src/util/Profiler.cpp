@@ -0,0 +1,312 @@
+#include "util/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace bbst::util {
+
+namespace {
+
+constexpr int MAX_DEPTH = 64;
+constexpr int SKIP_FRAMES = 2;          // Signal handler and the kernel's sigreturn trampoline
+constexpr uint64_t RING_SIZE = 4096;    // Samples per thread between collector passes
+
+struct Sample {
+    uint16_t zone;
+    uint16_t depth;
+    void* pcs[MAX_DEPTH];
+};
+
+// Written only by the signal handler of its own thread, read only by the
+// collector: head/tail make it a wait-free single-producer ring
+struct ThreadBuffer {
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    Sample samples[RING_SIZE];
+    timer_t timer{};
+    bool has_timer = false;
+};
+
+using StackKey = std::pair<uint16_t, std::vector<void*>>;
+
+struct ProfilerState {
+    std::mutex mutex;                                   // Guards everything below
+    ProfilerConfig config;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; // Kept until exit: handlers may still hold them
+    std::map<StackKey, uint64_t> stacks;
+    std::vector<std::string> zone_names{"(none)"};
+    std::thread collector;
+    bool collector_stop = false;
+};
+
+ProfilerState& state() {
+    static ProfilerState* instance = new ProfilerState();  // Never destroyed (signals may outlive statics)
+    return *instance;
+}
+
+std::atomic<bool> g_active{false};
+thread_local ThreadBuffer* tl_buffer = nullptr;
+thread_local std::atomic<uint16_t> tl_zone{0};
+
+void onSample(int, siginfo_t*, void*) {
+    const int saved_errno = errno;
+    ThreadBuffer* buffer = tl_buffer;
+    
+    if (buffer != nullptr && g_active.load(std::memory_order_relaxed)) {
+        uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        if (head - buffer->tail.load(std::memory_order_acquire) >= RING_SIZE) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            Sample& sample = buffer->samples[head % RING_SIZE];
+            sample.zone = tl_zone.load(std::memory_order_relaxed);
+            sample.depth = static_cast<uint16_t>(backtrace(sample.pcs, MAX_DEPTH));
+            buffer->head.store(head + 1, std::memory_order_release);
+        }
+    }
+    
+    errno = saved_errno;
+}
+
+// Caller holds the state mutex
+void drainLocked(ProfilerState& s) {
+    for (auto& buffer : s.buffers) {
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        
+        for (; tail < head; ++tail) {
+            const Sample& sample = buffer->samples[tail % RING_SIZE];
+            if (sample.depth <= SKIP_FRAMES) continue;
+            
+            StackKey key(sample.zone, std::vector<void*>(sample.pcs + SKIP_FRAMES,
+                                                         sample.pcs + sample.depth));
+            s.stacks[key]++;
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void collectorLoop() {
+    ProfilerState& s = state();
+    std::unique_lock<std::mutex> lock(s.mutex);
+    while (!s.collector_stop) {
+        drainLocked(s);
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        lock.lock();
+    }
+}
+
+std::string symbolize(void* pc) {
+    // Return addresses point after the call; look up the call instruction
+    void* lookup = static_cast<char*>(pc) - 1;
+    Dl_info info;
+    if (dladdr(lookup, &info) == 0) {
+        return "[unknown]";
+    }
+    
+    std::string name;
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        name = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+        std::free(demangled);
+    } else {
+        const char* module = info.dli_fname != nullptr ? std::strrchr(info.dli_fname, '/') : nullptr;
+        char offset[32];
+        std::snprintf(offset, sizeof(offset), "+0x%zx",
+                      static_cast<size_t>(static_cast<char*>(lookup) -
+                                          static_cast<char*>(info.dli_fbase)));
+        name = std::string(module != nullptr ? module + 1 : "[unknown]") + offset;
+    }
+    
+    // ';' separates frames in the folded format
+    for (auto& c : name) {
+        if (c == ';') c = ':';
+    }
+    return name;
+}
+
+void armTimer(ThreadBuffer& buffer, int frequency_hz) {
+    sigevent event{};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+    
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &buffer.timer) != 0) {
+        return;
+    }
+    
+    // tv_nsec must stay below one second (1 Hz is exactly one second)
+    const long long interval_ns = 1000000000LL / std::max(1, frequency_hz);
+    itimerspec spec{};
+    spec.it_interval.tv_sec = static_cast<time_t>(interval_ns / 1000000000LL);
+    spec.it_interval.tv_nsec = static_cast<long>(interval_ns % 1000000000LL);
+    spec.it_value = spec.it_interval;
+    if (timer_settime(buffer.timer, 0, &spec, nullptr) != 0) {
+        timer_delete(buffer.timer);
+        return;
+    }
+    buffer.has_timer = true;
+}
+
+void disarmTimer(ThreadBuffer& buffer) {
+    if (buffer.has_timer) {
+        timer_delete(buffer.timer);
+        buffer.has_timer = false;
+    }
+}
+
+} // namespace
+
+bool SamplingProfiler::start(const ProfilerConfig& config) {
+    ProfilerState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (g_active) return false;
+        
+        s.config = config;
+        s.stacks.clear();
+        s.collector_stop = false;
+        
+        // backtrace() loads libgcc on first use, which is not signal-safe
+        void* warmup[4];
+        backtrace(warmup, 4);
+        
+        struct sigaction action{};
+        action.sa_sigaction = onSample;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            return false;
+        }
+        
+        g_active = true;
+        s.collector = std::thread(collectorLoop);
+    }
+    
+    registerThread();
+    return true;
+}
+
+void SamplingProfiler::registerThread() {
+    if (!g_active || tl_buffer != nullptr) return;
+    
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.buffers.push_back(std::make_unique<ThreadBuffer>());
+    tl_buffer = s.buffers.back().get();
+    armTimer(*tl_buffer, s.config.frequency_hz);
+}
+
+void SamplingProfiler::unregisterThread() {
+    if (tl_buffer == nullptr) return;
+    
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    disarmTimer(*tl_buffer);
+    tl_buffer = nullptr;  // Buffer stays for the final drain
+}
+
+void SamplingProfiler::stop() {
+    ProfilerState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!g_active) return;
+        g_active = false;
+        
+        for (auto& buffer : s.buffers) {
+            disarmTimer(*buffer);
+        }
+        s.collector_stop = true;
+    }
+    s.collector.join();
+    tl_buffer = nullptr;
+    
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drainLocked(s);
+    
+    // Fold: zone first, then frames from the outermost caller to the leaf
+    std::unordered_map<void*, std::string> symbols;
+    std::map<std::string, uint64_t> folded;
+    uint64_t samples = 0;
+    uint64_t dropped = 0;
+    
+    for (const auto& [key, count] : s.stacks) {
+        std::string line;
+        if (s.config.zone_frames && key.first != 0) {
+            line = "[" + s.zone_names[key.first] + "]";
+        }
+        for (auto it = key.second.rbegin(); it != key.second.rend(); ++it) {
+            auto symbol = symbols.find(*it);
+            if (symbol == symbols.end()) {
+                symbol = symbols.emplace(*it, symbolize(*it)).first;
+            }
+            if (!line.empty()) line += ';';
+            line += symbol->second;
+        }
+        folded[line] += count;  // Different return addresses in one function merge here
+        samples += count;
+    }
+    for (const auto& buffer : s.buffers) {
+        dropped += buffer->dropped.load();
+    }
+    
+    std::ofstream out(s.config.output_path);
+    for (const auto& [stack, count] : folded) {
+        out << stack << " " << count << "\n";
+    }
+    
+    std::cout << "Profile: " << samples << " samples (" << dropped << " dropped) written to "
+              << s.config.output_path << std::endl;
+    s.stacks.clear();
+}
+
+bool SamplingProfiler::running() {
+    return g_active;
+}
+
+uint16_t SamplingProfiler::zoneId(const char* name) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (size_t i = 1; i < s.zone_names.size(); ++i) {
+        if (s.zone_names[i] == name) return static_cast<uint16_t>(i);
+    }
+    s.zone_names.emplace_back(name);
+    return static_cast<uint16_t>(s.zone_names.size() - 1);
+}
+
+uint16_t SamplingProfiler::currentZone() {
+    return tl_zone.load(std::memory_order_relaxed);
+}
+
+void SamplingProfiler::setCurrentZone(uint16_t zone) {
+    // Relaxed is enough: the handler runs on this same thread
+    tl_zone.store(zone, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+} // namespace bbst::util
@@ -0,0 +1,48 @@
+#include "util/TaggingMatAllocator.hpp"
+
+namespace bbst::util {
+
+TaggingMatAllocator::TaggingMatAllocator(const cv::MatAllocator* delegate)
+    : delegate_(delegate)
+{
+}
+
+cv::UMatData* TaggingMatAllocator::allocate(int dims, const int* sizes, int type, void* data,
+                                            size_t* step, cv::AccessFlag flags,
+                                            cv::UMatUsageFlags usage) const {
+    cv::UMatData* u = delegate_->allocate(dims, sizes, type, data, step, flags, usage);
+    if (u == nullptr) return nullptr;
+    
+    // Route the release back through us; the tag rides in the allocator's
+    // private flags field
+    u->currAllocator = this;
+    u->prevAllocator = this;
+    u->allocatorFlags_ = static_cast<int>(MemoryStats::currentTag());
+    
+    if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+        MemoryStats::recordAllocation(static_cast<MemTag>(u->allocatorFlags_), u->size);
+    }
+    return u;
+}
+
+bool TaggingMatAllocator::allocate(cv::UMatData* data, cv::AccessFlag access,
+                                   cv::UMatUsageFlags usage) const {
+    return delegate_->allocate(data, access, usage);
+}
+
+void TaggingMatAllocator::deallocate(cv::UMatData* data) const {
+    if (data == nullptr) return;
+    
+    if (!(data->flags & cv::UMatData::USER_ALLOCATED)) {
+        MemoryStats::recordFree(static_cast<MemTag>(data->allocatorFlags_), data->size);
+    }
+    delegate_->deallocate(data);
+}
+
+void TaggingMatAllocator::install() {
+    // Never destroyed: Mats in static objects are released after main returns
+    static TaggingMatAllocator* allocator = new TaggingMatAllocator(cv::Mat::getDefaultAllocator());
+    cv::Mat::setDefaultAllocator(allocator);
+}
+
+} // namespace bbst::util
@@ -0,0 +1,138 @@
+#include "util/YuvToTensor.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace bbst::util {
+
+namespace {
+
+// BT.601 limited range, matching OpenCV's YUV420 -> RGB conversion
+constexpr float kLuma = 1.164f;
+constexpr float kRV = 1.596f;
+constexpr float kGU = -0.391f;
+constexpr float kGV = -0.813f;
+constexpr float kBU = 2.018f;
+
+// Bilinear tap: value = src[i0] * (1 - w) + src[i1] * w
+struct Tap {
+    int i0;
+    int i1;
+    float w;
+};
+
+// Pixel-center aligned taps, same mapping as cv::resize(INTER_LINEAR)
+std::vector<Tap> makeTaps(int src_len, int dst_len) {
+    std::vector<Tap> taps(dst_len);
+    const float scale = static_cast<float>(src_len) / dst_len;
+    for (int d = 0; d < dst_len; ++d) {
+        float s = std::max(0.0f, (d + 0.5f) * scale - 0.5f);
+        int i0 = std::min(static_cast<int>(s), src_len - 1);
+        int i1 = std::min(i0 + 1, src_len - 1);
+        taps[d] = {i0, i1, s - i0};
+    }
+    return taps;
+}
+
+// Horizontal resample of one 8-bit row with a stride between samples
+// (stride 2 reads U or V out of an interleaved NV12 row)
+inline void sampleRow(const uchar* row, int stride, const std::vector<Tap>& taps,
+                      float* out) {
+    const int n = static_cast<int>(taps.size());
+    for (int x = 0; x < n; ++x) {
+        const Tap& t = taps[x];
+        float a = row[t.i0 * stride];
+        float b = row[t.i1 * stride];
+        out[x] = a + (b - a) * t.w;
+    }
+}
+
+inline float clamp255(float v) {
+    return std::min(std::max(v, 0.0f), 255.0f);
+}
+
+} // namespace
+
+void YuvToTensor::convert(const io::YuvFrame& src, cv::Size dst_size,
+                          float* dst, float scale) {
+    CV_Assert(!src.empty() && src.data.isContinuous() && src.data.type() == CV_8UC1);
+    CV_Assert(dst_size.width > 0 && dst_size.height > 0 && dst != nullptr);
+
+    const int src_w = src.width();
+    const int src_h = src.height();
+    const int chroma_w = src_w / 2;
+    const int chroma_h = src_h / 2;
+    const int dst_w = dst_size.width;
+    const int dst_h = dst_size.height;
+    const size_t plane = static_cast<size_t>(dst_w) * dst_h;
+
+    const std::vector<Tap> luma_x = makeTaps(src_w, dst_w);
+    const std::vector<Tap> luma_y = makeTaps(src_h, dst_h);
+    const std::vector<Tap> chroma_x = makeTaps(chroma_w, dst_w);
+    const std::vector<Tap> chroma_y = makeTaps(chroma_h, dst_h);
+
+    const uchar* y_plane = src.data.data;
+    const uchar* c_plane = y_plane + static_cast<size_t>(src_w) * src_h;
+    const bool nv12 = src.layout == io::YuvLayout::NV12;
+
+    // Chroma row pointers: NV12 rows are src_w bytes of interleaved UV,
+    // I420 has two planes of chroma_w-byte rows
+    auto uRow = [&](int r) -> const uchar* {
+        return nv12 ? c_plane + static_cast<size_t>(r) * src_w
+                    : c_plane + static_cast<size_t>(r) * chroma_w;
+    };
+    auto vRow = [&](int r) -> const uchar* {
+        return nv12 ? c_plane + static_cast<size_t>(r) * src_w + 1
+                    : c_plane + static_cast<size_t>(chroma_h + r) * chroma_w;
+    };
+    const int c_stride = nv12 ? 2 : 1;
+
+    cv::parallel_for_(cv::Range(0, dst_h), [&](const cv::Range& range) {
+        // Per-worker row buffers; the blend loop below runs over contiguous
+        // floats only, so the compiler can vectorize it
+        std::vector<float> buf(static_cast<size_t>(dst_w) * 6);
+        float* y0 = buf.data();
+        float* y1 = y0 + dst_w;
+        float* u0 = y1 + dst_w;
+        float* u1 = u0 + dst_w;
+        float* v0 = u1 + dst_w;
+        float* v1 = v0 + dst_w;
+
+        for (int dy = range.start; dy < range.end; ++dy) {
+            const Tap& ty = luma_y[dy];
+            const Tap& tc = chroma_y[dy];
+
+            sampleRow(y_plane + static_cast<size_t>(ty.i0) * src_w, 1, luma_x, y0);
+            sampleRow(y_plane + static_cast<size_t>(ty.i1) * src_w, 1, luma_x, y1);
+            sampleRow(uRow(tc.i0), c_stride, chroma_x, u0);
+            sampleRow(uRow(tc.i1), c_stride, chroma_x, u1);
+            sampleRow(vRow(tc.i0), c_stride, chroma_x, v0);
+            sampleRow(vRow(tc.i1), c_stride, chroma_x, v1);
+
+            float* r_out = dst + static_cast<size_t>(dy) * dst_w;
+            float* g_out = r_out + plane;
+            float* b_out = g_out + plane;
+            const float wy = ty.w;
+            const float wc = tc.w;
+
+            for (int x = 0; x < dst_w; ++x) {
+                float yv = y0[x] + (y1[x] - y0[x]) * wy;
+                float uv = u0[x] + (u1[x] - u0[x]) * wc - 128.0f;
+                float vv = v0[x] + (v1[x] - v0[x]) * wc - 128.0f;
+                float c = kLuma * (yv - 16.0f);
+
+                r_out[x] = clamp255(c + kRV * vv) * scale;
+                g_out[x] = clamp255(c + kGU * uv + kGV * vv) * scale;
+                b_out[x] = clamp255(c + kBU * uv) * scale;
+            }
+        }
+    });
+}
+
+cv::Mat YuvToTensor::toBlob(const io::YuvFrame& src, cv::Size dst_size, float scale) {
+    const int shape[] = {1, 3, dst_size.height, dst_size.width};
+    cv::Mat blob(4, shape, CV_32F);
+    convert(src, dst_size, blob.ptr<float>(), scale);
+    return blob;
+}
+
+} // namespace bbst::util
@@ -0,0 +1,72 @@
+#include "pipeline/ArchiveProcessor.hpp"
+#include <iostream>
+#include <cassert>
+
+using namespace bbst::pipeline;
+
+// Test segment padding and clipping
+void test_padding_and_clipping() {
+    std::cout << "Testing segment padding and clipping..." << std::endl;
+    
+    ArchiveConfig config;
+    config.scan_stride = 10;
+    config.padding_frames = 20;
+    config.merge_gap_frames = 0;
+    
+    auto segments = ArchiveProcessor::buildSegments({0, 500, 990}, 1000, config);
+    assert(segments.size() == 3);
+    assert(segments[0].start == 0 && segments[0].end == 30);
+    assert(segments[1].start == 480 && segments[1].end == 530);
+    assert(segments[2].start == 970 && segments[2].end == 1000);
+    
+    std::cout << "✓ Padding and clipping passed" << std::endl;
+}
+
+// Test merging of nearby hits
+void test_merging() {
+    std::cout << "Testing segment merging..." << std::endl;
+    
+    ArchiveConfig config;
+    config.scan_stride = 10;
+    config.padding_frames = 5;
+    config.merge_gap_frames = 50;
+    
+    // Unsorted input; 100/110/120 form one run, 160 is within the merge gap,
+    // 400 starts a new segment
+    auto segments = ArchiveProcessor::buildSegments({120, 100, 400, 110, 160}, 1000, config);
+    assert(segments.size() == 2);
+    assert(segments[0].start == 95 && segments[0].end == 175);
+    assert(segments[1].start == 395 && segments[1].end == 415);
+    
+    int covered = 0;
+    for (const auto& seg : segments) covered += seg.length();
+    assert(covered < 1000);
+    
+    std::cout << "✓ Segment merging passed" << std::endl;
+}
+
+// Test no hits
+void test_empty() {
+    std::cout << "Testing empty scan..." << std::endl;
+    
+    assert(ArchiveProcessor::buildSegments({}, 1000, ArchiveConfig()).empty());
+    
+    std::cout << "✓ Empty scan passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Archive Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_padding_and_clipping();
+        test_merging();
+        test_empty();
+        
+        std::cout << std::endl << "=== All Archive Tests Passed! ===" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
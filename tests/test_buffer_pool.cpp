@@ -0,0 +1,175 @@
+#include "util/BufferPool.hpp"
+#include "util/PooledMatAllocator.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace bbst::util;
+
+// Test size classes cover requests with bounded slack
+void test_size_classes() {
+    std::cout << "Testing size classes..." << std::endl;
+    
+    BufferPool pool;
+    const size_t frame_bgr = 1920 * 1080 * 3;
+    const size_t frame_nv12 = 1920 * 1080 * 3 / 2;
+    
+    for (size_t bytes : {frame_bgr, frame_nv12, size_t(640 * 640 * 3 * 4), size_t(300000)}) {
+        size_t cls = pool.sizeClass(bytes);
+        assert(cls >= bytes);
+        assert(cls <= bytes + bytes / 4 + 4096);
+        assert(cls % 4096 == 0);
+    }
+    
+    // Nearby sizes share a class, distant ones don't
+    assert(pool.sizeClass(frame_bgr) == pool.sizeClass(frame_bgr - 100));
+    assert(pool.sizeClass(frame_bgr) != pool.sizeClass(frame_nv12));
+    
+    assert(!pool.pooled(1024));
+    assert(pool.pooled(frame_bgr));
+    
+    BufferPoolConfig huge;
+    huge.huge_pages = true;
+    BufferPool huge_pool(huge);
+    assert(huge_pool.sizeClass(frame_bgr) % (2 * 1024 * 1024) == 0);
+    assert(huge_pool.sizeClass(300000) == pool.sizeClass(300000));  // Small classes stay on 4 KiB pages
+    
+    std::cout << "✓ Size classes passed" << std::endl;
+}
+
+// Test released buffers are handed out again
+void test_recycling() {
+    std::cout << "Testing recycling..." << std::endl;
+    
+    BufferPool pool;
+    const size_t bytes = 1920 * 1080 * 3;
+    
+    void* first = pool.acquire(bytes);
+    assert(first != nullptr);
+    assert(reinterpret_cast<uintptr_t>(first) % 4096 == 0);
+    std::memset(first, 0xAB, bytes);
+    pool.release(first, bytes);
+    
+    void* second = pool.acquire(bytes - 64);  // Same class
+    assert(second == first);
+    pool.release(second, bytes - 64);
+    
+    BufferPoolStats stats = pool.stats();
+    assert(stats.hits == 1);
+    assert(stats.misses == 1);
+    assert(stats.cached_bytes == pool.sizeClass(bytes));
+    
+    pool.trim();
+    stats = pool.stats();
+    assert(stats.cached_bytes == 0);
+    assert(stats.mapped_bytes == 0);
+    
+    std::cout << "✓ Recycling passed" << std::endl;
+}
+
+// Test idle memory stays under the cap
+void test_cache_limit() {
+    std::cout << "Testing cache limit..." << std::endl;
+    
+    BufferPoolConfig config;
+    config.max_cached_bytes = 4 * 1024 * 1024;
+    BufferPool pool(config);
+    const size_t bytes = 1024 * 1024;
+    
+    std::vector<void*> buffers;
+    for (int i = 0; i < 8; ++i) {
+        buffers.push_back(pool.acquire(bytes));
+    }
+    for (void* buffer : buffers) {
+        pool.release(buffer, bytes);
+    }
+    
+    BufferPoolStats stats = pool.stats();
+    assert(stats.cached_bytes <= config.max_cached_bytes);
+    assert(stats.mapped_bytes == stats.cached_bytes);
+    
+    std::cout << "✓ Cache limit passed" << std::endl;
+}
+
+// Test concurrent acquire/release
+void test_concurrent() {
+    std::cout << "Testing concurrent use..." << std::endl;
+    
+    BufferPool pool;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            const size_t bytes = 512 * 1024 * static_cast<size_t>(t + 1);
+            for (int i = 0; i < 200; ++i) {
+                auto* buffer = static_cast<unsigned char*>(pool.acquire(bytes));
+                buffer[0] = static_cast<unsigned char>(i);
+                buffer[bytes - 1] = static_cast<unsigned char>(i);
+                pool.release(buffer, bytes);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    BufferPoolStats stats = pool.stats();
+    assert(stats.hits + stats.misses == 800);
+    assert(stats.misses <= 8);
+    
+    std::cout << "✓ Concurrent use passed" << std::endl;
+}
+
+// Test Mats allocated through the pool behave like ordinary Mats
+void test_mat_allocator() {
+    std::cout << "Testing pooled Mat allocator..." << std::endl;
+    
+    PooledMatAllocator allocator;
+    void* first_data = nullptr;
+    {
+        cv::Mat frame;
+        frame.allocator = &allocator;
+        frame.create(1080, 1920, CV_8UC3);
+        frame.setTo(cv::Scalar(1, 2, 3));
+        first_data = frame.data;
+        
+        cv::Mat copy = frame.clone();
+        assert(cv::norm(frame, copy, cv::NORM_INF) == 0.0);
+    }
+    
+    // The next frame of the same size reuses the buffer
+    cv::Mat frame;
+    frame.allocator = &allocator;
+    frame.create(1080, 1920, CV_8UC3);
+    assert(frame.data == first_data);
+    assert(allocator.stats().hits >= 1);
+    
+    // Small Mats bypass the pool
+    cv::Mat small;
+    small.allocator = &allocator;
+    small.create(8, 8, CV_32F);
+    small.setTo(0);
+    assert(allocator.stats().misses == 1);
+    
+    std::cout << "✓ Pooled Mat allocator passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Buffer Pool Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_size_classes();
+        test_recycling();
+        test_cache_limit();
+        test_concurrent();
+        test_mat_allocator();
+        
+        std::cout << std::endl << "=== All Buffer Pool Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,158 @@
+#include "analysis/CourtZones.hpp"
+#include "analysis/ShotEvents.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace bbst::analysis;
+
+// Test the exact template at known spots on both halves
+void test_template() {
+    std::cout << "Testing court template..." << std::endl;
+    
+    CourtTemplate court;
+    assert(court.classify(cv::Point2f(-0.5f, 7.5f)) == CourtZone::OutOfBounds);
+    assert(court.classify(cv::Point2f(10.0f, 15.5f)) == CourtZone::OutOfBounds);
+    assert(court.classify(cv::Point2f(2.0f, 7.5f)) == CourtZone::RestrictedArea);
+    assert(court.classify(cv::Point2f(4.0f, 7.5f)) == CourtZone::Paint);
+    assert(court.classify(cv::Point2f(6.5f, 7.5f)) == CourtZone::MidRange);
+    assert(court.classify(cv::Point2f(9.0f, 7.5f)) == CourtZone::AboveBreakThree);
+    assert(court.classify(cv::Point2f(1.0f, 0.4f)) == CourtZone::LeftCornerThree);
+    assert(court.classify(cv::Point2f(1.0f, 14.6f)) == CourtZone::RightCornerThree);
+    assert(court.classify(cv::Point2f(1.0f, 2.0f)) == CourtZone::MidRange);
+    
+    // The far half is the near half rotated; the shooter's left flips with it
+    assert(court.classify(cv::Point2f(26.0f, 7.5f)) == CourtZone::RestrictedArea);
+    assert(court.classify(cv::Point2f(27.0f, 14.6f)) == CourtZone::LeftCornerThree);
+    assert(court.classify(cv::Point2f(27.0f, 0.4f)) == CourtZone::RightCornerThree);
+    
+    assert(std::string(courtZoneName(CourtZone::Paint)) == "Paint");
+    std::cout << "✓ Court template passed" << std::endl;
+}
+
+// Test the court raster agrees with the exact template away from lines
+void test_court_map() {
+    std::cout << "Testing court zone map..." << std::endl;
+    
+    CourtTemplate court;
+    CourtZoneMap map = CourtZoneMap::court(court, 0.05);
+    assert(map.raster().cols == 560 && map.raster().rows == 300);
+    
+    int checked = 0;
+    int mismatched = 0;
+    for (float x = -1.0f; x <= 29.0f; x += 0.13f) {
+        for (float y = -1.0f; y <= 16.0f; y += 0.11f) {
+            cv::Point2f point(x, y);
+            CourtZone exact = court.classify(point);
+            CourtZone fast = map.at(point);
+            checked++;
+            if (fast == exact) continue;
+            
+            // Only cells straddling a line may disagree
+            mismatched++;
+            bool near_line = false;
+            for (float ox : {-0.05f, 0.05f}) {
+                for (float oy : {-0.05f, 0.05f}) {
+                    near_line |= court.classify(point + cv::Point2f(ox, oy)) == fast;
+                }
+            }
+            assert(near_line);
+        }
+    }
+    assert(mismatched < checked / 50);
+    
+    // Batch classification matches single lookups
+    std::vector<cv::Point2f> points = {{2.0f, 7.5f}, {4.0f, 7.5f}, {9.0f, 7.5f}, {30.0f, 1.0f}};
+    std::vector<CourtZone> zones;
+    map.classify(points, zones);
+    assert(zones.size() == points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        assert(zones[i] == map.at(points[i]));
+    }
+    assert(zones[3] == CourtZone::OutOfBounds);
+    
+    std::cout << "✓ Court zone map passed" << std::endl;
+}
+
+// Test an image map built from a camera homography
+void test_image_map() {
+    std::cout << "Testing image zone map..." << std::endl;
+    
+    // Mild perspective view of the whole court in a 1280x720 frame
+    std::vector<cv::Point2f> court_corners = {{0, 0}, {28, 0}, {28, 15}, {0, 15}};
+    std::vector<cv::Point2f> image_corners = {{200, 250}, {1080, 250}, {1240, 700}, {40, 700}};
+    cv::Mat h = cv::getPerspectiveTransform(image_corners, court_corners);
+    cv::Matx33d image_to_court(h.ptr<double>());
+    
+    CourtTemplate court;
+    CourtZoneMap map = CourtZoneMap::image(image_to_court, cv::Size(1280, 720), court);
+    assert(map.raster().size() == cv::Size(1280, 720));
+    
+    // Above the far sideline is off the court
+    assert(map.at(cv::Point2f(640, 100)) == CourtZone::OutOfBounds);
+    assert(map.at(cv::Point2f(-5, 400)) == CourtZone::OutOfBounds);
+    
+    // Pixels well inside zones agree with the template through the homography
+    cv::Matx33d court_to_image = image_to_court.inv();
+    for (cv::Point2f spot : {cv::Point2f(2.0f, 7.5f), cv::Point2f(4.2f, 7.5f), cv::Point2f(6.5f, 7.5f),
+                             cv::Point2f(10.0f, 7.5f), cv::Point2f(26.0f, 7.5f)}) {
+        cv::Vec3d p = court_to_image * cv::Vec3d(spot.x, spot.y, 1.0);
+        cv::Point2f pixel(static_cast<float>(p[0] / p[2]), static_cast<float>(p[1] / p[2]));
+        assert(map.at(pixel) == court.classify(spot));
+        
+        cv::Point2f back = map.toCourt(pixel);
+        assert(std::abs(back.x - spot.x) < 1e-3f && std::abs(back.y - spot.y) < 1e-3f);
+    }
+    
+    std::cout << "✓ Image zone map passed" << std::endl;
+}
+
+// Test shots pick up their floor zone and land in the chart
+void test_shot_chart() {
+    std::cout << "Testing shot chart..." << std::endl;
+    
+    CourtZoneMap map = CourtZoneMap::court();
+    std::vector<ShotEvent> events(3);
+    events[0].floor_point = cv::Point2f(4.0f, 7.5f);
+    events[1].floor_point = cv::Point2f(9.0f, 7.5f);
+    events[2].floor_point = cv::Point2f(9.0f, 6.5f);
+    classifyShots(events, map);
+    assert(events[0].zone == CourtZone::Paint);
+    assert(events[1].zone == CourtZone::AboveBreakThree);
+    assert(events[2].zone == CourtZone::AboveBreakThree);
+    
+    ShotChart chart;
+    for (const auto& event : events) {
+        chart.add(event.zone, map.toCourt(event.floor_point));
+    }
+    chart.add(CourtZone::OutOfBounds, cv::Point2f(-1.0f, -1.0f));
+    assert(chart.attempts[static_cast<size_t>(CourtZone::AboveBreakThree)] == 2);
+    assert(chart.court_points.size() == 3);
+    assert(chart.summary() == "OutOfBounds 1, Paint 1, AboveBreakThree 2");
+    assert(ShotChart().summary() == "no shots");
+    
+    cv::Mat image = chart.render(CourtTemplate(), 20);
+    assert(image.size() == cv::Size(560, 300));
+    assert(image.type() == CV_8UC3);
+    assert(image.at<cv::Vec3b>(150, 180) == cv::Vec3b(255, 255, 255));  // Shot at (9, 7.5)
+    
+    std::cout << "✓ Shot chart passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Court Zone Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_template();
+        test_court_map();
+        test_image_map();
+        test_shot_chart();
+        
+        std::cout << std::endl << "=== All Court Zone Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
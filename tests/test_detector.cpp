@@ -168,6 +168,30 @@ void test_batch_processing() {
     }
 }
 
+// Test several regions in one forward pass
+void test_region_batch() {
+    std::cout << "Testing region batch..." << std::endl;
+    
+    try {
+        YoloDetector detector("models/yolov5s.onnx");
+        cv::Mat frame(720, 1280, CV_8UC3, cv::Scalar(50, 50, 50));
+        
+        std::vector<cv::Rect> regions = {cv::Rect(0, 0, 1280, 720), cv::Rect(600, 40, 640, 640),
+                                         cv::Rect(2000, 0, 10, 10)};
+        auto batch = detector.detectBatch(frame, regions, ClassMask::all());
+        assert(batch.size() == regions.size());
+        assert(batch[2].empty());  // Outside the frame
+        for (const auto& det : batch[1]) {
+            assert((regions[1] & det.box).area() > 0);  // Boxes come back in frame coordinates
+        }
+        
+        std::cout << "✓ Region batch passed" << std::endl;
+        
+    } catch (const std::exception& e) {
+        std::cout << "⚠ Skipping test (model not available): " << e.what() << std::endl;
+    }
+}
+
 // Test configuration
 void test_yolo_config() {
     std::cout << "Testing YOLO configuration..." << std::endl;
@@ -191,6 +215,112 @@ void test_yolo_config() {
     }
 }
 
+// Test class geometric priors
+void test_class_priors() {
+    std::cout << "Testing class priors..." << std::endl;
+    
+    ClassPrior prior;
+    prior.min_size = 5.0f;
+    prior.max_size = 120.0f;
+    prior.min_aspect_ratio = 0.3f;
+    prior.max_aspect_ratio = 3.0f;
+    
+    assert(prior.accepts(20.0f, 22.0f));
+    assert(!prior.accepts(2.0f, 3.0f));      // Too small
+    assert(!prior.accepts(200.0f, 180.0f));  // Too large
+    assert(!prior.accepts(60.0f, 10.0f));    // Too wide
+    assert(!prior.accepts(10.0f, 0.0f));     // Degenerate
+    
+    // Unconstrained default
+    assert(ClassPrior().accepts(1000.0f, 1.0f));
+    
+    YoloConfig config;
+    config.class_priors[0] = prior;
+    assert(config.class_priors.count(0) == 1);
+    assert(config.class_priors.count(1) == 0);
+    
+    std::cout << "✓ Class priors passed" << std::endl;
+}
+
+// Test static and runtime class masks agree
+void test_class_masks() {
+    std::cout << "Testing class masks..." << std::endl;
+    
+    static_assert(BallClasses::contains(0) && BallClasses::contains(2), "ball classes");
+    static_assert(!BallClasses::contains(RIM_CLASS) && RimClasses::contains(RIM_CLASS), "rim class");
+    
+    ClassMask burst = BallClasses::toRuntime().with(RIM_CLASS);
+    assert(burst.ids().size() == 3);
+    assert(burst.contains(0) && burst.contains(RIM_CLASS) && burst.contains(2));
+    assert(burst.with(RIM_CLASS).ids().size() == 3);  // No duplicates
+    assert(ClassMask::all().with(5).isAll());
+    
+    std::cout << "✓ Class masks passed" << std::endl;
+}
+
+static bool sameDetections(const std::vector<Detection<>>& a, const std::vector<Detection<>>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].class_id != b[i].class_id || a[i].confidence != b[i].confidence ||
+            a[i].box != b[i].box) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Test masked decoding of a synthetic [4 + classes, anchors] output plane
+void test_masked_decode() {
+    std::cout << "Testing masked decoding..." << std::endl;
+    
+    YoloConfig config;
+    config.verbose = false;
+    const cv::Size size(640, 640);
+    
+    // cx, cy, w, h, then scores for ball, rim, sports ball
+    const float anchors[][7] = {
+        {100, 100, 20, 20, 0.9f, 0.1f, 0.0f},   // Ball
+        {300, 100, 30, 30, 0.5f, 0.8f, 0.1f},   // Rim; its ball score passes on its own
+        {500, 300, 20, 20, 0.2f, 0.1f, 0.7f},   // Sports ball
+        {104, 102, 20, 20, 0.6f, 0.0f, 0.0f},   // Duplicate of the first ball
+        {300, 100, 24, 24, 0.0f, 0.0f, 0.7f},   // Ball in front of the rim
+        {400, 400, 20, 20, 0.1f, 0.3f, 0.3f},   // Tie, the lower id (rim) wins
+    };
+    const int count = static_cast<int>(sizeof(anchors) / sizeof(anchors[0]));
+    cv::Mat plane(7, count, CV_32F, cv::Scalar(0));
+    for (int i = 0; i < count; ++i) {
+        for (int row = 0; row < 7; ++row) plane.at<float>(row, i) = anchors[i][row];
+    }
+    
+    YoloDecoder decoder;
+    decoder.scoreClasses(plane, ClassMask::all());
+    auto all = decoder.decodeScored(plane, config, size);
+    assert(all.size() == 5);  // Duplicate suppressed, the rim does not suppress the ball
+    
+    std::vector<Detection<>> expected;
+    for (const auto& det : all) {
+        if (BallClasses::contains(det.class_id)) expected.push_back(det);
+    }
+    assert(expected.size() == 3);
+    
+    // Rim anchors are skipped, not relabelled as balls
+    decoder.scoreClasses(plane, BallClasses::toRuntime());
+    auto masked = decoder.decodeScored(plane, config, size);
+    assert(sameDetections(masked, expected));
+    
+    // Mask order and the compile-time mask don't change the result
+    decoder.scoreClasses(plane, ClassMask{2, 0});
+    assert(sameDetections(decoder.decodeScored(plane, config, size), expected));
+    decoder.scoreClasses(plane, BallClasses());
+    assert(sameDetections(decoder.decodeScored(plane, config, size), expected));
+    
+    decoder.scoreClasses(plane, RimClasses());
+    auto rims = decoder.decodeScored(plane, config, size);
+    assert(rims.size() == 2 && rims[0].class_id == RIM_CLASS && rims[1].class_id == RIM_CLASS);
+    
+    std::cout << "✓ Masked decoding passed" << std::endl;
+}
+
 // Test error handling
 void test_error_handling() {
     std::cout << "Testing error handling..." << std::endl;
@@ -223,9 +353,13 @@ int main() {
         test_detection_structure();
         test_nms();
         test_yolo_config();
+        test_class_priors();
+        test_class_masks();
+        test_masked_decode();
         test_error_handling();
         test_detection_on_image();
         test_batch_processing();
+        test_region_batch();
         
         std::cout << std::endl << "=== All Detector Tests Passed! ===" << std::endl;
         std::cout << "(Some tests may be skipped if model files are not available)" << std::endl;
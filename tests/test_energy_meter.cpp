@@ -0,0 +1,135 @@
+#include "util/EnergyMeter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace bbst::util;
+namespace fs = std::filesystem;
+
+static const fs::path ROOT = fs::temp_directory_path() / "bbst_test_powercap";
+
+static void writeFile(const fs::path& path, const std::string& content) {
+    std::ofstream out(path);
+    out << content << "\n";
+}
+
+// Fake powercap zone as the kernel lays it out
+static void makeZone(const std::string& zone, const std::string& name,
+                     uint64_t energy_uj, uint64_t max_range_uj) {
+    fs::create_directories(ROOT / zone);
+    writeFile(ROOT / zone / "name", name);
+    writeFile(ROOT / zone / "energy_uj", std::to_string(energy_uj));
+    writeFile(ROOT / zone / "max_energy_range_uj", std::to_string(max_range_uj));
+}
+
+static void setEnergy(const std::string& zone, uint64_t energy_uj) {
+    writeFile(ROOT / zone / "energy_uj", std::to_string(energy_uj));
+}
+
+static void makeTree() {
+    fs::remove_all(ROOT);
+    makeZone("intel-rapl:0", "package-0", 1000000, 262143328850);
+    makeZone("intel-rapl:0:0", "core", 500000, 262143328850);        // Part of the package
+    makeZone("intel-rapl:0:1", "dram", 200000, 65712999613);
+    makeZone("intel-rapl-mmio:0", "package-0", 1000000, 262143328850); // Duplicate
+}
+
+// Test zone discovery skips subzones and duplicates
+void test_discovery() {
+    std::cout << "Testing zone discovery..." << std::endl;
+    
+    makeTree();
+    EnergyMeter meter(ROOT.string());
+    assert(meter.available());
+    assert(meter.domainCount() == 2);
+    
+    std::cout << "✓ Zone discovery passed" << std::endl;
+}
+
+// Test joules are attributed to package and DRAM
+void test_energy_deltas() {
+    std::cout << "Testing energy deltas..." << std::endl;
+    
+    makeTree();
+    EnergyMeter meter(ROOT.string());
+    meter.start();
+    
+    setEnergy("intel-rapl:0", 1000000 + 5000000);     // +5 J
+    setEnergy("intel-rapl:0:1", 200000 + 1500000);    // +1.5 J
+    setEnergy("intel-rapl:0:0", 500000 + 9000000);    // Ignored
+    
+    EnergySample sample = meter.read();
+    assert(sample.valid);
+    assert(std::abs(sample.package_joules - 5.0) < 1e-9);
+    assert(std::abs(sample.dram_joules - 1.5) < 1e-9);
+    assert(std::abs(sample.totalJoules() - 6.5) < 1e-9);
+    
+    // Restarting zeroes the totals
+    meter.start();
+    sample = meter.read();
+    assert(sample.totalJoules() == 0.0);
+    
+    std::string text = formatEnergy(meter.read(), 10);
+    assert(text.find("J/frame") != std::string::npos);
+    
+    std::cout << "✓ Energy deltas passed" << std::endl;
+}
+
+// Test counter wraparound between updates
+void test_wraparound() {
+    std::cout << "Testing wraparound..." << std::endl;
+    
+    fs::remove_all(ROOT);
+    makeZone("intel-rapl:0", "package-0", 9000000, 9999999);
+    EnergyMeter meter(ROOT.string());
+    meter.start();
+    
+    setEnergy("intel-rapl:0", 9500000);     // +0.5 J
+    meter.update();
+    setEnergy("intel-rapl:0", 500000);      // Wrapped: +1 J more
+    EnergySample sample = meter.read();
+    assert(std::abs(sample.package_joules - 1.5) < 1e-9);
+    
+    std::cout << "✓ Wraparound passed" << std::endl;
+}
+
+// Test missing or unreadable RAPL degrades to an invalid sample
+void test_unavailable() {
+    std::cout << "Testing unavailable RAPL..." << std::endl;
+    
+    EnergyMeter missing((ROOT / "does-not-exist").string());
+    assert(!missing.available());
+    EnergySample sample = missing.read();
+    assert(!sample.valid);
+    assert(formatEnergy(sample, 100).find("unavailable") != std::string::npos);
+    
+    // A zone without a counter file is skipped
+    fs::remove_all(ROOT);
+    makeZone("intel-rapl:0", "package-0", 0, 100);
+    fs::remove(ROOT / "intel-rapl:0" / "energy_uj");
+    EnergyMeter unreadable(ROOT.string());
+    assert(!unreadable.available());
+    
+    fs::remove_all(ROOT);
+    std::cout << "✓ Unavailable RAPL passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Energy Meter Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_discovery();
+        test_energy_deltas();
+        test_wraparound();
+        test_unavailable();
+        
+        std::cout << std::endl << "=== All Energy Meter Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,97 @@
+#include "core/FrameContext.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+using namespace bbst;
+
+// Build a frame with some structure so hashes are meaningful
+static cv::Mat makeFrame(int offset) {
+    cv::Mat frame(480, 640, CV_8UC3, cv::Scalar(40, 40, 40));
+    cv::circle(frame, cv::Point(200 + offset, 240), 60, cv::Scalar(0, 165, 255), -1);
+    cv::rectangle(frame, cv::Rect(400, 100, 120, 80), cv::Scalar(255, 255, 255), -1);
+    return frame;
+}
+
+// Test derived image sizes and types
+void test_derived_sizes() {
+    std::cout << "Testing derived image sizes..." << std::endl;
+    
+    cv::Mat frame = makeFrame(0);
+    FrameContext ctx(frame, 7, 233.3);
+    
+    assert(ctx.index() == 7);
+    assert(ctx.gray().type() == CV_8UC1);
+    assert(ctx.gray().size() == frame.size());
+    assert(ctx.half().size() == cv::Size(320, 240));
+    assert(ctx.quarter().size() == cv::Size(160, 120));
+    
+    const auto& pyr = ctx.pyramid();
+    assert(pyr.size() == 4);
+    assert(pyr[0].data == ctx.gray().data);
+    assert(pyr[1].size() == cv::Size(320, 240));
+    
+    std::cout << "✓ Derived sizes passed" << std::endl;
+}
+
+// Test that products are computed once and shared
+void test_memoization() {
+    std::cout << "Testing memoization..." << std::endl;
+    
+    FrameContext ctx(makeFrame(0));
+    
+    const uchar* first = ctx.gray().data;
+    assert(ctx.gray().data == first);
+    assert(ctx.half().data == ctx.half().data);
+    
+    // Concurrent consumers must all see the same buffer
+    std::vector<const uchar*> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    FrameContext shared(makeFrame(10));
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&shared, &seen, i]() {
+            seen[i] = shared.quarter().data;
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    for (const uchar* p : seen) {
+        assert(p == seen[0]);
+    }
+    
+    std::cout << "✓ Memoization passed" << std::endl;
+}
+
+// Test difference hash
+void test_dhash() {
+    std::cout << "Testing dHash..." << std::endl;
+    
+    FrameContext a(makeFrame(0));
+    FrameContext b(makeFrame(0));
+    FrameContext c(makeFrame(200));
+    
+    assert(a.dHash() == b.dHash());
+    assert(FrameContext::hammingDistance(a.dHash(), b.dHash()) == 0);
+    assert(FrameContext::hammingDistance(a.dHash(), c.dHash()) > 0);
+    
+    std::cout << "✓ dHash passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running FrameContext Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_derived_sizes();
+        test_memoization();
+        test_dhash();
+        
+        std::cout << std::endl << "=== All FrameContext Tests Passed! ===" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
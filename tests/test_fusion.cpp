@@ -0,0 +1,241 @@
+#include "tracking/MultiCameraFusion.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace bbst::tracking;
+
+// Camera at eye looking at target, z up, 1280x720 with f=1000px
+static cv::Matx34d lookAt(const cv::Vec3d& eye, const cv::Vec3d& target) {
+    auto normalize = [](const cv::Vec3d& v) {
+        double n = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        return cv::Vec3d(v[0] / n, v[1] / n, v[2] / n);
+    };
+    auto cross = [](const cv::Vec3d& a, const cv::Vec3d& b) {
+        return cv::Vec3d(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+    };
+    cv::Vec3d forward = normalize(cv::Vec3d(target[0] - eye[0], target[1] - eye[1], target[2] - eye[2]));
+    cv::Vec3d right = normalize(cross(forward, cv::Vec3d(0.0, 0.0, 1.0)));
+    cv::Vec3d down = cross(forward, right);
+    
+    cv::Matx34d rt;
+    const cv::Vec3d axes[3] = {right, down, forward};
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) rt(r, c) = axes[r][c];
+        rt(r, 3) = -(axes[r][0] * eye[0] + axes[r][1] * eye[1] + axes[r][2] * eye[2]);
+    }
+    cv::Matx33d k(1000.0, 0.0, 640.0,
+                  0.0, 1000.0, 360.0,
+                  0.0, 0.0, 1.0);
+    return k * rt;
+}
+
+static std::vector<cv::Matx34d> courtCameras() {
+    const cv::Vec3d target(0.0, 0.0, 2.0);
+    return {lookAt(cv::Vec3d(-16.0, -10.0, 6.0), target),
+            lookAt(cv::Vec3d(16.0, -10.0, 6.0), target),
+            lookAt(cv::Vec3d(16.0, 10.0, 6.0), target),
+            lookAt(cv::Vec3d(-16.0, 10.0, 5.0), target)};
+}
+
+static cv::Point2f project(const cv::Matx34d& p, const cv::Point3d& x) {
+    double u = p(0, 0) * x.x + p(0, 1) * x.y + p(0, 2) * x.z + p(0, 3);
+    double v = p(1, 0) * x.x + p(1, 1) * x.y + p(1, 2) * x.z + p(1, 3);
+    double w = p(2, 0) * x.x + p(2, 1) * x.y + p(2, 2) * x.z + p(2, 3);
+    return cv::Point2f(static_cast<float>(u / w), static_cast<float>(v / w));
+}
+
+static double distance(const cv::Point3d& a, const cv::Point3d& b) {
+    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+}
+
+// Ball wandering over the court (seconds to meters)
+static cv::Point3d wander(double t) {
+    return cv::Point3d(5.0 * std::sin(1.3 * t), 3.0 * std::sin(2.1 * t + 0.5),
+                       2.5 + 1.5 * std::sin(3.1 * t));
+}
+
+// Test DLT triangulation, noise and outlier rejection
+void test_triangulation() {
+    std::cout << "Testing triangulation..." << std::endl;
+    
+    auto cameras = courtCameras();
+    const cv::Point3d ball(3.0, -2.0, 3.5);
+    std::vector<cv::Point2f> points;
+    for (const auto& p : cameras) points.push_back(project(p, ball));
+    
+    Triangulation exact = triangulate(cameras.data(), points.data(), 4);
+    assert(exact.valid && exact.views == 4);
+    assert(distance(exact.point, ball) < 1e-3);
+    assert(exact.reprojection_px < 0.01);
+    
+    // Two views are enough
+    Triangulation pair = triangulate(cameras.data(), points.data(), 2);
+    assert(pair.valid && distance(pair.point, ball) < 1e-3);
+    
+    // Half-pixel noise stays within a few centimeters
+    std::vector<cv::Point2f> noisy = points;
+    const float jitter[4][2] = {{0.5f, -0.4f}, {-0.3f, 0.5f}, {0.4f, 0.3f}, {-0.5f, -0.2f}};
+    for (int i = 0; i < 4; ++i) noisy[i] += cv::Point2f(jitter[i][0], jitter[i][1]);
+    Triangulation rough = triangulate(cameras.data(), noisy.data(), 4);
+    assert(rough.valid && distance(rough.point, ball) < 0.05);
+    
+    // A false detection in one camera is dropped
+    noisy[2] += cv::Point2f(60.0f, -40.0f);
+    Triangulation robust = triangulate(cameras.data(), noisy.data(), 4, 3.0);
+    assert(robust.valid && robust.views == 3);
+    assert(!(robust.view_mask & (1u << 2)));
+    assert(distance(robust.point, ball) < 0.05);
+    
+    std::cout << "✓ Triangulation passed" << std::endl;
+}
+
+// Test the epipolar geometry between views
+void test_epipolar() {
+    std::cout << "Testing epipolar distance..." << std::endl;
+    
+    auto cameras = courtCameras();
+    cv::Matx33d f = fundamentalFromProjections(cameras[0], cameras[1]);
+    for (double t = 0.0; t < 3.0; t += 0.37) {
+        cv::Point3d ball = wander(t);
+        assert(epipolarDistance(f, project(cameras[0], ball), project(cameras[1], ball)) < 0.01);
+    }
+    cv::Point3d ball = wander(1.0);
+    double off = epipolarDistance(f, project(cameras[0], ball),
+                                  project(cameras[1], wander(1.1)));
+    assert(off > 1.0);
+    
+    std::cout << "✓ Epipolar distance passed" << std::endl;
+}
+
+// Test the ballistic filter follows a free flight
+void test_ballistic_filter() {
+    std::cout << "Testing ballistic Kalman filter..." << std::endl;
+    
+    const cv::Vec3d g(0.0, 0.0, -9.81);
+    const cv::Point3d p0(-5.0, -2.0, 2.0);
+    const cv::Vec3d v0(6.0, 2.0, 7.0);
+    auto flight = [&](double t) {
+        return cv::Point3d(p0.x + v0[0] * t, p0.y + v0[1] * t, p0.z + v0[2] * t + 0.5 * g[2] * t * t);
+    };
+    
+    BallKalman3D filter(g, 1.0, 0.02);
+    filter.init(flight(0.0), 20.0);
+    const double dt = 1.0 / 60.0;
+    for (int i = 1; i <= 30; ++i) {
+        filter.predict(dt);
+        assert(filter.mahalanobis(flight(i * dt)) < 11.34);
+        filter.update(flight(i * dt));
+    }
+    cv::Vec3d v = filter.velocity();
+    assert(std::abs(v[0] - v0[0]) < 0.2);
+    assert(std::abs(v[2] - (v0[2] + g[2] * 0.5)) < 0.2);
+    
+    // Coasting 0.2s without measurements stays on the parabola
+    for (int i = 31; i <= 42; ++i) filter.predict(dt);
+    assert(distance(filter.position(), flight(42 * dt)) < 0.05);
+    
+    std::cout << "✓ Ballistic Kalman filter passed" << std::endl;
+}
+
+// Feed every camera one second of 60fps observations on its own clock
+static void feed(MultiCameraFusion& fusion, const std::vector<cv::Matx34d>& cameras,
+                 const std::vector<double>& offsets_ms, int first_frame, int last_frame) {
+    const double period = 1000.0 / 60.0;
+    for (int k = first_frame; k < last_frame; ++k) {
+        for (size_t c = 0; c < cameras.size(); ++c) {
+            double camera_ms = k * period + 3.0 * c;     // Unsynchronized exposures
+            double true_ms = camera_ms - offsets_ms[c];
+            fusion.addObservation(static_cast<int>(c), camera_ms,
+                                  project(cameras[c], wander(true_ms / 1000.0)));
+        }
+    }
+}
+
+// Test clock offsets are recovered from the tracks alone
+void test_clock_offsets() {
+    std::cout << "Testing clock offset estimation..." << std::endl;
+    
+    auto cameras = courtCameras();
+    const std::vector<double> offsets = {0.0, 33.0, -21.0, 12.5};
+    FusionConfig config;
+    config.offset_interval = 0;
+    MultiCameraFusion fusion(cameras, config);
+    feed(fusion, cameras, offsets, 0, 120);
+    
+    for (int c = 1; c < 4; ++c) {
+        double estimate = 0.0;
+        assert(fusion.estimateClockOffset(c, estimate));
+        assert(std::abs(estimate - offsets[c]) < 1.5);
+    }
+    
+    // Too little history: no estimate
+    MultiCameraFusion fresh(cameras, config);
+    feed(fresh, cameras, offsets, 0, 5);
+    double estimate = 0.0;
+    assert(!fresh.estimateClockOffset(1, estimate));
+    
+    std::cout << "✓ Clock offset estimation passed" << std::endl;
+}
+
+// Test end-to-end fusion with unknown offsets and a dropout
+void test_fusion() {
+    std::cout << "Testing multi-camera fusion..." << std::endl;
+    
+    auto cameras = courtCameras();
+    const std::vector<double> offsets = {0.0, 33.0, -21.0, 12.5};
+    FusionConfig config;
+    config.gravity = cv::Vec3d(0.0, 0.0, 0.0);   // The test ball is not ballistic
+    config.process_noise = 15.0;
+    config.offset_interval = 10;
+    MultiCameraFusion fusion(cameras, config);
+    
+    const double period = 1000.0 / 60.0;
+    double worst = 0.0;
+    int measured = 0;
+    for (int k = 0; k < 360; ++k) {
+        feed(fusion, cameras, offsets, k, k + 1);
+        const double t = k * period;
+        FusedBall ball = fusion.fuse(t);
+        if (k >= 120) {
+            assert(ball.valid);
+            worst = std::max(worst, distance(ball.position, wander(t / 1000.0)));
+            if (ball.measured) measured++;
+        }
+    }
+    assert(worst < 0.1);
+    assert(measured > 230);
+    for (int c = 1; c < 4; ++c) {
+        assert(std::abs(fusion.clockOffsetMs(c) - offsets[c]) < 2.0);
+    }
+    
+    // Wrong camera count is rejected
+    bool threw = false;
+    try {
+        MultiCameraFusion single({cameras[0]});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "✓ Multi-camera fusion passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Fusion Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_triangulation();
+        test_epipolar();
+        test_ballistic_filter();
+        test_clock_offsets();
+        test_fusion();
+        
+        std::cout << std::endl << "=== All Fusion Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,222 @@
+#include "analysis/DetectorComparison.hpp"
+#include "detectors/HeatmapDetector.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace bbst;
+
+// [1, C, H, W] blob of zeros
+static cv::Mat makeBlob(int channels, int rows, int cols) {
+    const int shape[] = {1, channels, rows, cols};
+    return cv::Mat(4, shape, CV_32F, cv::Scalar(0));
+}
+
+static float* planeData(cv::Mat& blob, int channel) {
+    return blob.ptr<float>() + static_cast<size_t>(channel) * blob.size[2] * blob.size[3];
+}
+
+// Gaussian blob centred at (cx, cy) in cell units, cell centres at +0.5
+static void splat(cv::Mat& blob, int channel, float cx, float cy, float peak, float sigma = 1.5f) {
+    const int rows = blob.size[2];
+    const int cols = blob.size[3];
+    float* data = planeData(blob, channel);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            float dx = x + 0.5f - cx;
+            float dy = y + 0.5f - cy;
+            float v = peak * std::exp(-(dx * dx + dy * dy) / (2.0f * sigma * sigma));
+            data[y * cols + x] = std::max(data[y * cols + x], v);
+        }
+    }
+}
+
+static Detection<> makeBall(int class_id, float confidence, float x, float y) {
+    Detection<> det;
+    det.class_id = class_id;
+    det.confidence = confidence;
+    det.center = cv::Point2f(x, y);
+    det.box = cv::Rect(static_cast<int>(x) - 5, static_cast<int>(y) - 5, 10, 10);
+    return det;
+}
+
+// Test local maxima, ordering, top-K and sub-cell refinement
+void test_find_peaks() {
+    std::cout << "Testing peak finding..." << std::endl;
+    
+    cv::Mat heatmap = makeBlob(2, 32, 48);
+    splat(heatmap, 0, 10.3f, 8.7f, 0.9f);
+    splat(heatmap, 0, 30.5f, 20.5f, 0.6f);
+    splat(heatmap, 1, 40.5f, 5.5f, 0.8f);
+    
+    auto peaks = HeatmapDetector::findPeaks(heatmap, 0.3f, 10);
+    assert(peaks.size() == 3);
+    assert(peaks[0].class_id == 0 && peaks[1].class_id == 1 && peaks[2].class_id == 0);
+    assert(peaks[0].score >= peaks[1].score && peaks[1].score >= peaks[2].score);
+    assert(peaks[0].cell == cv::Point(10, 8));
+    assert(std::abs(peaks[0].position.x - 10.3f) < 0.1f);
+    assert(std::abs(peaks[0].position.y - 8.7f) < 0.1f);
+    assert(std::abs(peaks[2].position.x - 30.5f) < 0.01f);
+    
+    // Threshold, top-K and class mask
+    assert(HeatmapDetector::findPeaks(heatmap, 0.7f, 10).size() == 2);
+    peaks = HeatmapDetector::findPeaks(heatmap, 0.3f, 1);
+    assert(peaks.size() == 1 && peaks[0].score > 0.85f);
+    peaks = HeatmapDetector::findPeaks(heatmap, 0.3f, 10, ClassMask{1});
+    assert(peaks.size() == 1 && peaks[0].class_id == 1);
+    
+    // A flat top is one peak, not four
+    cv::Mat flat = makeBlob(1, 16, 16);
+    float* data = planeData(flat, 0);
+    data[5 * 16 + 5] = data[5 * 16 + 6] = data[6 * 16 + 5] = data[6 * 16 + 6] = 0.7f;
+    peaks = HeatmapDetector::findPeaks(flat, 0.3f, 10);
+    assert(peaks.size() == 1);
+    assert(peaks[0].cell == cv::Point(5, 5));
+    
+    // So is a U whose arms only join further down
+    cv::Mat u = makeBlob(1, 16, 16);
+    data = planeData(u, 0);
+    data[4 * 16 + 4] = data[4 * 16 + 8] = 0.7f;
+    data[5 * 16 + 4] = data[5 * 16 + 8] = 0.7f;
+    for (int x = 4; x <= 8; ++x) data[6 * 16 + x] = 0.7f;
+    peaks = HeatmapDetector::findPeaks(u, 0.3f, 10);
+    assert(peaks.size() == 1);
+    assert(peaks[0].cell == cv::Point(4, 4));
+    
+    // Peaks on the border are found and left unrefined across the edge
+    cv::Mat edge = makeBlob(1, 16, 16);
+    planeData(edge, 0)[0] = 0.5f;
+    peaks = HeatmapDetector::findPeaks(edge, 0.3f, 10);
+    assert(peaks.size() == 1 && peaks[0].position == cv::Point2f(0.5f, 0.5f));
+    
+    std::cout << "✓ Peak finding passed" << std::endl;
+}
+
+// Test peaks become boxes in frame pixels, with and without side outputs
+void test_decode() {
+    std::cout << "Testing heatmap decoding..." << std::endl;
+    
+    HeatmapConfig config;
+    config.input_width = 512.0f;
+    config.input_height = 256.0f;
+    config.confidence_threshold = 0.3f;
+    config.default_size = 16.0f;
+    
+    // Stride 4 in both directions; the frame is twice the input size
+    cv::Mat heatmap = makeBlob(1, 64, 128);
+    splat(heatmap, 0, 50.5f, 20.5f, 0.9f);
+    const cv::Size frame(1024, 512);
+    
+    auto detections = HeatmapDetector::decode(heatmap, cv::Mat(), cv::Mat(), config, frame);
+    assert(detections.size() == 1);
+    assert(detections[0].class_id == 0);
+    assert(std::abs(detections[0].confidence - 0.9f) < 1e-4f);
+    assert(std::abs(detections[0].center.x - 50.5f * 4 * 2) < 0.5f);
+    assert(std::abs(detections[0].center.y - 20.5f * 4 * 2) < 0.5f);
+    assert(detections[0].box.width == 32 && detections[0].box.height == 32);
+    
+    // Size in cells and a regressed offset
+    cv::Mat sizes = makeBlob(2, 64, 128);
+    cv::Mat offsets = makeBlob(2, 64, 128);
+    const int index = 20 * 128 + 50;
+    planeData(sizes, 0)[index] = 5.0f;
+    planeData(sizes, 1)[index] = 6.0f;
+    planeData(offsets, 0)[index] = 0.25f;
+    planeData(offsets, 1)[index] = 0.75f;
+    detections = HeatmapDetector::decode(heatmap, sizes, offsets, config, frame);
+    assert(detections.size() == 1);
+    assert(std::abs(detections[0].center.x - 50.25f * 8) < 1e-3f);
+    assert(std::abs(detections[0].center.y - 20.75f * 8) < 1e-3f);
+    assert(detections[0].box.width == 40 && detections[0].box.height == 48);
+    
+    // Logits: thresholded before the sigmoid, reported after it
+    cv::Mat logits = makeBlob(1, 64, 128);
+    logits.setTo(cv::Scalar(-10.0));         // Background, sigmoid ~0
+    planeData(logits, 0)[index] = 2.0f;      // sigmoid 0.88
+    planeData(logits, 0)[index + 10] = -1.0f; // sigmoid 0.27, below threshold
+    config.logits = true;
+    detections = HeatmapDetector::decode(logits, cv::Mat(), cv::Mat(), config, frame);
+    assert(detections.size() == 1);
+    assert(std::abs(detections[0].confidence - 0.8808f) < 1e-3f);
+    
+    // Malformed heatmaps decode to nothing
+    assert(HeatmapDetector::decode(cv::Mat(), cv::Mat(), cv::Mat(), config, frame).empty());
+    
+    std::cout << "✓ Heatmap decoding passed" << std::endl;
+}
+
+// Test peaks of a noisy full-size plane, reporting the cost per plane
+void test_peak_speed() {
+    std::cout << "Testing peak finding speed..." << std::endl;
+    
+    cv::Mat heatmap = makeBlob(1, 128, 128);
+    cv::randu(heatmap, cv::Scalar(0.0), cv::Scalar(0.2));
+    splat(heatmap, 0, 64.5f, 40.5f, 0.9f);
+    
+    const int runs = 200;
+    auto start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    for (int i = 0; i < runs; ++i) {
+        found += HeatmapDetector::findPeaks(heatmap, 0.3f, 16).size();
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / runs;
+    assert(found == static_cast<size_t>(runs));
+    std::cout << "  " << ms << " ms per 128x128 plane" << std::endl;
+    
+    std::cout << "✓ Peak finding speed passed" << std::endl;
+}
+
+// Test the comparison harness counts agreement and keeps both latencies
+void test_comparison() {
+    std::cout << "Testing detector comparison..." << std::endl;
+    
+    analysis::ComparisonConfig config;
+    config.reference_classes = ClassMask{0, 2};
+    config.candidate_classes = ClassMask{0};
+    config.match_distance = 10.0f;
+    analysis::DetectorComparison comparison(config);
+    
+    // Best ball only: the rim and the weaker ball are ignored
+    std::vector<Detection<>> yolo = {makeBall(1, 0.95f, 500, 100), makeBall(0, 0.4f, 300, 300),
+                                     makeBall(2, 0.8f, 100, 100)};
+    std::vector<Detection<>> heatmap = {makeBall(0, 0.7f, 103, 104)};
+    assert(analysis::DetectorComparison::bestBall(yolo, config.reference_classes)->class_id == 2);
+    comparison.add(yolo, 20000, heatmap, 5000);
+    
+    comparison.add(yolo, 21000, {makeBall(0, 0.7f, 300, 300)}, 5000);   // Apart
+    comparison.add(yolo, 19000, {}, 4000);                             // Reference only
+    comparison.add({}, 22000, heatmap, 6000);                          // Candidate only
+    comparison.add({}, 20000, {}, 5000);                               // Neither
+    
+    assert(comparison.frames() == 5);
+    assert(comparison.agreed() == 1);
+    assert(comparison.disagreed() == 1);
+    assert(comparison.referenceOnly() == 1);
+    assert(comparison.candidateOnly() == 1);
+    assert(std::abs(comparison.meanError() - 5.0) < 1e-6);
+    assert(comparison.referenceLatency().count() == 5);
+    assert(comparison.candidateLatency().maxMs() == 6.0);
+    assert(comparison.summary().find("agreed 1 (mean error 5.0 px)") != std::string::npos);
+    
+    std::cout << "✓ Detector comparison passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Heatmap Detector Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_find_peaks();
+        test_decode();
+        test_peak_speed();
+        test_comparison();
+        
+        std::cout << std::endl << "=== All Heatmap Detector Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
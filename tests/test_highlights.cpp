@@ -0,0 +1,191 @@
+#include "analysis/ShotEvents.hpp"
+#include "io/TrackCsvWriter.hpp"
+#include "pipeline/HighlightRenderer.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::analysis;
+using namespace bbst::pipeline;
+namespace fs = std::filesystem;
+
+// Ball resting at y=600 with parabolic arcs of the given rise peaking at the apex frames
+static std::vector<FrameResult> makeTrack(int frames, const std::vector<std::pair<int, float>>& arcs,
+                                          int half_width = 30) {
+    std::vector<FrameResult> track(frames);
+    for (int f = 0; f < frames; ++f) {
+        track[f].frame_index = f;
+        track[f].timestamp_ms = f * 1000.0 / 30.0;
+        track[f].tracking = true;
+        track[f].position = cv::Point2f(100.0f + f, 600.0f);
+        track[f].ball_size = 20.0f;
+        for (const auto& [apex, rise] : arcs) {
+            float u = static_cast<float>(f - apex) / half_width;
+            if (std::abs(u) < 1.0f) {
+                track[f].position.y = 600.0f - rise * (1.0f - u * u);
+            }
+        }
+    }
+    return track;
+}
+
+// Test shot arcs are found and small bounces ignored
+void test_find_shots() {
+    std::cout << "Testing shot events..." << std::endl;
+    
+    auto track = makeTrack(300, {{50, 400.0f}, {150, 30.0f}, {230, 250.0f}});
+    auto events = findShotEvents(track);
+    assert(events.size() == 2);
+    assert(events[0].apex_frame == 50);
+    assert(events[0].launch_frame <= 21 && events[0].launch_frame >= 5);
+    assert(events[0].land_frame >= 79);
+    assert(std::abs(events[0].rise - 400.0f) < 1.0f);
+    assert(events[1].apex_frame == 230);
+    
+    // Losing the ball around the apex splits the flight: no shot
+    for (int f = 40; f < 60; ++f) track[f].tracking = false;
+    events = findShotEvents(track);
+    assert(events.size() == 1);
+    assert(events[0].apex_frame == 230);
+    
+    std::cout << "✓ Shot events passed" << std::endl;
+}
+
+// Test clip planning pads, clips and merges
+void test_plan_clips() {
+    std::cout << "Testing clip planning..." << std::endl;
+    
+    HighlightConfig config;
+    config.pre_frames = 10;
+    config.post_frames = 10;
+    
+    std::vector<ShotEvent> events(3);
+    events[0].launch_frame = 5;   events[0].apex_frame = 20;  events[0].land_frame = 35;
+    events[1].launch_frame = 40;  events[1].apex_frame = 55;  events[1].land_frame = 70;
+    events[2].launch_frame = 200; events[2].apex_frame = 215; events[2].land_frame = 230;
+    
+    auto clips = HighlightRenderer::planClips(events, 235, "/videos/game.mp4", "out", config);
+    assert(clips.size() == 2);
+    assert(clips[0].range.start == 0 && clips[0].range.end == 81);
+    assert(clips[0].apex_frames.size() == 2);
+    assert(clips[1].range.start == 190 && clips[1].range.end == 235);
+    assert(clips[0].path == (fs::path("out") / "game_shot01.mp4").string());
+    assert(clips[1].index == 2);
+    
+    std::cout << "✓ Clip planning passed" << std::endl;
+}
+
+// Test track files read back as written
+void test_track_round_trip() {
+    std::cout << "Testing track CSV round trip..." << std::endl;
+    
+    const std::string path = (fs::temp_directory_path() / "bbst_highlight_tracks.csv").string();
+    auto track = makeTrack(120, {{60, 300.0f}});
+    track[60].kinematics.speed = 250.0f;
+    track[60].kinematics.curvature = -0.004f;
+    track[60].kinematics.meters_per_pixel = 0.02f;
+    track[61].kinematics.meters_per_pixel = 0.02f;     // Scale known, ball at rest
+    for (int f = 10; f <= 30; ++f) {
+        track[f].holder = 5;                             // Releases at the launch
+        tracking::PlayerTrack player;
+        player.id = 5;
+        player.box = cv::Rect2f(100.0f + f, 200.0f, 40.0f, 100.0f);
+        track[f].players.push_back(player);
+    }
+    {
+        io::TrackCsvWriter writer(path);
+        for (const auto& result : track) writer.write(result);
+    }
+    auto loaded = io::readTrackCsv(path);
+    assert(loaded.size() == track.size());
+    assert(loaded[60].frame_index == 60);
+    assert(loaded[60].tracking);
+    assert(std::abs(loaded[60].position.y - track[60].position.y) < 0.5f);
+    assert(std::abs(loaded[60].kinematics.speed - 250.0f) < 0.1f);
+    assert(std::abs(loaded[60].kinematics.curvature + 0.004f) < 1e-5f);
+    assert(std::abs(loaded[60].kinematics.meters_per_pixel - 0.02f) < 1e-6f);
+    assert(std::abs(loaded[60].kinematics.speedMps() - 5.0f) < 0.01f);
+    assert(std::abs(loaded[61].kinematics.meters_per_pixel - 0.02f) < 1e-6f);
+    assert(!loaded[59].kinematics.calibrated());
+    assert(loaded[20].holder == 5 && loaded[31].holder == -1);
+    assert(loaded[20].players.size() == 1 && loaded[31].players.empty());
+    assert(loaded[20].players[0].box.br() == cv::Point2f(140.0f, 300.0f));
+    
+    // The shot is credited to the holder from the stored column
+    auto events = findShotEvents(loaded);
+    assert(events.size() == 1);
+    attributeShooters(events, possessionFromTrack(loaded));
+    assert(events[0].shooter == 5);
+    
+    // And its zone is read where the shooter stood at the release
+    locateShooters(events, loaded);
+    assert(events[0].floor_point == cv::Point2f(150.0f, 300.0f));
+    fs::remove(path);
+    
+    std::cout << "✓ Track CSV round trip passed" << std::endl;
+}
+
+// Test clips are rendered from the needed frames only
+void test_render_clips() {
+    std::cout << "Testing clip rendering..." << std::endl;
+    
+    const fs::path dir = fs::temp_directory_path() / "bbst_highlights_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string video = (dir / "game.avi").string();
+    const int fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+    {
+        cv::VideoWriter writer(video, fourcc, 30.0, cv::Size(320, 240));
+        if (!writer.isOpened()) {
+            std::cout << "⚠ Skipping test (no video encoder available)" << std::endl;
+            fs::remove_all(dir);
+            return;
+        }
+        for (int f = 0; f < 300; ++f) {
+            writer.write(cv::Mat(240, 320, CV_8UC3, cv::Scalar(f % 256, 80, 40)));
+        }
+    }
+    
+    auto track = makeTrack(300, {{50, 150.0f}, {230, 150.0f}});
+    for (auto& result : track) result.position.y -= 400.0f;  // Keep inside the frame
+    
+    HighlightConfig config;
+    config.workers = 2;
+    config.fourcc = fourcc;
+    config.extension = ".avi";
+    HighlightRenderer renderer(video, track, config);
+    auto clips = renderer.render(findShotEvents(track), (dir / "clips").string());
+    assert(clips.size() == 2);
+    for (const auto& clip : clips) {
+        cv::VideoCapture cap(clip.path);
+        assert(cap.isOpened());
+        int frames = 0;
+        cv::Mat frame;
+        while (cap.read(frame)) frames++;
+        assert(frames == clip.range.length());
+    }
+    fs::remove_all(dir);
+    
+    std::cout << "✓ Clip rendering passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Highlight Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_find_shots();
+        test_plan_clips();
+        test_track_round_trip();
+        test_render_clips();
+        
+        std::cout << std::endl << "=== All Highlight Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
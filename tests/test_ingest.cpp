@@ -0,0 +1,172 @@
+#include "ingest/JobJournal.hpp"
+#include "ingest/JobQueue.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+using namespace bbst::ingest;
+
+static const char* JOURNAL = "test_ingest.journal";
+
+static Job makeJob(uint64_t id, Priority priority) {
+    Job job;
+    job.id = id;
+    job.path = "clip" + std::to_string(id) + ".mp4";
+    job.priority = priority;
+    return job;
+}
+
+// Test priority order: live > recent > archive, FIFO within a class
+void test_queue_order() {
+    std::cout << "Testing job queue order..." << std::endl;
+    
+    JobQueue queue;
+    queue.push(makeJob(1, Priority::Archive));
+    queue.push(makeJob(2, Priority::Recent));
+    queue.push(makeJob(3, Priority::Live));
+    queue.push(makeJob(4, Priority::Recent));
+    queue.push(makeJob(5, Priority::Live));
+    assert(queue.size() == 5);
+    
+    const uint64_t expected[] = {3, 5, 2, 4, 1};
+    for (uint64_t id : expected) {
+        auto job = queue.pop();
+        assert(job && job->id == id);
+    }
+    
+    queue.close();
+    assert(!queue.pop());
+    
+    std::cout << "✓ Job queue order passed" << std::endl;
+}
+
+// Test that a restart resumes unfinished jobs without duplicating finished ones
+void test_journal_replay() {
+    std::cout << "Testing journal replay..." << std::endl;
+    std::remove(JOURNAL);
+    
+    uint64_t running_id = 0;
+    {
+        JobJournal journal(JOURNAL);
+        auto a = journal.enqueue("a.mp4", Priority::Recent);
+        auto b = journal.enqueue("b.mp4", Priority::Live);
+        auto c = journal.enqueue("c.mp4", Priority::Archive);
+        assert(a && b && c);
+        assert(!journal.enqueue("a.mp4", Priority::Live));  // Already queued
+        
+        journal.markStarted(*a);
+        journal.markDone(*a);
+        journal.markStarted(*b);  // Still running when the process dies
+        running_id = b->id;
+    }
+    
+    JobJournal journal(JOURNAL);
+    auto pending = journal.pendingJobs();
+    assert(pending.size() == 2);
+    assert(pending[0].path == "b.mp4" && pending[0].id == running_id);
+    assert(pending[0].priority == Priority::Live);
+    assert(pending[0].attempts == 1);
+    assert(pending[1].path == "c.mp4");
+    
+    // Finished paths survive compaction and are not queued again
+    assert(journal.isKnown("a.mp4"));
+    assert(!journal.enqueue("a.mp4", Priority::Recent));
+    auto d = journal.enqueue("d.mp4", Priority::Recent);
+    assert(d && d->id > running_id);
+    
+    // A failed path is forgotten, so dropping it again retries it
+    journal.markFailed(*d);
+    assert(!journal.isKnown("d.mp4"));
+    assert(journal.enqueue("d.mp4", Priority::Recent));
+    
+    std::remove(JOURNAL);
+    std::cout << "✓ Journal replay passed" << std::endl;
+}
+
+// Test that a clip which always fails is given up across restarts
+void test_journal_failure_limit() {
+    std::cout << "Testing journal failure limit..." << std::endl;
+    std::remove(JOURNAL);
+    
+    {
+        JobJournal journal(JOURNAL, 2);
+        auto job = journal.enqueue("broken.mp4", Priority::Recent);
+        journal.markStarted(*job);
+        journal.markFailed(*job);
+        auto done = journal.enqueue("flaky.mp4", Priority::Recent);
+        journal.markStarted(*done);
+        journal.markFailed(*done);
+    }
+    {
+        // The catch-up scan queues both again; the count survives compaction
+        JobJournal journal(JOURNAL, 2);
+        assert(!journal.isKnown("broken.mp4"));
+        auto job = journal.enqueue("broken.mp4", Priority::Recent);
+        journal.markStarted(*job);
+        journal.markFailed(*job);
+        assert(journal.isKnown("broken.mp4"));
+        
+        auto done = journal.enqueue("flaky.mp4", Priority::Recent);
+        journal.markStarted(*done);
+        journal.markDone(*done);
+    }
+    
+    JobJournal journal(JOURNAL, 2);
+    assert(journal.pendingJobs().empty());
+    assert(!journal.enqueue("broken.mp4", Priority::Recent));
+    assert(!journal.enqueue("flaky.mp4", Priority::Recent));
+    
+    std::remove(JOURNAL);
+    std::cout << "✓ Journal failure limit passed" << std::endl;
+}
+
+// Test that a clip which keeps killing the process is eventually dropped
+void test_journal_attempt_limit() {
+    std::cout << "Testing journal attempt limit..." << std::endl;
+    std::remove(JOURNAL);
+    
+    {
+        JobJournal journal(JOURNAL, 2);
+        auto job = journal.enqueue("crash.mp4", Priority::Recent);
+        journal.markStarted(*job);
+    }
+    {
+        JobJournal journal(JOURNAL, 2);
+        auto pending = journal.pendingJobs();
+        assert(pending.size() == 1);
+        journal.markStarted(pending[0]);
+    }
+    
+    // Torn last line from a kill mid-write is ignored
+    {
+        std::ofstream out(JOURNAL, std::ios::app);
+        out << "S\t";
+    }
+    
+    JobJournal journal(JOURNAL, 2);
+    assert(journal.pendingJobs().empty());
+    assert(journal.abandonedPaths().size() == 1);
+    assert(journal.isKnown("crash.mp4"));
+    
+    std::remove(JOURNAL);
+    std::cout << "✓ Journal attempt limit passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Ingest Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_queue_order();
+        test_journal_replay();
+        test_journal_attempt_limit();
+        test_journal_failure_limit();
+        
+        std::cout << std::endl << "=== All Ingest Tests Passed! ===" << std::endl;
+        return 0;
+    
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,122 @@
+#include "detectors/InputScaleController.hpp"
+#include <iostream>
+#include <cassert>
+#include <opencv2/opencv.hpp>
+
+using namespace bbst;
+
+static const cv::Size kFrame(1920, 1080);
+
+// Test ball size conversion to network pixels
+void test_ball_pixels() {
+    std::cout << "Testing ball pixel conversion..." << std::endl;
+    
+    // 1920 -> 640 is a factor of 3
+    assert(InputScaleController::ballPixels(60.0f, kFrame, 640) == 20.0f);
+    assert(InputScaleController::ballPixels(60.0f, cv::Size(), 640) == 0.0f);
+    
+    std::cout << "✓ Ball pixel conversion passed" << std::endl;
+}
+
+// Test default size while nothing is tracked
+void test_default_when_lost() {
+    std::cout << "Testing default size when lost..." << std::endl;
+    
+    InputScaleController controller;
+    assert(controller.current() == 640);
+    assert(controller.update(0.0f, kFrame, false) == 640);
+    
+    // Unknown default falls back to the largest size
+    InputScaleConfig config;
+    config.default_size = 700;
+    InputScaleController odd(config);
+    assert(odd.current() == 960);
+    
+    std::cout << "✓ Default size passed" << std::endl;
+}
+
+// Test stepping down for large balls, with hysteresis
+void test_shrink_with_hysteresis() {
+    std::cout << "Testing shrink with hysteresis..." << std::endl;
+    
+    InputScaleConfig config;
+    InputScaleController controller(config);
+    
+    // Large ball: 150px -> 25px at 320, above 16 * 1.3
+    for (int i = 0; i < config.frames_to_shrink - 1; ++i) {
+        assert(controller.update(150.0f, kFrame, true) == 640);
+    }
+    assert(controller.update(150.0f, kFrame, true) == 320);
+    
+    // Slightly smaller ball still fits at 320 without the margin: stay put
+    for (int i = 0; i < 50; ++i) {
+        assert(controller.update(100.0f, kFrame, true) == 320);
+    }
+    
+    std::cout << "✓ Shrink with hysteresis passed" << std::endl;
+}
+
+// Test stepping up quickly for small balls
+void test_grow_quickly() {
+    std::cout << "Testing grow..." << std::endl;
+    
+    InputScaleConfig config;
+    InputScaleController controller(config);
+    
+    // 30px ball -> 10px at 640, 15px at 960: nothing reaches 16, use largest
+    for (int i = 0; i < config.frames_to_grow - 1; ++i) {
+        assert(controller.update(30.0f, kFrame, true) == 640);
+    }
+    assert(controller.update(30.0f, kFrame, true) == 960);
+    
+    // An interrupted streak does not switch
+    InputScaleController other(config);
+    other.update(30.0f, kFrame, true);
+    other.update(60.0f, kFrame, true);
+    other.update(30.0f, kFrame, true);
+    assert(other.current() == 640);
+    
+    std::cout << "✓ Grow passed" << std::endl;
+}
+
+// Test a brief loss keeps the size, a lasting one falls back
+void test_fallback_when_lost() {
+    std::cout << "Testing fallback when lost..." << std::endl;
+    
+    InputScaleConfig config;
+    InputScaleController controller(config);
+    for (int i = 0; i < config.frames_to_grow; ++i) {
+        controller.update(30.0f, kFrame, true);
+    }
+    assert(controller.current() == 960);
+    
+    // One missed frame, then the ball is back
+    assert(controller.update(0.0f, kFrame, false) == 960);
+    assert(controller.update(30.0f, kFrame, true) == 960);
+    
+    for (int i = 0; i < config.frames_to_fallback - 1; ++i) {
+        assert(controller.update(0.0f, kFrame, false) == 960);
+    }
+    assert(controller.update(0.0f, kFrame, false) == 640);
+    
+    std::cout << "✓ Fallback when lost passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Input Scale Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_ball_pixels();
+        test_default_when_lost();
+        test_shrink_with_hysteresis();
+        test_grow_quickly();
+        test_fallback_when_lost();
+        
+        std::cout << std::endl << "=== All Input Scale Tests Passed! ===" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,165 @@
+#include "pipeline/JobTable.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace bbst::pipeline;
+
+static const char* TABLE = "test_job_table.tbl";
+
+// Test chunk planning
+void test_plan_chunks() {
+    std::cout << "Testing chunk planning..." << std::endl;
+    
+    auto jobs = planChunks({250, 100}, 100);
+    assert(jobs.size() == 4);
+    assert(jobs[0].video == 0 && jobs[0].start == 0 && jobs[0].end == 100);
+    assert(jobs[2].video == 0 && jobs[2].start == 200 && jobs[2].end == 250);
+    assert(jobs[3].video == 1 && jobs[3].start == 0 && jobs[3].end == 100);
+    
+    std::cout << "✓ Chunk planning passed" << std::endl;
+}
+
+// Test home-shard claiming, stealing and completion
+void test_claim_and_steal() {
+    std::cout << "Testing claim and steal..." << std::endl;
+    
+    JobTable::create(TABLE, {"a.mp4"}, planChunks({800}, 100), 2);
+    JobTable first(TABLE);
+    JobTable second(TABLE);
+    assert(first.rank() == 0 && second.rank() == 1);
+    assert(first.jobCount() == 8 && first.videoPath(0) == "a.mp4");
+    
+    // Each worker starts at the front of its own half
+    auto a = first.claim();
+    auto b = second.claim();
+    assert(a && a->index == 0 && !a->stolen);
+    assert(b && b->index == 4 && !b->stolen);
+    assert(first.complete(*a));
+    assert(!first.complete(*a));  // Token is spent
+    
+    // Drain the first worker's shard, then it steals from the back of the other
+    for (uint32_t i = 1; i < 4; ++i) {
+        auto claim = first.claim();
+        assert(claim && claim->index == i);
+        assert(first.complete(*claim));
+    }
+    auto stolen = first.claim();
+    assert(stolen && stolen->index == 7 && stolen->stolen);
+    
+    JobCounts counts = first.counts();
+    assert(counts.done == 4 && counts.claimed == 2 && counts.pending == 2);
+    assert(!first.finished());
+    
+    std::remove(TABLE);
+    std::cout << "✓ Claim and steal passed" << std::endl;
+}
+
+// Test that an expired lease is reclaimed and the old owner can't complete
+void test_lease_reclaim() {
+    std::cout << "Testing lease reclaim..." << std::endl;
+    
+    JobTable::create(TABLE, {"a.mp4"}, planChunks({100}, 100), 1, 50, 2);
+    JobTable crashed(TABLE);
+    JobTable survivor(TABLE);
+    
+    auto lost = crashed.claim();
+    assert(lost);
+    assert(!survivor.claim());  // Lease still live
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    auto taken = survivor.claim();
+    assert(taken && taken->reclaimed && taken->index == lost->index);
+    
+    assert(!crashed.renew(*lost));
+    assert(!crashed.complete(*lost));
+    assert(survivor.renew(*taken));
+    assert(survivor.complete(*taken));
+    assert(survivor.finished());
+    
+    // The stale owner's failed renew leaves the new owner's lease alone
+    JobTable::create(TABLE, {"a.mp4"}, planChunks({100}, 100), 1, 50, 3);
+    JobTable stale(TABLE);
+    JobTable owner(TABLE);
+    lost = stale.claim();
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    taken = owner.claim();
+    assert(lost && taken && taken->reclaimed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    assert(!stale.renew(*lost));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    auto again = stale.claim();
+    assert(again && again->reclaimed);
+    assert(!owner.complete(*taken));
+    
+    // A job whose workers keep dying is failed after max_attempts
+    JobTable::create(TABLE, {"a.mp4"}, planChunks({100}, 100), 1, 10, 2);
+    JobTable worker(TABLE);
+    assert(worker.claim());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(worker.claim());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(!worker.claim());
+    assert(worker.state(0) == JobState::Failed);
+    assert(worker.finished());
+    
+    std::remove(TABLE);
+    std::cout << "✓ Lease reclaim passed" << std::endl;
+}
+
+// Test that concurrent processes complete every job exactly once
+void test_multi_process() {
+    std::cout << "Testing multi-process claiming..." << std::endl;
+    
+    const int processes = 4;
+    JobTable::create(TABLE, {"a.mp4", "b.mp4"}, planChunks({10000, 10000}, 100), processes);
+    
+    for (int p = 0; p < processes; ++p) {
+        if (::fork() == 0) {
+            JobTable table(TABLE);
+            int completed = 0;
+            while (auto claim = table.claim()) {
+                completed += table.complete(*claim) ? 1 : 0;
+            }
+            ::_exit(completed);
+        }
+    }
+    
+    int total = 0;
+    for (int p = 0; p < processes; ++p) {
+        int status = 0;
+        ::wait(&status);
+        assert(WIFEXITED(status));
+        total += WEXITSTATUS(status);
+    }
+    
+    JobTable table(TABLE);
+    assert(total == 200);
+    assert(table.counts().done == 200);
+    assert(table.finished());
+    
+    std::remove(TABLE);
+    std::cout << "✓ Multi-process claiming passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Job Table Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_plan_chunks();
+        test_claim_and_steal();
+        test_lease_reclaim();
+        test_multi_process();
+        
+        std::cout << std::endl << "=== All Job Table Tests Passed! ===" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,133 @@
+#include "io/StampedSource.hpp"
+#include "util/LatencyStats.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::io;
+
+// Test nearest-rank percentiles
+void test_latency_stats() {
+    std::cout << "Testing latency stats..." << std::endl;
+    
+    util::LatencyStats stats;
+    assert(stats.percentileMs(0.5) == 0.0);
+    
+    for (int i = 1; i <= 100; ++i) {
+        stats.record(i * 1000);  // 1..100 ms
+    }
+    assert(stats.count() == 100);
+    assert(stats.percentileMs(0.5) == 50.0);
+    assert(stats.percentileMs(0.9) == 90.0);
+    assert(stats.percentileMs(0.99) == 99.0);
+    assert(stats.percentileMs(0.0) == 1.0);
+    assert(stats.maxMs() == 100.0);
+    assert(stats.meanMs() == 50.5);
+    assert(stats.summary().find("p99 99.0") != std::string::npos);
+    
+    std::cout << "✓ Latency stats passed" << std::endl;
+}
+
+// Test stamps survive overlays and lossy encoding
+void test_stamp_round_trip() {
+    std::cout << "Testing stamp round trip..." << std::endl;
+    
+    cv::Mat frame(720, 1280, CV_8UC3, cv::Scalar(40, 60, 90));
+    FrameStamp stamp;
+    stamp.frame_id = 123456;
+    stamp.capture_us = FrameStamper::nowUs();
+    FrameStamper::stamp(frame, stamp);
+    
+    auto decoded = FrameStamper::read(frame);
+    assert(decoded);
+    assert(decoded->frame_id == stamp.frame_id);
+    assert(decoded->capture_us == stamp.capture_us);
+    
+    // Overlay drawn above the band and a JPEG round trip
+    cv::rectangle(frame, cv::Rect(100, 100, 300, 200), cv::Scalar(0, 255, 0), 2);
+    cv::putText(frame, "Frame: 1", cv::Point(10, 22), cv::FONT_HERSHEY_SIMPLEX, 0.5,
+                cv::Scalar(255, 255, 255));
+    std::vector<uchar> jpeg;
+    cv::imencode(".jpg", frame, jpeg, {cv::IMWRITE_JPEG_QUALITY, 75});
+    cv::Mat reloaded = cv::imdecode(jpeg, cv::IMREAD_COLOR);
+    
+    decoded = FrameStamper::read(reloaded);
+    assert(decoded);
+    assert(decoded->frame_id == stamp.frame_id);
+    assert(decoded->capture_us == stamp.capture_us);
+    
+    // Unstamped or damaged frames are rejected
+    cv::Mat blank(720, 1280, CV_8UC3, cv::Scalar(0, 0, 0));
+    assert(!FrameStamper::read(blank));
+    int band = FrameStamper::bandHeight(frame.cols);
+    frame.rowRange(frame.rows - band, frame.rows).colRange(0, 200).setTo(cv::Scalar::all(255));
+    assert(!FrameStamper::read(frame));
+    
+    std::cout << "✓ Stamp round trip passed" << std::endl;
+}
+
+// Test the offline source hands out every frame in order
+void test_offline_source() {
+    std::cout << "Testing offline synthetic source..." << std::endl;
+    
+    StampedSource source(cv::Size(640, 360), 30.0, 20, false);
+    cv::Mat frame;
+    int frames = 0;
+    while (source.read(frame)) {
+        auto stamp = FrameStamper::read(frame);
+        assert(stamp);
+        assert(stamp->frame_id == static_cast<uint32_t>(frames));
+        frames++;
+    }
+    assert(frames == 20);
+    assert(source.dropped() == 0);
+    assert(source.frameSize() == cv::Size(640, 360));
+    
+    std::cout << "✓ Offline synthetic source passed" << std::endl;
+}
+
+// Test a slow consumer sees queueing latency and drops
+void test_realtime_source() {
+    std::cout << "Testing realtime synthetic source..." << std::endl;
+    
+    StampedSource source(cv::Size(640, 360), 100.0, 100, true, 4);
+    LatencyProbe probe;
+    cv::Mat frame;
+    
+    // Keeping up: latency stays near zero
+    for (int i = 0; i < 5; ++i) {
+        assert(source.read(frame));
+        assert(probe.observe(frame));
+    }
+    assert(probe.stats().maxMs() < 20.0);
+    
+    // Stall for 20 frame periods: the queue overflows
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(source.read(frame));
+    assert(probe.observe(frame));
+    assert(source.dropped() > 0);
+    assert(probe.stats().maxMs() >= 30.0);  // At least max_queued - 1 periods old
+    
+    assert(probe.unreadable() == 0);
+    std::cout << "✓ Realtime synthetic source passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Latency Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_latency_stats();
+        test_stamp_round_trip();
+        test_offline_source();
+        test_realtime_source();
+        
+        std::cout << std::endl << "=== All Latency Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,135 @@
+#include "analysis/MakeMiss.hpp"
+#include "pipeline/BallPipeline.hpp"
+#include <iostream>
+#include <cassert>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::analysis;
+
+// Rim 60x20 centered at (400, 210); judging zone 180x60
+static const cv::Rect RIM(370, 200, 60, 20);
+
+// Feed a ball path (nullopt = not detected) and collect outcomes
+static std::vector<ShotOutcome> judge(MakeMissJudge& judge,
+                                      const std::vector<std::optional<cv::Point2f>>& path) {
+    std::vector<ShotOutcome> outcomes;
+    for (const auto& ball : path) {
+        ShotOutcome outcome = judge.update(RIM, ball ? &*ball : nullptr);
+        if (outcome != ShotOutcome::None) outcomes.push_back(outcome);
+    }
+    return outcomes;
+}
+
+// Test a ball dropping through the rim is a make
+void test_make() {
+    std::cout << "Testing make..." << std::endl;
+    
+    MakeMissJudge judge_make;
+    auto outcomes = judge(judge_make, {cv::Point2f(360, 150), cv::Point2f(380, 185),
+                                       cv::Point2f(392, 195), cv::Point2f(398, 212),
+                                       cv::Point2f(400, 232), cv::Point2f(401, 260)});
+    assert(outcomes.size() == 1);
+    assert(outcomes[0] == ShotOutcome::Make);
+    assert(!judge_make.inVisit());
+    
+    // The net hides the ball for a few frames on the way down
+    MakeMissJudge judge_net;
+    outcomes = judge(judge_net, {cv::Point2f(385, 188), cv::Point2f(395, 195),
+                                 cv::Point2f(399, 214), std::nullopt, std::nullopt,
+                                 cv::Point2f(400, 238), cv::Point2f(400, 270)});
+    assert(outcomes.size() == 1 && outcomes[0] == ShotOutcome::Make);
+    
+    std::cout << "✓ Make passed" << std::endl;
+}
+
+// Test rim-outs and airballs are misses
+void test_miss() {
+    std::cout << "Testing miss..." << std::endl;
+    
+    // Drops past the outside of the rim
+    MakeMissJudge judge_side;
+    auto outcomes = judge(judge_side, {cv::Point2f(420, 185), cv::Point2f(435, 195),
+                                       cv::Point2f(442, 215), cv::Point2f(450, 232),
+                                       cv::Point2f(470, 260)});
+    assert(outcomes.size() == 1 && outcomes[0] == ShotOutcome::Miss);
+    
+    // Bounces back up off the rim and leaves the zone
+    MakeMissJudge judge_bounce;
+    outcomes = judge(judge_bounce, {cv::Point2f(390, 190), cv::Point2f(398, 198),
+                                    cv::Point2f(405, 190), cv::Point2f(420, 180),
+                                    cv::Point2f(450, 150)});
+    assert(outcomes.size() == 1 && outcomes[0] == ShotOutcome::Miss);
+    
+    // Ball lost near the rim and never found again
+    MakeMissJudge judge_lost;
+    std::vector<std::optional<cv::Point2f>> lost = {cv::Point2f(390, 190), cv::Point2f(398, 195),
+                                                    cv::Point2f(404, 198)};
+    lost.insert(lost.end(), judge_lost.config().max_missing + 1, std::nullopt);
+    outcomes = judge(judge_lost, lost);
+    assert(outcomes.size() == 1 && outcomes[0] == ShotOutcome::Miss);
+    
+    std::cout << "✓ Miss passed" << std::endl;
+}
+
+// Test passes under the rim and brief glimpses are not shots
+void test_not_a_shot() {
+    std::cout << "Testing non-shots..." << std::endl;
+    
+    // Carried through the zone below the rim, never above it
+    MakeMissJudge judge_below;
+    auto outcomes = judge(judge_below, {cv::Point2f(330, 230), cv::Point2f(370, 232),
+                                        cv::Point2f(410, 234), cv::Point2f(450, 236),
+                                        cv::Point2f(500, 238)});
+    assert(outcomes.empty());
+    
+    // One detection in the zone, then gone
+    MakeMissJudge judge_glimpse;
+    outcomes = judge(judge_glimpse, {cv::Point2f(398, 190), cv::Point2f(600, 100)});
+    assert(outcomes.empty());
+    
+    assert(std::string(shotOutcomeName(ShotOutcome::Make)) == "Make");
+    std::cout << "✓ Non-shots passed" << std::endl;
+}
+
+// Test the burst crop is only requested near the rim and stays in the frame
+void test_burst_region() {
+    std::cout << "Testing rim burst region..." << std::endl;
+    
+    using pipeline::BallPipeline;
+    const cv::Size frame(1920, 1080);
+    
+    assert(BallPipeline::rimBurstRegion(RIM, 3.0f, cv::Point2f(900, 500), 640, frame).empty());
+    
+    cv::Rect crop = BallPipeline::rimBurstRegion(RIM, 3.0f, cv::Point2f(410, 190), 640, frame);
+    assert(crop.size() == cv::Size(640, 640));
+    assert((crop & RIM) == RIM);
+    assert(crop.x >= 0 && crop.y == 0);  // Shifted down, not clipped
+    
+    // A rim bigger than the input keeps the whole zone in the crop
+    cv::Rect big_rim(800, 500, 300, 100);
+    crop = BallPipeline::rimBurstRegion(big_rim, 3.0f, cv::Point2f(950, 550), 640, frame);
+    assert(crop.width == 900 && crop.height == 900);
+    assert((crop & cv::Rect(0, 0, frame.width, frame.height)) == crop);
+    
+    std::cout << "✓ Rim burst region passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Make/Miss Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_make();
+        test_miss();
+        test_not_a_shot();
+        test_burst_region();
+        
+        std::cout << std::endl << "=== All Make/Miss Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,165 @@
+#include "util/MemoryStats.hpp"
+#include "util/TaggingMatAllocator.hpp"
+#include "core/Trajectory.hpp"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::util;
+
+// Test that pmr containers are charged to their resource's tag
+void test_counting_resource() {
+    std::cout << "Testing counting resource..." << std::endl;
+    
+    TagStats before = MemoryStats::snapshot(MemTag::Render);
+    {
+        std::pmr::vector<int> values(taggedResource(MemTag::Render));
+        values.resize(1000);
+        
+        TagStats during = MemoryStats::snapshot(MemTag::Render);
+        assert(during.live_bytes - before.live_bytes >= static_cast<int64_t>(1000 * sizeof(int)));
+        assert(during.allocations > before.allocations);
+        assert(during.peak_bytes >= during.live_bytes);
+    }
+    TagStats after = MemoryStats::snapshot(MemTag::Render);
+    assert(after.live_bytes == before.live_bytes);
+    assert(after.frees > before.frees);
+    
+    std::cout << "✓ Counting resource passed" << std::endl;
+}
+
+// Test that trajectories count as tracking memory
+void test_trajectory_tagging() {
+    std::cout << "Testing trajectory tagging..." << std::endl;
+    
+    TagStats before = MemoryStats::snapshot(MemTag::Tracking);
+    {
+        Trajectory trajectory(500);
+        for (int i = 0; i < 500; ++i) {
+            trajectory += cv::Point2f(static_cast<float>(i), 0.0f);
+        }
+        assert(MemoryStats::snapshot(MemTag::Tracking).live_bytes > before.live_bytes);
+    }
+    assert(MemoryStats::snapshot(MemTag::Tracking).live_bytes == before.live_bytes);
+    
+    std::cout << "✓ Trajectory tagging passed" << std::endl;
+}
+
+// Test scopes nest and are per thread
+void test_scopes() {
+    std::cout << "Testing memory scopes..." << std::endl;
+    
+    assert(MemoryStats::currentTag() == MemTag::Other);
+    {
+        MemoryScope decode(MemTag::Decode);
+        assert(MemoryStats::currentTag() == MemTag::Decode);
+        {
+            MemoryScope dnn(MemTag::Dnn);
+            assert(MemoryStats::currentTag() == MemTag::Dnn);
+            
+            MemTag seen = MemTag::Dnn;
+            std::thread other([&seen] { seen = MemoryStats::currentTag(); });
+            other.join();
+            assert(seen == MemTag::Other);
+        }
+        assert(MemoryStats::currentTag() == MemTag::Decode);
+    }
+    assert(MemoryStats::currentTag() == MemTag::Other);
+    
+    std::cout << "✓ Memory scopes passed" << std::endl;
+}
+
+// Test concurrent updates keep the counters consistent
+void test_concurrent_counts() {
+    std::cout << "Testing concurrent counts..." << std::endl;
+    
+    TagStats before = MemoryStats::snapshot(MemTag::Other);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10000; ++i) {
+                MemoryStats::recordAllocation(MemTag::Other, 64);
+                MemoryStats::recordFree(MemTag::Other, 64);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    TagStats after = MemoryStats::snapshot(MemTag::Other);
+    assert(after.live_bytes == before.live_bytes);
+    assert(after.allocations - before.allocations == 40000);
+    assert(after.frees - before.frees == 40000);
+    assert(after.peak_bytes >= before.live_bytes + 64);
+    
+    std::cout << "✓ Concurrent counts passed" << std::endl;
+}
+
+// Test Mat buffers are charged to the allocating scope and credited back on release
+void test_mat_allocator() {
+    std::cout << "Testing Mat allocator..." << std::endl;
+    
+    TaggingMatAllocator::install();
+    TagStats before = MemoryStats::snapshot(MemTag::Render);
+    
+    cv::Mat image;
+    {
+        MemoryScope render(MemTag::Render);
+        image = cv::Mat(480, 640, CV_8UC3, cv::Scalar(0, 0, 0));
+    }
+    TagStats during = MemoryStats::snapshot(MemTag::Render);
+    assert(during.live_bytes - before.live_bytes >= 480 * 640 * 3);
+    
+    // Released outside the scope, still credited to render
+    image.release();
+    assert(MemoryStats::snapshot(MemTag::Render).live_bytes == before.live_bytes);
+    
+    // Wrapping user memory costs nothing
+    std::vector<uint8_t> buffer(100);
+    {
+        MemoryScope render(MemTag::Render);
+        cv::Mat wrapped(10, 10, CV_8UC1, buffer.data());
+        cv::Mat copy = wrapped.clone();
+        assert(MemoryStats::snapshot(MemTag::Render).live_bytes - before.live_bytes >= 100);
+    }
+    assert(MemoryStats::snapshot(MemTag::Render).live_bytes == before.live_bytes);
+    
+    std::cout << "✓ Mat allocator passed" << std::endl;
+}
+
+// Test the report lists active subsystems
+void test_report() {
+    std::cout << "Testing report..." << std::endl;
+    
+    std::ostringstream out;
+    MemoryStats::report(out);
+    std::string text = out.str();
+    assert(text.find("tracking") != std::string::npos);
+    assert(text.find("RSS") != std::string::npos);
+    
+    std::cout << "✓ Report passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Memory Stats Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_counting_resource();
+        test_trajectory_tagging();
+        test_scopes();
+        test_concurrent_counts();
+        test_mat_allocator();
+        test_report();
+        
+        std::cout << std::endl << "=== All Memory Stats Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+#include "analysis/MotionCues.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+using namespace bbst;
+using namespace bbst::analysis;
+
+// 1280x720 field of 16x16 blocks all moving by the same vector
+static io::MotionField makeField(cv::Point2f motion) {
+    io::MotionField field;
+    field.frame_size = cv::Size(1280, 720);
+    for (int y = 8; y < 720; y += 16) {
+        for (int x = 8; x < 1280; x += 16) {
+            io::MotionVector vector;
+            vector.position = cv::Point2f(static_cast<float>(x), static_cast<float>(y));
+            vector.motion = motion;
+            vector.block = cv::Size(16, 16);
+            field.vectors.push_back(vector);
+        }
+    }
+    return field;
+}
+
+// Give the blocks inside a rectangle a different motion
+static void addObject(io::MotionField& field, const cv::Rect& area, cv::Point2f motion) {
+    for (auto& vector : field.vectors) {
+        if (area.contains(cv::Point(static_cast<int>(vector.position.x),
+                                    static_cast<int>(vector.position.y)))) {
+            vector.motion = motion;
+        }
+    }
+}
+
+// Test camera pan estimation
+void test_camera_motion() {
+    std::cout << "Testing camera motion estimation..." << std::endl;
+    
+    io::MotionField field = makeField(cv::Point2f(4.0f, -1.0f));
+    addObject(field, cv::Rect(600, 300, 48, 48), cv::Point2f(-10.0f, 12.0f));
+    
+    MotionCues cues;
+    cv::Point2f camera = cues.estimateCameraMotion(field);
+    assert(std::abs(camera.x - 4.0f) < 1e-3f);
+    assert(std::abs(camera.y + 1.0f) < 1e-3f);
+    
+    std::cout << "✓ Camera motion estimation passed" << std::endl;
+}
+
+// Test that a pure pan is a static scene
+void test_static_scene() {
+    std::cout << "Testing static scene gating..." << std::endl;
+    
+    MotionCues cues;
+    MotionSummary summary = cues.analyze(makeField(cv::Point2f(6.0f, 0.0f)));
+    assert(summary.valid);
+    assert(summary.static_scene);
+    assert(summary.regions.empty());
+    
+    // Intra frames carry no motion information at all
+    io::MotionField intra;
+    intra.frame_size = cv::Size(1280, 720);
+    intra.intra = true;
+    assert(!cues.analyze(intra).valid);
+    
+    std::cout << "✓ Static scene gating passed" << std::endl;
+}
+
+// Test region proposals for an object moving against the pan
+void test_region_proposals() {
+    std::cout << "Testing region proposals..." << std::endl;
+    
+    io::MotionField field = makeField(cv::Point2f(3.0f, 0.0f));
+    addObject(field, cv::Rect(640, 320, 32, 32), cv::Point2f(-8.0f, -15.0f));
+    
+    MotionCues cues;
+    MotionSummary summary = cues.analyze(field);
+    assert(summary.valid);
+    assert(!summary.static_scene);
+    assert(summary.regions.size() == 1);
+    assert(summary.regions[0] == cv::Rect(640, 320, 32, 32));
+    
+    // A blob covering most of the frame is not a ball proposal
+    io::MotionField crowd = makeField(cv::Point2f(0.0f, 0.0f));
+    addObject(crowd, cv::Rect(0, 0, 1280, 340), cv::Point2f(5.0f, 5.0f));
+    assert(cues.analyze(crowd).regions.empty());
+    
+    std::cout << "✓ Region proposals passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Motion Cue Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_camera_motion();
+        test_static_scene();
+        test_region_proposals();
+        
+        std::cout << std::endl << "=== All Motion Cue Tests Passed! ===" << std::endl;
+        return 0;
+    
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
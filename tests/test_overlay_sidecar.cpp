@@ -0,0 +1,185 @@
+#include "io/OverlaySidecarWriter.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::io;
+
+static std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static Detection<> makeDetection(int class_id, float confidence, cv::Rect box) {
+    Detection<> det;
+    det.class_id = class_id;
+    det.confidence = confidence;
+    det.box = box;
+    return det;
+}
+
+// Test BGR scalars become RGB hex
+void test_hex_color() {
+    std::cout << "Testing hex colors..." << std::endl;
+    
+    assert(OverlaySidecarWriter::hexColor(cv::Scalar(0, 165, 255)) == "#ffa500");
+    assert(OverlaySidecarWriter::hexColor(cv::Scalar(255, 0, 0)) == "#0000ff");
+    assert(OverlaySidecarWriter::hexColor(cv::Scalar(300, -5, 0)) == "#0000ff");
+    
+    std::cout << "✓ Hex colors passed" << std::endl;
+}
+
+// Test the header line carries the stream description and color scheme
+void test_header() {
+    std::cout << "Testing sidecar header..." << std::endl;
+    
+    const std::string path = "test_overlay_header.jsonl";
+    {
+        OverlaySidecarWriter writer(path, cv::Size(1280, 720), 30.0,
+                                    {"basketball", "rim", "say \"ball\""});
+    }
+    auto lines = readLines(path);
+    assert(lines.size() == 1);
+    const std::string& header = lines[0];
+    assert(header.find("\"width\":1280,\"height\":720") != std::string::npos);
+    assert(header.find("\"classes\":[\"basketball\",\"rim\",\"say \\\"ball\\\"\"]")
+           != std::string::npos);
+    assert(header.find("\"0\":\"#ffa500\"") != std::string::npos);
+    assert(header.find("\"trajectory\":\"#ff00ff\"") != std::string::npos);
+    std::remove(path.c_str());
+    
+    std::cout << "✓ Sidecar header passed" << std::endl;
+}
+
+// Test one compact line per frame, trail only when requested
+void test_frames() {
+    std::cout << "Testing sidecar frames..." << std::endl;
+    
+    const std::string path = "test_overlay_frames.jsonl";
+    {
+        OverlaySidecarWriter writer(path, cv::Size(640, 360), 30.0, {"basketball", "rim"});
+        
+        pipeline::FrameResult result;
+        result.frame_index = 12;
+        result.timestamp_ms = 400.0;
+        result.detections.push_back(makeDetection(0, 0.874f, cv::Rect(10, 20, 30, 40)));
+        result.detections.push_back(makeDetection(1, 0.5f, cv::Rect(300, 100, 60, 20)));
+        writer.write(result);
+        
+        Trajectory trail(50);
+        trail += cv::Point2f(100.4f, 200.6f);
+        trail += cv::Point2f(110.0f, 190.0f);
+        result.frame_index = 13;
+        result.timestamp_ms = 433.3;
+        result.detections.clear();
+        writer.write(result, &trail);
+        
+        // A single point is not a polyline
+        Trajectory single(50);
+        single += cv::Point2f(1.0f, 2.0f);
+        writer.write(result, &single);
+        
+        // Kinematics while tracking, metres per second once calibrated
+        result.tracking = true;
+        result.kinematics.speed = 412.3f;
+        result.kinematics.acceleration = 980.0f;
+        result.kinematics.curvature = 0.00213f;
+        result.kinematics.flight_time = 0.4f;
+        writer.write(result);
+        result.kinematics.meters_per_pixel = 0.01f;
+        writer.write(result);
+    }
+    auto lines = readLines(path);
+    assert(lines.size() == 6);
+    assert(lines[1] == "{\"f\":12,\"t\":400.0,\"boxes\":[[10,20,30,40,0,0.87],[300,100,60,20,1,0.50]]}");
+    assert(lines[2] == "{\"f\":13,\"t\":433.3,\"boxes\":[],\"trail\":[100,201,110,190]}");
+    assert(lines[3] == "{\"f\":13,\"t\":433.3,\"boxes\":[]}");
+    assert(lines[4] == "{\"f\":13,\"t\":433.3,\"boxes\":[],\"kin\":[412.3,980.0,0.00213,0.400]}");
+    assert(lines[5] == "{\"f\":13,\"t\":433.3,\"boxes\":[],\"kin\":[412.3,980.0,0.00213,0.400,4.12]}");
+    std::remove(path.c_str());
+    
+    std::cout << "✓ Sidecar frames passed" << std::endl;
+}
+
+// Test players, possession and shot outcomes ride along with the boxes
+void test_player_events() {
+    std::cout << "Testing sidecar player events..." << std::endl;
+    
+    const std::string path = "test_overlay_events.jsonl";
+    {
+        OverlaySidecarWriter writer(path, cv::Size(640, 360), 30.0, {"basketball", "rim"});
+        
+        pipeline::FrameResult result;
+        result.frame_index = 40;
+        result.timestamp_ms = 1333.3;
+        tracking::PlayerTrack player;
+        player.id = 7;
+        player.box = cv::Rect2f(100.4f, 50.0f, 40.0f, 99.6f);
+        result.players.push_back(player);
+        result.holder = 7;
+        result.possession.push_back({analysis::PossessionEventType::Pass, 38, 7, 3});
+        writer.write(result);
+        
+        result.players.clear();
+        result.holder = -1;
+        result.possession.clear();
+        result.outcome = analysis::ShotOutcome::Make;
+        result.shooter = 7;
+        writer.write(result);
+        
+        result.outcome = analysis::ShotOutcome::Miss;
+        result.shooter = -1;
+        writer.write(result);
+    }
+    auto lines = readLines(path);
+    assert(lines.size() == 4);
+    assert(lines[1] == "{\"f\":40,\"t\":1333.3,\"boxes\":[],\"players\":[[7,100,50,40,100]],"
+                       "\"holder\":7,\"events\":[{\"type\":\"pass\",\"frame\":38,\"player\":7,\"from\":3}]}");
+    assert(lines[2] == "{\"f\":40,\"t\":1333.3,\"boxes\":[],\"events\":[{\"type\":\"make\",\"shooter\":7}]}");
+    assert(lines[3] == "{\"f\":40,\"t\":1333.3,\"boxes\":[],\"events\":[{\"type\":\"miss\"}]}");
+    std::remove(path.c_str());
+    
+    std::cout << "✓ Sidecar player events passed" << std::endl;
+}
+
+// Test an unwritable path is reported
+void test_open_failure() {
+    std::cout << "Testing open failure..." << std::endl;
+    
+    bool threw = false;
+    try {
+        OverlaySidecarWriter writer("/nonexistent/dir/overlay.jsonl", cv::Size(640, 360), 30.0, {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "✓ Open failure passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Overlay Sidecar Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_hex_color();
+        test_header();
+        test_frames();
+        test_player_events();
+        test_open_failure();
+        
+        std::cout << std::endl << "=== All Overlay Sidecar Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
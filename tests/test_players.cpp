@@ -0,0 +1,239 @@
+#include "tracking/Assignment.hpp"
+#include "tracking/PlayerTracker.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::tracking;
+
+static const int PERSON = 3;
+
+static Detection<> person(const cv::Rect& box) {
+    Detection<> det;
+    det.class_id = PERSON;
+    det.confidence = 0.9f;
+    det.box = box;
+    det.center = cv::Point2f(box.x + box.width / 2.0f, box.y + box.height / 2.0f);
+    return det;
+}
+
+// Court-coloured frame with a jersey-coloured box per player
+static cv::Mat drawPlayers(const std::vector<cv::Rect>& boxes, const std::vector<cv::Scalar>& jerseys) {
+    cv::Mat frame(360, 640, CV_8UC3, cv::Scalar(60, 120, 180));
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        cv::rectangle(frame, boxes[i], jerseys[i], cv::FILLED);
+    }
+    return frame;
+}
+
+// Test the assignment solver on small hand-checked problems
+void test_assignment() {
+    std::cout << "Testing assignment..." << std::endl;
+    
+    AssignmentSolver solver;
+    
+    // Greedy takes (0,0)=1 and is forced into (1,1)=9; the optimum crosses
+    std::vector<float> cost = {1, 2,
+                               2, 9};
+    std::vector<int> match = solver.solve(cost, 2, 2, 100.0f);
+    assert(match[0] == 1 && match[1] == 0);
+    
+    // More columns than rows, and more rows than columns
+    cost = {5, 1, 7,
+            1, 6, 8};
+    match = solver.solve(cost, 2, 3, 100.0f);
+    assert(match[0] == 1 && match[1] == 0);
+    cost = {5, 1,
+            7, 8,
+            1, 6};
+    match = solver.solve(cost, 3, 2, 100.0f);
+    assert(match[0] == 1 && match[1] == -1 && match[2] == 0);
+    
+    // Pairs at or above max_cost are never assigned
+    cost = {0.2f, 3.0f,
+            3.0f, 3.0f};
+    match = solver.solve(cost, 2, 2, 1.0f);
+    assert(match[0] == 0 && match[1] == -1);
+    
+    assert(solver.solve({}, 0, 4, 1.0f).empty());
+    match = solver.solve({}, 2, 0, 1.0f);
+    assert(match.size() == 2 && match[0] == -1 && match[1] == -1);
+    
+    std::cout << "✓ Assignment passed" << std::endl;
+}
+
+// Test jerseys of the same colour match and different colours do not
+void test_appearance() {
+    std::cout << "Testing appearance..." << std::endl;
+    
+    std::vector<cv::Rect> boxes = {cv::Rect(50, 100, 40, 100), cv::Rect(200, 120, 50, 120),
+                                   cv::Rect(400, 100, 40, 100), cv::Rect(500, 100, 40, 100)};
+    cv::Mat frame = drawPlayers(boxes, {cv::Scalar(30, 30, 200), cv::Scalar(40, 40, 210),
+                                        cv::Scalar(200, 60, 30), cv::Scalar(245, 245, 245)});
+    
+    Appearance red = PlayerTracker::appearance(frame, boxes[0]);
+    Appearance red_too = PlayerTracker::appearance(frame, boxes[1]);
+    Appearance blue = PlayerTracker::appearance(frame, boxes[2]);
+    Appearance white = PlayerTracker::appearance(frame, boxes[3]);
+    
+    float sum = 0.0f;
+    for (float value : red) sum += value;
+    assert(std::abs(sum - 1.0f) < 1e-4f);
+    
+    assert(PlayerTracker::appearanceDistance(red, red_too) < 0.1f);
+    assert(PlayerTracker::appearanceDistance(red, blue) > 0.9f);
+    assert(PlayerTracker::appearanceDistance(blue, white) > 0.9f);
+    assert(PlayerTracker::appearanceDistance(red, red) < 1e-3f);
+    
+    // Boxes leaving the frame are clipped; fully outside gives an empty signature
+    Appearance outside = PlayerTracker::appearance(frame, cv::Rect(700, 100, 40, 100));
+    for (float value : outside) assert(value == 0.0f);
+    
+    std::cout << "✓ Appearance passed" << std::endl;
+}
+
+// Test two players crossing paths keep their ids
+void test_crossing() {
+    std::cout << "Testing crossing players..." << std::endl;
+    
+    PlayerTracker tracker;
+    const std::vector<cv::Scalar> jerseys = {cv::Scalar(30, 30, 200), cv::Scalar(200, 60, 30)};
+    int red_id = -1;
+    int blue_id = -1;
+    
+    for (int frame_index = 0; frame_index < 60; ++frame_index) {
+        // Red walks right, blue walks left; they overlap around frame 30
+        std::vector<cv::Rect> boxes = {cv::Rect(100 + 7 * frame_index, 120, 50, 120),
+                                       cv::Rect(520 - 7 * frame_index, 126, 50, 120)};
+        cv::Mat frame = drawPlayers(boxes, jerseys);
+        tracker.update(frame, {person(boxes[0]), person(boxes[1])}, PERSON);
+        
+        std::vector<PlayerTrack> players = tracker.confirmed();
+        if (frame_index < 2) {
+            assert(players.empty());  // Not confirmed yet
+            continue;
+        }
+        assert(players.size() == 2);
+        
+        for (const auto& player : players) {
+            // The track whose box is nearer the red player's box
+            float red_dx = std::abs(player.box.x - boxes[0].x);
+            float blue_dx = std::abs(player.box.x - boxes[1].x);
+            bool is_red = red_dx < blue_dx || (red_dx == blue_dx && player.velocity.x > 0.0f);
+            if (frame_index == 2) {
+                (is_red ? red_id : blue_id) = player.id;
+            } else if (std::abs(boxes[0].x - boxes[1].x) > 20) {
+                assert(player.id == (is_red ? red_id : blue_id));
+            }
+        }
+    }
+    assert(red_id != blue_id && red_id > 0 && blue_id > 0);
+    
+    std::cout << "✓ Crossing players passed" << std::endl;
+}
+
+// Test tracks are confirmed, coasted and dropped as configured
+void test_lifecycle() {
+    std::cout << "Testing track lifecycle..." << std::endl;
+    
+    PlayerTrackerConfig config;
+    config.min_hits = 3;
+    config.max_misses = 5;
+    PlayerTracker tracker(config);
+    
+    cv::Rect box(300, 100, 40, 100);
+    cv::Mat frame = drawPlayers({box}, {cv::Scalar(30, 30, 200)});
+    
+    // A single false detection never becomes a player
+    tracker.update(frame, {person(cv::Rect(20, 20, 40, 100))}, PERSON);
+    tracker.update(frame, {}, PERSON);
+    assert(tracker.tracks().empty());
+    
+    // Other classes are ignored
+    Detection<> ball = person(box);
+    ball.class_id = 0;
+    tracker.update(frame, {ball}, PERSON);
+    assert(tracker.tracks().empty());
+    
+    for (int i = 0; i < 3; ++i) {
+        tracker.update(frame, {person(box)}, PERSON);
+    }
+    assert(tracker.confirmed().size() == 1);
+    const int id = tracker.confirmed()[0].id;
+    
+    // Coasting does not count as missing
+    for (int i = 0; i < 20; ++i) tracker.coast();
+    assert(tracker.confirmed().size() == 1 && tracker.confirmed()[0].misses == 0);
+    
+    // Survives max_misses empty frames and comes back with the same id
+    for (int i = 0; i < config.max_misses; ++i) tracker.update(frame, {}, PERSON);
+    tracker.update(frame, {person(box)}, PERSON);
+    assert(tracker.confirmed().size() == 1 && tracker.confirmed()[0].id == id);
+    
+    for (int i = 0; i <= config.max_misses; ++i) tracker.update(frame, {}, PERSON);
+    assert(tracker.tracks().empty());
+    
+    std::cout << "✓ Track lifecycle passed" << std::endl;
+}
+
+// Test ten players stay within a small per-frame budget
+void test_ten_players() {
+    std::cout << "Testing ten players..." << std::endl;
+    
+    PlayerTracker tracker;
+    std::vector<cv::Scalar> jerseys;
+    for (int i = 0; i < 10; ++i) {
+        jerseys.push_back(i < 5 ? cv::Scalar(30, 30, 200) : cv::Scalar(245, 245, 245));
+    }
+    
+    const int frames = 200;
+    double total_ms = 0.0;
+    for (int f = 0; f < frames; ++f) {
+        std::vector<cv::Rect> boxes;
+        std::vector<Detection<>> detections;
+        for (int i = 0; i < 10; ++i) {
+            int x = 20 + 60 * i + static_cast<int>(15.0 * std::sin(0.05 * f + i));
+            int y = 60 + 20 * (i % 3) + static_cast<int>(10.0 * std::cos(0.07 * f + i));
+            boxes.emplace_back(x, y, 40, 110);
+            detections.push_back(person(boxes.back()));
+        }
+        cv::Mat frame = drawPlayers(boxes, jerseys);
+        
+        auto start = std::chrono::steady_clock::now();
+        tracker.update(frame, detections, PERSON);
+        total_ms += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    
+    assert(tracker.confirmed().size() == 10);
+    for (const auto& player : tracker.confirmed()) {
+        assert(player.id <= 10);  // Nobody was lost and re-created
+    }
+    
+    double per_frame = total_ms / frames;
+    std::cout << "  " << per_frame << " ms per frame" << std::endl;
+    assert(per_frame < 5.0);
+    
+    std::cout << "✓ Ten players passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Player Tracking Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_assignment();
+        test_appearance();
+        test_crossing();
+        test_lifecycle();
+        test_ten_players();
+        
+        std::cout << std::endl << "=== All Player Tracking Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,187 @@
+#include "analysis/Possession.hpp"
+#include "analysis/ShotEvents.hpp"
+#include <iostream>
+#include <cassert>
+#include <cfloat>
+#include <random>
+#include <vector>
+
+using namespace bbst;
+using namespace bbst::analysis;
+
+static tracking::PlayerTrack player(int id, float x, float y) {
+    tracking::PlayerTrack track;
+    track.id = id;
+    track.box = cv::Rect2f(x, y, 40.0f, 100.0f);
+    track.hits = 10;
+    return track;
+}
+
+// Test grid queries agree with a brute-force scan
+void test_grid() {
+    std::cout << "Testing player grid..." << std::endl;
+    
+    PlayerGrid grid(64);
+    std::vector<tracking::PlayerTrack> none;
+    grid.build(none, cv::Size(640, 360));
+    assert(grid.nearest(cv::Point2f(100, 100), 1000.0f) == -1);
+    
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> x(-50.0f, 650.0f);
+    std::uniform_real_distribution<float> y(-50.0f, 400.0f);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<tracking::PlayerTrack> players;
+        for (int i = 0; i < 10; ++i) {
+            players.push_back(player(i, x(rng), y(rng)));
+            players.back().box.width = 20.0f + i * 8.0f;
+        }
+        grid.build(players, cv::Size(640, 360));
+        
+        for (int q = 0; q < 100; ++q) {
+            cv::Point2f ball(x(rng), y(rng));
+            const float radius = 10.0f + q;
+            
+            int expected = -1;
+            float expected_distance = FLT_MAX;
+            for (size_t i = 0; i < players.size(); ++i) {
+                float d = PlayerGrid::boxDistance(players[i].box, ball);
+                if (d <= radius && d < expected_distance) {
+                    expected_distance = d;
+                    expected = static_cast<int>(i);
+                }
+            }
+            float distance = 0.0f;
+            int found = grid.nearest(ball, radius, &distance);
+            assert(found == expected);
+            if (found >= 0) assert(distance == expected_distance);
+        }
+    }
+    
+    assert(PlayerGrid::boxDistance(cv::Rect2f(0, 0, 10, 10), cv::Point2f(5, 5)) == 0.0f);
+    assert(PlayerGrid::boxDistance(cv::Rect2f(0, 0, 10, 10), cv::Point2f(13, 14)) == 5.0f);
+    
+    std::cout << "✓ Player grid passed" << std::endl;
+}
+
+struct Game {
+    PossessionTracker tracker;
+    std::vector<tracking::PlayerTrack> players = {player(1, 100, 100), player(2, 400, 100)};
+    std::vector<PossessionEvent> events;
+    int64_t frame = 0;
+    
+    void step(const cv::Point2f* ball) {
+        tracker.update(frame++, ball, players, cv::Size(640, 360), events);
+    }
+    void hold(const cv::Point2f& ball, int frames) {
+        for (int i = 0; i < frames; ++i) step(&ball);
+    }
+    // Straight flight from a to b over frames steps
+    void fly(const cv::Point2f& a, const cv::Point2f& b, int frames) {
+        for (int i = 1; i <= frames; ++i) {
+            cv::Point2f p = a + (b - a) * (static_cast<float>(i) / frames);
+            step(&p);
+        }
+    }
+};
+
+// Test a pass: release, flight, catch by someone else
+void test_pass() {
+    std::cout << "Testing pass..." << std::endl;
+    
+    Game game;
+    const cv::Point2f hands_1(145, 150);
+    const cv::Point2f hands_2(395, 150);
+    game.hold(hands_1, 5);
+    assert(game.tracker.holder() == 1);
+    assert(game.events.size() == 1);
+    assert(game.events[0].type == PossessionEventType::Gained && game.events[0].frame == 0);
+    
+    game.fly(hands_1, hands_2, 12);
+    game.hold(hands_2, 5);
+    assert(game.tracker.holder() == 2);
+    assert(game.tracker.lastHolder() == 1);
+    
+    // Gained 1, Released 1, Gained 2, Pass 1 -> 2
+    assert(game.events.size() == 4);
+    assert(game.events[1].type == PossessionEventType::Released && game.events[1].player == 1);
+    assert(game.events[2].type == PossessionEventType::Gained && game.events[2].player == 2);
+    assert(game.events[3].type == PossessionEventType::Pass);
+    assert(game.events[3].from == 1 && game.events[3].player == 2);
+    assert(game.events[1].frame > 5 && game.events[1].frame < game.events[3].frame);
+    
+    std::cout << "✓ Pass passed" << std::endl;
+}
+
+// Test hysteresis, occlusion and dribbles do not produce passes
+void test_hysteresis() {
+    std::cout << "Testing possession hysteresis..." << std::endl;
+    
+    Game game;
+    game.hold(cv::Point2f(145, 150), 4);
+    assert(game.tracker.holder() == 1);
+    
+    // Between the acquire and release radius: still held
+    game.hold(cv::Point2f(185, 150), 20);
+    assert(game.tracker.holder() == 1);
+    
+    // Hidden in the hands
+    for (int i = 0; i < 30; ++i) game.step(nullptr);
+    assert(game.tracker.holder() == 1);
+    
+    // Two frames out of reach are not enough to let go
+    game.hold(cv::Point2f(300, 150), 2);
+    game.hold(cv::Point2f(145, 150), 2);
+    assert(game.tracker.holder() == 1);
+    
+    // A dribble away and back is a release and a regain, not a pass
+    game.fly(cv::Point2f(145, 150), cv::Point2f(250, 300), 4);
+    game.fly(cv::Point2f(250, 300), cv::Point2f(145, 150), 4);
+    game.hold(cv::Point2f(145, 150), 4);
+    assert(game.tracker.holder() == 1);
+    for (const auto& event : game.events) {
+        assert(event.type != PossessionEventType::Pass);
+    }
+    
+    std::cout << "✓ Possession hysteresis passed" << std::endl;
+}
+
+// Test shots are credited to the last player to release the ball
+void test_shooter_attribution() {
+    std::cout << "Testing shooter attribution..." << std::endl;
+    
+    std::vector<PossessionEvent> possession = {
+        {PossessionEventType::Gained, 10, 4, -1},
+        {PossessionEventType::Released, 40, 4, -1},
+        {PossessionEventType::Gained, 55, 9, -1},
+        {PossessionEventType::Pass, 55, 9, 4},
+        {PossessionEventType::Released, 120, 9, -1},
+    };
+    std::vector<ShotEvent> shots(3);
+    shots[0].launch_frame = 5;      // Before anyone let go
+    shots[1].launch_frame = 35;     // Release found a few frames after the launch
+    shots[2].launch_frame = 121;
+    attributeShooters(shots, possession);
+    assert(shots[0].shooter == -1);
+    assert(shots[1].shooter == 4);
+    assert(shots[2].shooter == 9);
+    
+    assert(std::string(possessionEventName(PossessionEventType::Pass)) == "pass");
+    std::cout << "✓ Shooter attribution passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Possession Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_grid();
+        test_pass();
+        test_hysteresis();
+        test_shooter_attribution();
+        
+        std::cout << std::endl << "=== All Possession Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
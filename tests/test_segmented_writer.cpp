@@ -0,0 +1,169 @@
+#include "io/SegmentedVideoWriter.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace bbst::io;
+namespace fs = std::filesystem;
+
+static std::vector<SegmentInfo> makeSegments(const std::vector<int>& frames) {
+    std::vector<SegmentInfo> segments;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        SegmentInfo segment;
+        segment.index = static_cast<int>(i);
+        segment.path = SegmentedVideoWriter::segmentPath("out/clip.m3u8", segment.index, true);
+        segment.frames = frames[i];
+        segment.ok = true;
+        segments.push_back(segment);
+    }
+    return segments;
+}
+
+static cv::Mat makeFrame(int index) {
+    cv::Mat frame(120, 160, CV_8UC3, cv::Scalar(40, 60, 90));
+    cv::circle(frame, cv::Point(10 + index % 140, 60), 8, cv::Scalar(0, 140, 255), cv::FILLED);
+    return frame;
+}
+
+// Test segment naming next to the output
+void test_segment_paths() {
+    std::cout << "Testing segment paths..." << std::endl;
+    
+    assert(SegmentedVideoWriter::segmentPath("out/clip.mp4", 3, false) == "out/clip.seg00003.mp4");
+    assert(SegmentedVideoWriter::segmentPath("out/clip.m3u8", 12, true) == "out/clip.seg00012.ts");
+    assert(SegmentedVideoWriter::segmentPath("clip.avi", 0, false) == "clip.seg00000.avi");
+    
+    std::cout << "✓ Segment paths passed" << std::endl;
+}
+
+// Test the HLS playlist durations and target duration
+void test_playlist() {
+    std::cout << "Testing HLS playlist..." << std::endl;
+    
+    std::string playlist = SegmentedVideoWriter::hlsPlaylist(makeSegments({60, 60, 25}), 30.0);
+    assert(playlist.rfind("#EXTM3U\n", 0) == 0);
+    assert(playlist.find("#EXT-X-TARGETDURATION:2\n") != std::string::npos);
+    assert(playlist.find("#EXTINF:2.000,\nclip.seg00000.ts\n") != std::string::npos);
+    assert(playlist.find("#EXTINF:0.833,\nclip.seg00002.ts\n") != std::string::npos);
+    assert(playlist.find("#EXT-X-ENDLIST") != std::string::npos);
+    
+    std::cout << "✓ HLS playlist passed" << std::endl;
+}
+
+// Test the concat list quotes paths
+void test_concat_list() {
+    std::cout << "Testing concat list..." << std::endl;
+    
+    std::vector<SegmentInfo> segments = makeSegments({60});
+    segments[0].path = "/videos/it's.seg00000.mp4";
+    std::string list = SegmentedVideoWriter::concatList(segments);
+    assert(list == "ffconcat version 1.0\nfile '/videos/it'\\''s.seg00000.mp4'\n");
+    
+    std::cout << "✓ Concat list passed" << std::endl;
+}
+
+// Test segments are encoded in parallel and listed in order
+void test_encode_playlist() {
+    std::cout << "Testing parallel segment encoding..." << std::endl;
+    
+    const fs::path dir = fs::temp_directory_path() / "bbst_segmented_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string output = (dir / "clip.m3u8").string();
+    
+    SegmentedWriterConfig config;
+    config.segment_frames = 20;
+    config.threads = 3;
+    config.playlist = true;
+    try {
+        SegmentedVideoWriter writer(output, cv::Size(160, 120), 30.0, config);
+        for (int i = 0; i < 110; ++i) {
+            writer.write(makeFrame(i));
+        }
+        writer.close();
+        
+        const auto& segments = writer.segments();
+        assert(segments.size() == 6);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            assert(segments[i].index == static_cast<int>(i));
+            assert(segments[i].ok);
+            assert(segments[i].frames == (i < 5 ? 20 : 10));
+            assert(fs::file_size(segments[i].path) > 0);
+        }
+        assert(fs::exists(output));
+        
+        cv::VideoCapture first(segments[0].path);
+        if (first.isOpened()) {
+            assert(first.get(cv::CAP_PROP_FRAME_COUNT) == 20 ||
+                   first.get(cv::CAP_PROP_FRAME_COUNT) <= 0);  // Some backends cannot count TS
+        }
+        std::cout << "✓ Parallel segment encoding passed" << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "⚠ Skipping test (no video encoder available): " << e.what() << std::endl;
+    }
+    fs::remove_all(dir);
+}
+
+// Test a failed concatenation keeps the segments
+void test_concat_failure() {
+    std::cout << "Testing concat failure..." << std::endl;
+    
+    const fs::path dir = fs::temp_directory_path() / "bbst_segmented_fail";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string output = (dir / "clip.avi").string();
+    
+    SegmentedWriterConfig config;
+    config.segment_frames = 10;
+    config.threads = 2;
+    config.fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+    config.ffmpeg = "/nonexistent/ffmpeg";
+    
+    std::unique_ptr<SegmentedVideoWriter> writer;
+    try {
+        writer = std::make_unique<SegmentedVideoWriter>(output, cv::Size(160, 120), 30.0, config);
+    } catch (const std::runtime_error& e) {
+        std::cout << "⚠ Skipping test (no video encoder available): " << e.what() << std::endl;
+        fs::remove_all(dir);
+        return;
+    }
+    for (int i = 0; i < 25; ++i) {
+        writer->write(makeFrame(i));
+    }
+    bool threw = false;
+    try {
+        writer->close();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(writer->segments().size() == 3);
+    for (const auto& segment : writer->segments()) {
+        assert(fs::exists(segment.path));
+    }
+    assert(!fs::exists(output));
+    fs::remove_all(dir);
+    
+    std::cout << "✓ Concat failure passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running Segmented Writer Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_segment_paths();
+        test_playlist();
+        test_concat_list();
+        test_encode_playlist();
+        test_concat_failure();
+        
+        std::cout << std::endl << "=== All Segmented Writer Tests Passed! ===" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -234,6 +234,129 @@ void test_configuration() {
     std::cout << "✓ Configuration passed" << std::endl;
 }
 
+// Test covariance-driven gating and search region sizing
+void test_covariance_gating() {
+    std::cout << "Testing covariance gating..." << std::endl;
+    
+    TrackerConfig config;
+    KalmanTracker tracker(config);
+    
+    tracker.init(cv::Point2f(100.0f, 100.0f), 20.0f);
+    tracker.predict();
+    float initial_width = tracker.getSearchRegion().width;
+    
+    // Fresh track: velocity unknown, so a large jump is still plausible
+    assert(tracker.inGate(cv::Point2f(200.0f, 100.0f)));
+    
+    // Build a confident constant-velocity track
+    for (int i = 1; i <= 20; ++i) {
+        tracker.predict();
+        tracker.update(cv::Point2f(100.0f + i * 8.0f, 100.0f + i * 3.0f), 20.0f);
+    }
+    
+    cv::Point2f predicted = tracker.predict();
+    float confident_width = tracker.getSearchRegion().width;
+    assert(confident_width < initial_width);
+    assert(tracker.getSearchRegion().contains(predicted));
+    assert(tracker.inGate(predicted));
+    assert(!tracker.inGate(predicted + cv::Point2f(150.0f, 0.0f)));
+    
+    // Repeated predict() calls within a frame must not advance the filter
+    assert(pointsClose(tracker.predict(), predicted, 0.01f));
+    assert(pointsClose(tracker.predict(), predicted, 0.01f));
+    assert(tracker.getSearchRegion().width == confident_width);
+    assert(tracker.isValidDetection(predicted, 20.0f));
+    assert(pointsClose(tracker.getPredictedPosition(), predicted, 0.01f));
+    
+    // Coasting widens the gate again
+    for (int i = 0; i < 5; ++i) {
+        tracker.updateWithoutMeasurement();
+    }
+    tracker.predict();
+    assert(tracker.getSearchRegion().width > confident_width);
+    
+    std::cout << "✓ Covariance gating passed" << std::endl;
+}
+
+// Test a camera pan moves the whole track, trail included
+void test_camera_motion() {
+    std::cout << "Testing camera motion compensation..." << std::endl;
+    
+    // Same ball seen by a still camera and by one that pans mid-track
+    TrackerConfig config;
+    KalmanTracker still(config);
+    KalmanTracker panned(config);
+    const cv::Point2f shift(40.0f, -10.0f);
+    still.init(cv::Point2f(100.0f, 100.0f), 20.0f);
+    panned.init(cv::Point2f(100.0f, 100.0f), 20.0f);
+    
+    for (int i = 1; i <= 10; ++i) {
+        cv::Point2f ball(100.0f + i * 5.0f, 100.0f + i * 2.0f);
+        if (i == 6) panned.compensateCameraMotion(shift);
+        still.predict();
+        panned.predict();
+        still.update(ball, 20.0f);
+        panned.update(i >= 6 ? ball + shift : ball, 20.0f);
+    }
+    
+    const Trajectory& a = still.getTrajectory();
+    const Trajectory& b = panned.getTrajectory();
+    assert(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        assert(pointsClose(b[i], a[i] + shift, 0.01f));
+    }
+    assert(std::abs(panned.getKinematics().path_length - still.getKinematics().path_length) < 0.01f);
+    
+    std::cout << "✓ Camera motion compensation passed" << std::endl;
+}
+
+// Test kinematics follow a projectile, in real units once the ball size is known
+void test_kinematics() {
+    std::cout << "Testing kinematics..." << std::endl;
+    
+    TrackerConfig config;
+    config.ball_diameter_m = 0.24f;
+    KalmanTracker tracker(config);
+    tracker.setFrameInterval(1.0f / 60.0f);
+    
+    // 6 px/frame across, launched 20 px/frame up, 1 px/frame^2 of gravity;
+    // a 24 px ball makes the scale 1 cm per pixel
+    auto arc = [](int f) {
+        return cv::Point2f(100.0f + 6.0f * f, 300.0f - 20.0f * f + 0.5f * f * f);
+    };
+    tracker.init(arc(0), 24.0f);
+    assert(tracker.getKinematics().speed == 0.0f);
+    
+    float true_length = 0.0f;
+    for (int f = 1; f <= 30; ++f) {
+        tracker.predict();
+        tracker.update(arc(f), 24.0f);
+        true_length += static_cast<float>(cv::norm(arc(f) - arc(f - 1)));
+    }
+    
+    const Kinematics& kin = tracker.getKinematics();
+    const float true_speed = std::sqrt(6.0f * 6.0f + 10.0f * 10.0f) * 60.0f;
+    const float true_curvature = 6.0f / std::pow(std::sqrt(136.0f), 3.0f);
+    assert(std::abs(kin.speed - true_speed) < 0.1f * true_speed);
+    assert(std::abs(kin.acceleration - 3600.0f) < 0.1f * 3600.0f);
+    assert(kin.curvature > 0.0f);  // Moving right, falling: clockwise on screen
+    assert(std::abs(kin.curvature - true_curvature) < 0.2f * true_curvature);
+    assert(std::abs(kin.flight_time - 0.5f) < 1e-4f);
+    assert(std::abs(kin.path_length - true_length) < 0.05f * true_length);
+    assert(kin.calibrated());
+    assert(std::abs(kin.meters_per_pixel - 0.01f) < 1e-5f);
+    assert(std::abs(kin.speedMps() - kin.speed * 0.01f) < 1e-3f);
+    
+    // Coasting keeps counting flight time; reset clears everything
+    tracker.updateWithoutMeasurement();
+    assert(std::abs(tracker.getKinematics().flight_time - 31.0f / 60.0f) < 1e-4f);
+    tracker.reset();
+    assert(tracker.getKinematics().path_length == 0.0f);
+    assert(!tracker.getKinematics().calibrated());
+    
+    std::cout << "✓ Kinematics passed" << std::endl;
+}
+
 int main() {
     std::cout << "=== Running Tracker Tests ===" << std::endl << std::endl;
     
@@ -247,6 +370,9 @@ int main() {
         test_trajectory_smoothing();
         test_manual_reset();
         test_configuration();
+        test_covariance_gating();
+        test_camera_motion();
+        test_kinematics();
         
         std::cout << std::endl << "=== All Tracker Tests Passed! ===" << std::endl;
         return 0;
@@ -0,0 +1,96 @@
+#include "util/YuvToTensor.hpp"
+#include "io/FrameSource.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <opencv2/opencv.hpp>
+
+using namespace bbst;
+
+// Smooth synthetic frame (bilinear chroma vs block chroma differ on hard edges)
+static cv::Mat makeBgr(int width, int height) {
+    cv::Mat bgr(height, width, CV_8UC3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            bgr.at<cv::Vec3b>(y, x) = cv::Vec3b(
+                static_cast<uchar>(255 * x / width),
+                static_cast<uchar>(255 * y / height),
+                static_cast<uchar>(128));
+        }
+    }
+    return bgr;
+}
+
+// Mean absolute difference between the fused blob and the reference path
+static double compareWithReference(const io::YuvFrame& yuv, cv::Size size) {
+    cv::Mat bgr;
+    yuv.toBgr(bgr);
+    
+    cv::Mat reference;
+    cv::dnn::blobFromImage(bgr, reference, 1.0 / 255.0, size, cv::Scalar(), true, false);
+    cv::Mat fused = util::YuvToTensor::toBlob(yuv, size);
+    
+    assert(fused.size == reference.size);
+    
+    cv::Mat a(1, static_cast<int>(fused.total()), CV_32F, fused.ptr<float>());
+    cv::Mat b(1, static_cast<int>(reference.total()), CV_32F, reference.ptr<float>());
+    return cv::norm(a, b, cv::NORM_L1) / a.total();
+}
+
+// Test I420 conversion against cvtColor + blobFromImage
+void test_i420_matches_reference() {
+    std::cout << "Testing I420 conversion..." << std::endl;
+    
+    io::YuvFrame yuv;
+    yuv.layout = io::YuvLayout::I420;
+    cv::cvtColor(makeBgr(1280, 720), yuv.data, cv::COLOR_BGR2YUV_I420);
+    
+    assert(yuv.width() == 1280);
+    assert(yuv.height() == 720);
+    assert(compareWithReference(yuv, cv::Size(640, 640)) < 0.02);
+    
+    std::cout << "✓ I420 conversion passed" << std::endl;
+}
+
+// Test NV12 conversion (build NV12 by interleaving the I420 chroma planes)
+void test_nv12_matches_reference() {
+    std::cout << "Testing NV12 conversion..." << std::endl;
+    
+    const int w = 640, h = 480;
+    cv::Mat i420;
+    cv::cvtColor(makeBgr(w, h), i420, cv::COLOR_BGR2YUV_I420);
+    
+    io::YuvFrame yuv;
+    yuv.layout = io::YuvLayout::NV12;
+    yuv.data.create(h * 3 / 2, w, CV_8UC1);
+    std::memcpy(yuv.data.data, i420.data, static_cast<size_t>(w) * h);
+    
+    const uchar* u = i420.data + w * h;
+    const uchar* v = u + (w / 2) * (h / 2);
+    uchar* uv = yuv.data.data + w * h;
+    for (int i = 0; i < (w / 2) * (h / 2); ++i) {
+        uv[2 * i] = u[i];
+        uv[2 * i + 1] = v[i];
+    }
+    
+    assert(compareWithReference(yuv, cv::Size(320, 320)) < 0.02);
+    
+    std::cout << "✓ NV12 conversion passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Running YUV Tensor Tests ===" << std::endl << std::endl;
+    
+    try {
+        test_i420_matches_reference();
+        test_nv12_matches_reference();
+        
+        std::cout << std::endl << "=== All YUV Tensor Tests Passed! ===" << std::endl;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}